@@ -200,8 +200,8 @@ void SQCE_CodeCompletionSuggestionBox::InitSuggestions(const FString& Code, cons
 			Completions = CompletionEngine->GetCompletions(
 				Code,
 				CursorPosition,
-				MainContainer->GetDeclarationTextBoxWrapper()->GetText().ToString(),
-				MainContainer->GetImplementationTextBoxWrapper()->GetText().ToString(),
+				MainContainer->GetDeclarationTextBoxWrapper()->GetTextBox()->GetSnapshot()->GetString(),
+				MainContainer->GetImplementationTextBoxWrapper()->GetTextBox()->GetSnapshot()->GetString(),
 				MainContainer);
 		}
 	}
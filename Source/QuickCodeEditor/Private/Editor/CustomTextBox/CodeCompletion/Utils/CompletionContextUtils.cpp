@@ -5,6 +5,7 @@
 #include "UObject/Package.h"
 #include "Engine/Engine.h"
 #include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_CommonIOHelpers.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
 #include "Internationalization/Regex.h"
 
 bool FCompletionContextUtils::FindLastAccessOperator(const FString& PrecedingText, int32& OutPosition, int32& OutLength, EAccessType& OutAccessType)
@@ -257,9 +258,10 @@ bool FCompletionContextUtils::FindVariableInText(const FString& Text, const FStr
 	
 	// Filter out positions in comments
 	TArray<int32> ValidPositions;
+	const TSharedRef<const FQCE_LexicalMask> Mask = FQCE_LexicalMask::Get(Text);
 	for (int32 Position : PossiblePositions)
 	{
-		if (!QCE_CommonIOHelpers::IsPositionInComment(Text, Position))
+		if (!Mask->IsComment(Position))
 		{
 			ValidPositions.Add(Position);
 		}
@@ -0,0 +1,107 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Document/QCE_LineOffsetIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+void FQCE_LineOffsetIndex::Rebuild(const FString& Text)
+{
+	LineRanges.Reset();
+	FTextRange::CalculateLineRangesFromString(Text, LineRanges);
+	TextLength = Text.Len();
+}
+
+void FQCE_LineOffsetIndex::ApplyEdit(const FString& NewText, const int32 ChangeBegin, const int32 OldChangeEnd, const int32 NewChangeEnd)
+{
+	const int32 Shift = NewChangeEnd - OldChangeEnd;
+	if (LineRanges.Num() == 0 || ChangeBegin < 0 || ChangeBegin > OldChangeEnd || OldChangeEnd > TextLength || TextLength + Shift != NewText.Len())
+	{
+		Rebuild(NewText);
+		return;
+	}
+
+	// One more line on each side, so a terminator split or joined at the edges of the change (e.g. "\r" followed by an inserted "\n") is rescanned too
+	const int32 FirstLine = FMath::Max(PositionToLocation(ChangeBegin).GetLineIndex() - 1, 0);
+	const int32 LastLine = FMath::Min(PositionToLocation(OldChangeEnd).GetLineIndex() + 1, LineRanges.Num() - 1);
+	const bool bScanToEnd = LastLine == LineRanges.Num() - 1;
+	const int32 ScanBegin = LineRanges[FirstLine].BeginIndex;
+	const int32 ScanEnd = bScanToEnd ? NewText.Len() : LineRanges[LastLine + 1].BeginIndex + Shift;
+
+	// Same line breaks as FTextRange::CalculateLineRangesFromString
+	TArray<FTextRange, TInlineAllocator<16>> ScannedRanges;
+	const TCHAR* Chars = *NewText;
+	int32 LineBegin = ScanBegin;
+	for (int32 Index = ScanBegin; Index < ScanEnd; ++Index)
+	{
+		const bool bIsWindowsNewLine = Chars[Index] == TEXT('\r') && Chars[Index + 1] == TEXT('\n');
+		if (bIsWindowsNewLine || FChar::IsLinebreak(Chars[Index]))
+		{
+			ScannedRanges.Emplace(LineBegin, Index);
+			if (bIsWindowsNewLine)
+			{
+				++Index;
+			}
+			LineBegin = Index + 1;
+		}
+	}
+
+	if (bScanToEnd)
+	{
+		ScannedRanges.Emplace(LineBegin, NewText.Len());
+	}
+	else if (LineBegin != ScanEnd)
+	{
+		Rebuild(NewText);
+		return;
+	}
+
+	// Resize the rescanned block in place, the lines before it keep their ranges
+	const int32 NumOldLines = LastLine - FirstLine + 1;
+	const int32 NumNewLines = ScannedRanges.Num();
+	if (NumNewLines > NumOldLines)
+	{
+		LineRanges.InsertUninitialized(FirstLine + NumOldLines, NumNewLines - NumOldLines);
+	}
+	else if (NumNewLines < NumOldLines)
+	{
+		LineRanges.RemoveAt(FirstLine + NumNewLines, NumOldLines - NumNewLines, false);
+	}
+
+	FMemory::Memcpy(&LineRanges[FirstLine], ScannedRanges.GetData(), NumNewLines * sizeof(FTextRange));
+
+	// The lines after the block did not change, they only moved by however many characters the edit added or removed
+	if (Shift != 0)
+	{
+		for (int32 LineIndex = FirstLine + NumNewLines; LineIndex < LineRanges.Num(); ++LineIndex)
+		{
+			LineRanges[LineIndex].BeginIndex += Shift;
+			LineRanges[LineIndex].EndIndex += Shift;
+		}
+	}
+
+	TextLength = NewText.Len();
+}
+
+int32 FQCE_LineOffsetIndex::LocationToPosition(const FTextLocation& Location) const
+{
+	const int32 LineIndex = Location.GetLineIndex();
+	if (!LineRanges.IsValidIndex(LineIndex) || Location.GetOffset() < 0 || Location.GetOffset() > LineRanges[LineIndex].Len())
+	{
+		return INDEX_NONE;
+	}
+
+	return LineRanges[LineIndex].BeginIndex + Location.GetOffset();
+}
+
+FTextLocation FQCE_LineOffsetIndex::PositionToLocation(const int32 Position) const
+{
+	if (LineRanges.Num() == 0 || Position < 0 || Position > TextLength)
+	{
+		return FTextLocation(0, 0);
+	}
+
+	// Last line starting at or before Position
+	const int32 LineIndex = FMath::Max(Algo::UpperBoundBy(LineRanges, Position, &FTextRange::BeginIndex) - 1, 0);
+	const FTextRange& LineRange = LineRanges[LineIndex];
+	return FTextLocation(LineIndex, FMath::Min(Position, LineRange.EndIndex) - LineRange.BeginIndex);
+}
@@ -0,0 +1,113 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Document/QCE_TextDocument.h"
+
+namespace
+{
+	FQCE_LineOffsetIndex MakeEmptyLineOffsets()
+	{
+		// An empty text still has one (empty) line
+		FQCE_LineOffsetIndex LineOffsets;
+		LineOffsets.Rebuild(FString());
+		return LineOffsets;
+	}
+
+	/** Hash of one character and the one before it (0 before the first character) */
+	FORCEINLINE uint64 HashCharPair(const TCHAR Previous, const TCHAR Current)
+	{
+		// SplitMix64 finalizer, so neighbouring pairs do not cancel each other out in the sum
+		uint64 Hash = (static_cast<uint64>(static_cast<uint32>(Previous)) << 32) | static_cast<uint32>(Current);
+		Hash = (Hash ^ (Hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+		Hash = (Hash ^ (Hash >> 27)) * 0x94d049bb133111ebull;
+		return Hash ^ (Hash >> 31);
+	}
+
+	/** Sum of the pair hashes of the characters in [Begin, End) */
+	uint64 HashCharPairs(const TCHAR* Chars, const int32 Begin, const int32 End)
+	{
+		uint64 Hash = 0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Hash += HashCharPair(Index > 0 ? Chars[Index - 1] : TCHAR(0), Chars[Index]);
+		}
+		return Hash;
+	}
+}
+
+FQCE_TextSnapshot::FQCE_TextSnapshot(const uint32 InVersion, const FText& InText, FQCE_LineOffsetIndex&& InLineOffsets, const uint64 InContentHash)
+	: Version(InVersion)
+	, Text(InText)
+	, LineOffsets(MoveTemp(InLineOffsets))
+	, ContentHash(InContentHash)
+{
+}
+
+FStringView FQCE_TextSnapshot::GetLine(const int32 LineIndex) const
+{
+	if (LineIndex < 0 || LineIndex >= LineOffsets.GetNumLines())
+	{
+		return FStringView();
+	}
+
+	const FTextRange& LineRange = LineOffsets.GetLineRange(LineIndex);
+	return FStringView(*GetString() + LineRange.BeginIndex, LineRange.Len());
+}
+
+FStringView FQCE_TextSnapshot::GetRange(int32 Position, int32 Count) const
+{
+	Position = FMath::Clamp(Position, 0, Len());
+	Count = FMath::Clamp(Count, 0, Len() - Position);
+	return FStringView(*GetString() + Position, Count);
+}
+
+FQCE_TextDocument::FQCE_TextDocument()
+	: Snapshot(MakeShared<const FQCE_TextSnapshot>(0, FText::GetEmpty(), MakeEmptyLineOffsets(), 0))
+{
+}
+
+void FQCE_TextDocument::SetText(const FText& NewText, FQCE_TextEdit* OutEdit)
+{
+	const FString& OldString = Snapshot->GetString();
+	const FString& NewString = NewText.ToString();
+	const TCHAR* OldChars = *OldString;
+	const TCHAR* NewChars = *NewString;
+	const int32 OldLen = OldString.Len();
+	const int32 NewLen = NewString.Len();
+
+	// The characters the edit left alone at both ends, everything in between is what changed
+	const int32 MaxCommonLen = FMath::Min(OldLen, NewLen);
+	int32 PrefixLen = 0;
+	while (PrefixLen < MaxCommonLen && OldChars[PrefixLen] == NewChars[PrefixLen])
+	{
+		++PrefixLen;
+	}
+
+	int32 SuffixLen = 0;
+	while (SuffixLen < MaxCommonLen - PrefixLen && OldChars[OldLen - 1 - SuffixLen] == NewChars[NewLen - 1 - SuffixLen])
+	{
+		++SuffixLen;
+	}
+
+	const int32 OldChangeEnd = OldLen - SuffixLen;
+	const int32 NewChangeEnd = NewLen - SuffixLen;
+
+	if (OutEdit)
+	{
+		*OutEdit = FQCE_TextEdit(PrefixLen, OldString.Mid(PrefixLen, OldChangeEnd - PrefixLen), NewString.Mid(PrefixLen, NewChangeEnd - PrefixLen));
+	}
+
+	FQCE_LineOffsetIndex LineOffsets = Snapshot->GetLineOffsets();
+	LineOffsets.ApplyEdit(NewString, PrefixLen, OldChangeEnd, NewChangeEnd);
+
+	// The pairs that changed are the ones inside the edit plus the first one after it, which now follows a different character
+	uint64 ContentHash = Snapshot->GetContentHash();
+	ContentHash -= HashCharPairs(OldChars, PrefixLen, FMath::Min(OldChangeEnd + 1, OldLen));
+	ContentHash += HashCharPairs(NewChars, PrefixLen, FMath::Min(NewChangeEnd + 1, NewLen));
+
+	Snapshot = MakeShared<const FQCE_TextSnapshot>(Snapshot->GetVersion() + 1, NewText, MoveTemp(LineOffsets), ContentHash);
+}
+
+uint64 FQCE_TextDocument::HashString(const FStringView String)
+{
+	return HashCharPairs(String.GetData(), 0, String.Len());
+}
@@ -0,0 +1,174 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Document/QCE_UndoHistory.h"
+
+#include "Settings/UQCE_EditorSettings.h"
+
+namespace
+{
+	/** A keystroke's worth of change: one character typed, or one character removed */
+	bool IsSingleCharacterTyping(const FQCE_TextEdit& Edit)
+	{
+		const FString& Changed = Edit.Removed.IsEmpty() ? Edit.Inserted : Edit.Removed;
+		const bool bSingleCharacter = Edit.Removed.IsEmpty() != Edit.Inserted.IsEmpty() && Changed.Len() == 1;
+		return bSingleCharacter && Changed[0] != TEXT('\n') && Changed[0] != TEXT('\r');
+	}
+}
+
+void FQCE_UndoHistory::Push(TArray<FQCE_TextEdit>&& Edits)
+{
+	if (Edits.Num() == 0)
+	{
+		return;
+	}
+
+	AddStep(MoveTemp(Edits));
+	bLastStepIsTyping = false;
+
+	TrimToMemoryLimit();
+}
+
+void FQCE_UndoHistory::PushTyping(FQCE_TextEdit&& Edit)
+{
+	if (TryMergeTyping(Edit))
+	{
+		TrimToMemoryLimit();
+		return;
+	}
+
+	// Typing over a selection starts a typing step too, a paste or a line break does not
+	const bool bStartsTyping = Edit.Inserted.Len() <= 1 && !Edit.Inserted.Contains(TEXT("\n")) && !Edit.Inserted.Contains(TEXT("\r"));
+
+	TArray<FQCE_TextEdit> Edits;
+	Edits.Add(MoveTemp(Edit));
+	AddStep(MoveTemp(Edits));
+	bLastStepIsTyping = bStartsTyping;
+
+	TrimToMemoryLimit();
+}
+
+FQCE_UndoHistory::FStep& FQCE_UndoHistory::AddStep(TArray<FQCE_TextEdit>&& Edits)
+{
+	for (int32 StepIndex = NumApplied; StepIndex < Steps.Num(); ++StepIndex)
+	{
+		AllocatedSize -= Steps[StepIndex].AllocatedSize;
+	}
+	Steps.SetNum(NumApplied);
+
+	FStep& Step = Steps.AddDefaulted_GetRef();
+	Step.Edits = MoveTemp(Edits);
+	UpdateAllocatedSize(Step);
+	NumApplied = Steps.Num();
+	return Step;
+}
+
+bool FQCE_UndoHistory::TryMergeTyping(const FQCE_TextEdit& Edit)
+{
+	if (!bLastStepIsTyping || NumApplied != Steps.Num() || NumApplied == 0 || !IsSingleCharacterTyping(Edit))
+	{
+		return false;
+	}
+
+	FStep& Step = Steps.Last();
+	check(Step.Edits.Num() == 1);
+	FQCE_TextEdit& Last = Step.Edits[0];
+
+	if (Edit.Removed.IsEmpty())
+	{
+		// Typed right after the text the step inserted
+		if (Edit.Position != Last.Position + Last.Inserted.Len())
+		{
+			return false;
+		}
+		Last.Inserted += Edit.Inserted;
+	}
+	else if (!Last.Inserted.IsEmpty())
+	{
+		return false;
+	}
+	else if (Edit.Position + Edit.Removed.Len() == Last.Position)
+	{
+		// Backspace before the text the step removed
+		Last.Removed = Edit.Removed + Last.Removed;
+		Last.Position = Edit.Position;
+	}
+	else if (Edit.Position == Last.Position)
+	{
+		// Delete after the text the step removed
+		Last.Removed += Edit.Removed;
+	}
+	else
+	{
+		return false;
+	}
+
+	UpdateAllocatedSize(Step);
+	return true;
+}
+
+void FQCE_UndoHistory::UpdateAllocatedSize(FStep& Step)
+{
+	AllocatedSize -= Step.AllocatedSize;
+	Step.AllocatedSize = Step.Edits.GetAllocatedSize();
+	for (const FQCE_TextEdit& Edit : Step.Edits)
+	{
+		Step.AllocatedSize += Edit.Removed.GetAllocatedSize() + Edit.Inserted.GetAllocatedSize();
+	}
+	AllocatedSize += Step.AllocatedSize;
+}
+
+const TArray<FQCE_TextEdit>* FQCE_UndoHistory::PeekUndo() const
+{
+	return NumApplied > 0 ? &Steps[NumApplied - 1].Edits : nullptr;
+}
+
+const TArray<FQCE_TextEdit>* FQCE_UndoHistory::PeekRedo() const
+{
+	return NumApplied < Steps.Num() ? &Steps[NumApplied].Edits : nullptr;
+}
+
+void FQCE_UndoHistory::Undo()
+{
+	if (NumApplied > 0)
+	{
+		--NumApplied;
+	}
+	bLastStepIsTyping = false;
+}
+
+void FQCE_UndoHistory::Redo()
+{
+	if (NumApplied < Steps.Num())
+	{
+		++NumApplied;
+	}
+	bLastStepIsTyping = false;
+}
+
+void FQCE_UndoHistory::Reset()
+{
+	Steps.Empty();
+	NumApplied = 0;
+	AllocatedSize = 0;
+	bLastStepIsTyping = false;
+}
+
+void FQCE_UndoHistory::TrimToMemoryLimit()
+{
+	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+	check(Settings);
+	const SIZE_T MemoryLimit = static_cast<SIZE_T>(FMath::Max(Settings->UndoHistoryMemoryLimitMB, 1)) * 1024 * 1024;
+
+	int32 NumDropped = 0;
+	while (AllocatedSize > MemoryLimit && NumDropped < Steps.Num() - 1)
+	{
+		AllocatedSize -= Steps[NumDropped].AllocatedSize;
+		++NumDropped;
+	}
+
+	if (NumDropped > 0)
+	{
+		Steps.RemoveAt(0, NumDropped);
+		NumApplied = FMath::Max(NumApplied - NumDropped, 0);
+	}
+}
@@ -4,7 +4,9 @@
 
 #include "Editor/MainEditorContainer.h"
 #include "Editor/CustomTextBox/FindAndReplace/QCE_FindAndReplaceManager.h"
+#include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBoxWrapper.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextLayout.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Images/SImage.h"
@@ -44,6 +46,17 @@ void QCE_FindAndReplaceContainer::Construct(const FArguments& InArgs)
                 .HintText(LOCTEXT("FindHint", "Find"))
                 .ToolTipText(LOCTEXT("FindTooltip", "Enter text to search for"))
                 .OnKeyDownHandler(this, &QCE_FindAndReplaceContainer::OnFindTextKeyDown)
+                .OnTextChanged(this, &QCE_FindAndReplaceContainer::OnFindTextChanged)
+            ]
+            // Match counter
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(5, 0, 0, 0)
+            [
+                SNew(STextBlock)
+                .MinDesiredWidth(60.0f)
+                .Text(this, &QCE_FindAndReplaceContainer::GetMatchCountText)
             ]
             // Find button
             + SHorizontalBox::Slot()
@@ -111,6 +124,20 @@ void QCE_FindAndReplaceContainer::Construct(const FArguments& InArgs)
                     .Text(LOCTEXT("WholeWordLabel", "Whole Word"))
                 ]
             ]
+            // Regex checkbox
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(5, 0, 0, 0)
+            [
+                SAssignNew(RegexCheckBox, SCheckBox)
+                .IsChecked(bRegex ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+                .OnCheckStateChanged(this, &QCE_FindAndReplaceContainer::OnRegexChanged)
+                .ToolTipText(LOCTEXT("RegexTooltip", "Treat the search text as a regular expression. Use $1 to $9 in the replacement to insert capture groups and $0 for the whole match."))
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("RegexLabel", "Regex"))
+                ]
+            ]
         ]
     ];
 
@@ -133,28 +160,193 @@ void QCE_FindAndReplaceContainer::SetFindText(const FString& TextToFind) const
 void QCE_FindAndReplaceContainer::OnMatchCaseChanged(ECheckBoxState NewState)
 {
     bMatchCase = (NewState == ECheckBoxState::Checked);
+    UpdateSearch(false);
 }
 
 void QCE_FindAndReplaceContainer::OnWholeWordChanged(ECheckBoxState NewState)
 {
     bWholeWord = (NewState == ECheckBoxState::Checked);
+    UpdateSearch(false);
+}
+
+void QCE_FindAndReplaceContainer::OnRegexChanged(ECheckBoxState NewState)
+{
+    bRegex = (NewState == ECheckBoxState::Checked);
+    UpdateSearch(false);
 }
 
-FReply QCE_FindAndReplaceContainer::OnFindClicked() const
+FReply QCE_FindAndReplaceContainer::OnFindClicked()
 {
     if (!ParentEditor)
         return FReply::Handled();
     
-    const FText FindTerm = FindTextBox->GetText();
-    if (FindTerm.IsEmpty()) return FReply::Handled();
+    if (FindTextBox->GetText().IsEmpty()) return FReply::Handled();
 
-    int32 NextOccurrenceLine = 0;
-    if (QCE_FindAndReplaceManager::FindOccurrence(ParentEditor->GetActiveTextBoxWrapper()->GetTextBox().Get(), FindTerm, bMatchCase, bWholeWord, &NextOccurrenceLine))
+    UpdateSearch(false);
+
+    const TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox = SearchedTextBox.Pin();
+    if (!TextBox.IsValid() || SearchSession.GetNumMatches() == 0)
+        return FReply::Handled();
+
+    // Step from the current match, or from the cursor if the user moved away from it
+    const int32 CursorPosition = SearchSession.GetPosition(TextBox->GetLastCursorLocation());
+    const int32 CurrentMatch = SearchSession.GetCurrentMatch();
+    const bool bAtCurrentMatch = CurrentMatch != INDEX_NONE && SearchSession.GetMatches()[CurrentMatch] + SearchSession.GetMatchLength(CurrentMatch) == CursorPosition;
+    const int32 NextMatch = bAtCurrentMatch
+        ? (CurrentMatch + 1) % SearchSession.GetNumMatches()
+        : SearchSession.FindMatchAtOrAfter(CursorPosition);
+
+    SelectMatch(NextMatch);
+
+    return FReply::Handled();
+}
+
+void QCE_FindAndReplaceContainer::OnFindTextChanged(const FText& NewText)
+{
+    UpdateSearch(true);
+}
+
+void QCE_FindAndReplaceContainer::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+    SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+    if (SearchSession.UpdatePendingSearch())
     {
-        ParentEditor->GetActiveTextBoxWrapper()->ScrollToLine(NextOccurrenceLine);
+        ShowSearchResults(bSelectMatchWhenSearchFinishes);
+        bSelectMatchWhenSearchFinishes = false;
     }
 
-    return FReply::Handled();
+    if (!ParentEditor || SearchSession.GetQuery().IsEmpty())
+        return;
+
+    // Search again once the text was edited or another text box became active
+    const TSharedPtr<QCE_MultiLineEditableTextBoxWrapper>& ActiveWrapper = ParentEditor->GetActiveTextBoxWrapper();
+    const TSharedPtr<SQCE_MultiLineEditableTextBox> ActiveTextBox = ActiveWrapper.IsValid() ? ActiveWrapper->GetTextBox() : nullptr;
+    if (ActiveTextBox.IsValid() && (ActiveTextBox != SearchedTextBox.Pin() || !SearchSession.HasText(ActiveTextBox->GetTextVersion())))
+    {
+        UpdateSearch(false);
+    }
+}
+
+void QCE_FindAndReplaceContainer::UpdateSearch(bool bSelectNearestMatch)
+{
+    if (!ParentEditor || !FindTextBox.IsValid())
+        return;
+
+    const TSharedPtr<QCE_MultiLineEditableTextBoxWrapper>& ActiveWrapper = ParentEditor->GetActiveTextBoxWrapper();
+    const TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox = ActiveWrapper.IsValid() ? ActiveWrapper->GetTextBox() : nullptr;
+    if (!TextBox.IsValid())
+        return;
+
+    if (TextBox != SearchedTextBox.Pin())
+    {
+        EndSearch();
+        SearchedTextBox = TextBox;
+    }
+
+    // The text is only searched again when it changed since the last search
+    if (!SearchSession.HasText(TextBox->GetTextVersion()))
+    {
+        SearchSession.SetText(TextBox->GetSnapshot());
+    }
+
+    SearchSession.SetQuery(FindTextBox->GetText().ToString(), bMatchCase, bWholeWord, bRegex);
+
+    // A regex over a large text is matched on a worker, the results are shown once Tick picks them up
+    bSelectMatchWhenSearchFinishes = SearchSession.IsSearching() && bSelectNearestMatch;
+    ShowSearchResults(bSelectNearestMatch);
+}
+
+void QCE_FindAndReplaceContainer::ShowSearchResults(bool bSelectNearestMatch)
+{
+    const TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox = SearchedTextBox.Pin();
+    if (!TextBox.IsValid())
+        return;
+
+    if (TextBox->FQCE_TextLayout.IsValid())
+    {
+        TArray<FQCE_IdentifierIndex::FOccurrence> Occurrences;
+        Occurrences.Reserve(SearchSession.GetNumMatches());
+        for (int32 MatchIndex = 0; MatchIndex < SearchSession.GetNumMatches(); ++MatchIndex)
+        {
+            const int32 Position = SearchSession.GetMatches()[MatchIndex];
+            const FTextLocation BeginLocation = SearchSession.GetLocation(Position);
+            const FTextLocation EndLocation = SearchSession.GetLocation(Position + SearchSession.GetMatchLength(MatchIndex));
+
+            // A regex match can span lines, each of them gets its own highlight
+            for (int32 LineIndex = BeginLocation.GetLineIndex(); LineIndex <= EndLocation.GetLineIndex(); ++LineIndex)
+            {
+                const int32 BeginOffset = LineIndex == BeginLocation.GetLineIndex() ? BeginLocation.GetOffset() : 0;
+                const int32 EndOffset = LineIndex == EndLocation.GetLineIndex() ? EndLocation.GetOffset() : SearchSession.GetLineLength(LineIndex);
+                if (EndOffset > BeginOffset)
+                {
+                    FQCE_IdentifierIndex::FOccurrence& Occurrence = Occurrences.AddDefaulted_GetRef();
+                    Occurrence.LineIndex = LineIndex;
+                    Occurrence.BeginOffset = BeginOffset;
+                    Occurrence.EndOffset = EndOffset;
+                }
+            }
+        }
+        TextBox->FQCE_TextLayout->SetSearchMatches(MoveTemp(Occurrences));
+    }
+
+    if (bSelectNearestMatch && SearchSession.GetNumMatches() > 0)
+    {
+        // Starting one query length before the cursor keeps the match the cursor is at selected while the query grows
+        const int32 CursorPosition = SearchSession.GetPosition(TextBox->GetLastCursorLocation());
+        SelectMatch(SearchSession.FindMatchAtOrAfter(CursorPosition - SearchSession.GetQuery().Len()));
+    }
+}
+
+void QCE_FindAndReplaceContainer::SelectMatch(int32 MatchIndex)
+{
+    const TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox = SearchedTextBox.Pin();
+    if (!TextBox.IsValid() || !TextBox->GetEditableText().IsValid() || !SearchSession.GetMatches().IsValidIndex(MatchIndex))
+        return;
+
+    const int32 Position = SearchSession.GetMatches()[MatchIndex];
+    const FTextLocation StartLocation = SearchSession.GetLocation(Position);
+    const FTextLocation EndLocation = SearchSession.GetLocation(Position + SearchSession.GetMatchLength(MatchIndex));
+
+    TextBox->GetEditableText()->SelectText(StartLocation, EndLocation);
+    TextBox->LastCursorLocation = EndLocation;
+    SearchSession.SetCurrentMatch(MatchIndex);
+
+    if (ParentEditor && ParentEditor->GetActiveTextBoxWrapper().IsValid())
+    {
+        ParentEditor->GetActiveTextBoxWrapper()->ScrollToLine(StartLocation.GetLineIndex() + 1);
+    }
+}
+
+void QCE_FindAndReplaceContainer::EndSearch()
+{
+    if (const TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox = SearchedTextBox.Pin())
+    {
+        if (TextBox->FQCE_TextLayout.IsValid())
+        {
+            TextBox->FQCE_TextLayout->ClearSearchMatches();
+        }
+    }
+
+    SearchedTextBox.Reset();
+    SearchSession.Reset();
+}
+
+FText QCE_FindAndReplaceContainer::GetMatchCountText() const
+{
+    if (SearchSession.GetQuery().IsEmpty())
+        return FText::GetEmpty();
+
+    if (SearchSession.IsSearching())
+        return LOCTEXT("Searching", "Searching...");
+
+    if (SearchSession.GetNumMatches() == 0)
+        return LOCTEXT("NoMatches", "No results");
+
+    if (SearchSession.GetCurrentMatch() == INDEX_NONE)
+        return FText::Format(LOCTEXT("MatchCount", "{0} results"), FText::AsNumber(SearchSession.GetNumMatches()));
+
+    return FText::Format(LOCTEXT("CurrentMatchOfCount", "{0} of {1}"), FText::AsNumber(SearchSession.GetCurrentMatch() + 1), FText::AsNumber(SearchSession.GetNumMatches()));
 }
 
 FReply QCE_FindAndReplaceContainer::OnReplaceClicked() const
@@ -185,6 +377,7 @@ FReply QCE_FindAndReplaceContainer::OnReplaceAllClicked() const
 
 FReply QCE_FindAndReplaceContainer::OnCloseClicked()
 {
+    EndSearch();
     SetVisibility(EVisibility::Collapsed);
     return FReply::Handled();
 }
@@ -202,11 +395,11 @@ void QCE_FindAndReplaceContainer::ReplaceOccurrence(const FText& FindTerm, const
 {
     if (ParentEditor->GetImplementationTextBoxWrapper() && ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().IsValid())
     {
-        QCE_FindAndReplaceManager::ReplaceOccurrence(ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord);
+        QCE_FindAndReplaceManager::ReplaceOccurrence(ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord, bRegex);
     }
     if (ParentEditor->GetDeclarationTextBoxWrapper() && ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().IsValid())
     {
-        QCE_FindAndReplaceManager::ReplaceOccurrence(ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord);
+        QCE_FindAndReplaceManager::ReplaceOccurrence(ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord, bRegex);
     }
 }
 
@@ -214,11 +407,11 @@ void QCE_FindAndReplaceContainer::ReplaceOccurrences(const FText& FindTerm, cons
 {
     if (ParentEditor->GetImplementationTextBoxWrapper() && ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().IsValid())
     {
-        QCE_FindAndReplaceManager::ReplaceOccurrences(ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord);
+        QCE_FindAndReplaceManager::ReplaceOccurrences(ParentEditor->GetImplementationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord, bRegex);
     }
     if (ParentEditor->GetDeclarationTextBoxWrapper() && ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().IsValid())
     {
-        QCE_FindAndReplaceManager::ReplaceOccurrences(ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord);
+        QCE_FindAndReplaceManager::ReplaceOccurrences(ParentEditor->GetDeclarationTextBoxWrapper()->GetTextBox().Get(), FindTerm, ReplaceTerm, bMatchCase, bWholeWord, bRegex);
     }
 }
 
@@ -1,263 +1,245 @@
 // Copyright TechnicallyArtist 2025 All Rights Reserved.
 
 #include "Editor/CustomTextBox/FindAndReplace/QCE_FindAndReplaceManager.h"
+#include "Editor/CustomTextBox/FindAndReplace/QCE_RegexPatternCache.h"
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
-#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_CommonIOHelpers.h"
-#include "Widgets/Text/SMultiLineEditableText.h"
 #include "QuickCodeEditor.h"
 
-bool QCE_FindAndReplaceManager::FindOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, bool bMatchCase, bool bWholeWord, int32* OutNextOccurrenceLine)
+bool QCE_FindAndReplaceManager::ReplaceOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord, bool bRegex)
 {
     if (!TextBox)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("FindOccurrence: TextBox is null"));
         return false;
     }
 
+    const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+    const FString& TextString = Snapshot->GetString();
     const FString FindString = FindTerm.ToString();
-    if (FindString.IsEmpty())
-    {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("FindOccurrence: Search term is empty"));
-        return false;
-    }
+    const FString ReplaceString = ReplaceTerm.ToString();
 
-    const FString TextString = TextBox->GetText().ToString();
-    if (TextString.IsEmpty())
+    if (FindString.IsEmpty() || TextString.IsEmpty())
     {
         return false;
     }
 
-    FTextLocation CurrentCursorLocation = TextBox->GetLastCursorLocation();
-    int32 StartSearchPos = QCE_CommonIOHelpers::ConvertTextLocationToPosition(TextString, CurrentCursorLocation);
-    
+    // The first match after the cursor, wrapping around to the start of the text
+    int32 StartSearchPos = Snapshot->LocationToPosition(TextBox->GetLastCursorLocation());
     if (StartSearchPos == INDEX_NONE)
     {
         StartSearchPos = 0;
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("FindOccurrence: Invalid cursor position, starting from beginning"));
     }
-
-    if (StartSearchPos < TextString.Len())
+    else if (StartSearchPos < TextString.Len())
     {
         StartSearchPos++;
     }
 
-    ESearchCase::Type SearchCase = bMatchCase ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
-    int32 FindPos = INDEX_NONE;
-    bool bFoundValidOccurrence = false;
-
-    int32 SearchStartPos = StartSearchPos;
-    while (SearchStartPos <= TextString.Len() && !bFoundValidOccurrence)
-    {
-        FindPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
-        
-        if (FindPos == INDEX_NONE)
-        {
-            break;
-        }
-
-        if (!bWholeWord || IsWholeWordMatch(TextString, FindPos, FindString.Len()))
-        {
-            bFoundValidOccurrence = true;
-            break;
-        }
-
-        SearchStartPos = FindPos + 1;
-    }
-
-    if (!bFoundValidOccurrence && StartSearchPos > 0)
-    {
-        SearchStartPos = 0;
-        while (SearchStartPos < StartSearchPos && !bFoundValidOccurrence)
-        {
-            FindPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
-            
-            if (FindPos == INDEX_NONE || FindPos >= StartSearchPos)
-            {
-                break;
-            }
-
-            if (!bWholeWord || IsWholeWordMatch(TextString, FindPos, FindString.Len()))
-            {
-                bFoundValidOccurrence = true;
-                break;
-            }
-
-            SearchStartPos = FindPos + 1;
-        }
-    }
-
-    if (!bFoundValidOccurrence)
+    int32 FindStartPos = INDEX_NONE;
+    int32 FindLength = 0;
+    FString Replacement;
+    if (!FindNextMatch(TextString, FindString, StartSearchPos, bMatchCase, bWholeWord, bRegex, ReplaceString, FindStartPos, FindLength, Replacement))
     {
         return false;
     }
 
-    int32 FindEndPos = FindPos + FindString.Len();
+    // Only the replaced range goes into the undo history
+    TArray<FQCE_TextEdit> Edits;
+    Edits.Emplace(FindStartPos, TextString.Mid(FindStartPos, FindLength), Replacement);
+    TextBox->ApplyEdits(MoveTemp(Edits));
 
-    TextBox->SelectSpecificOccurrence(FindString, FindPos, FindString.Len());
-    int32 LineIndex = 0;
-    int32 ColumnOffset = 0;
-    ConvertAbsolutePositionToLocation(TextString, FindEndPos, LineIndex, ColumnOffset);
-
-    if (OutNextOccurrenceLine)
-    {
-        *OutNextOccurrenceLine = LineIndex;
-    }
+    TextBox->SelectSpecificOccurrence(Replacement, FindStartPos, Replacement.Len());
 
     return true;
 }
 
-bool QCE_FindAndReplaceManager::ReplaceOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord)
+void QCE_FindAndReplaceManager::ReplaceOccurrences(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord, bool bRegex)
 {
     if (!TextBox)
     {
-        return false;
+        return;
     }
 
-    const FString TextString = TextBox->GetText().ToString();
     const FString FindString = FindTerm.ToString();
     const FString ReplaceString = ReplaceTerm.ToString();
 
-    if (FindString.IsEmpty() || TextString.IsEmpty())
+    if (FindString.IsEmpty())
     {
-        return false;
+        return;
     }
 
-    int32 NextOccurrenceLine = 0;
-    if (!FindOccurrence(TextBox, FindTerm, bMatchCase, bWholeWord, &NextOccurrenceLine))
+    const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+    const FString& TextString = Snapshot->GetString();
+    if (TextString.IsEmpty())
     {
-        return false;
+        return;
     }
 
-    FTextLocation LastCursorLocation = TextBox->GetLastCursorLocation();
-    int32 FindEndPos = QCE_CommonIOHelpers::ConvertTextLocationToPosition(TextString, LastCursorLocation);
-    if (FindEndPos == INDEX_NONE)
+    TArray<int32> OccurrencePositions;
+    TArray<int32> OccurrenceLengths;
+    TArray<FString> Replacements;
+    if (bRegex)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Failed to convert cursor location to absolute position for replacement"));
-        return false;
+        FindAllRegexMatches(TextString, FindString, bMatchCase, bWholeWord, ReplaceString, OccurrencePositions, OccurrenceLengths, Replacements);
     }
-
-    int32 FindStartPos = FindEndPos - FindString.Len();
-    if (FindStartPos < 0 || FindStartPos >= TextString.Len())
+    else
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Invalid find start position: %d"), FindStartPos);
-        return false;
+        FindAllOccurrences(TextString, FindString, bMatchCase, bWholeWord, OccurrencePositions);
+        OccurrenceLengths.Init(FindString.Len(), OccurrencePositions.Num());
+        Replacements.Add(ReplaceString);
     }
 
-    TSharedPtr<SMultiLineEditableText> EditableText = TextBox->GetEditableText();
-    if (!EditableText.IsValid())
+    if (OccurrencePositions.Num() == 0)
     {
-        return false;
+        return;
     }
 
-    SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
-
-    FString NewText = TextString.Left(FindStartPos) + ReplaceString + TextString.Mid(FindEndPos);
-    TextBox->SetText(FText::FromString(NewText));
-
-    int32 NewCursorPos = FindStartPos + ReplaceString.Len();
-
-    int32 LineIndex = 0;
-    int32 ColumnOffset = 0;
-    ConvertAbsolutePositionToLocation(NewText, NewCursorPos, LineIndex, ColumnOffset);
-    TextBox->SelectSpecificOccurrence(ReplaceString, FindStartPos, ReplaceString.Len());
+    // Each occurrence is replaced in place, so only the lines that contain one change and get highlighted again,
+    // and the undo step records just the replaced ranges. Edits go back to front.
+    TArray<FQCE_TextEdit> Edits;
+    Edits.Reserve(OccurrencePositions.Num());
+    for (int32 OccurrenceIndex = OccurrencePositions.Num() - 1; OccurrenceIndex >= 0; --OccurrenceIndex)
+    {
+        const int32 OccurrencePos = OccurrencePositions[OccurrenceIndex];
+        Edits.Emplace(OccurrencePos, TextString.Mid(OccurrencePos, OccurrenceLengths[OccurrenceIndex]), Replacements[Replacements.Num() == 1 ? 0 : OccurrenceIndex]);
+    }
+    TextBox->ApplyEdits(MoveTemp(Edits));
 
-    return true;
+    TextBox->SelectWordOccurrences(FString());
 }
 
-void QCE_FindAndReplaceManager::ReplaceOccurrences(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord)
+bool QCE_FindAndReplaceManager::FindNextMatch(const FString& TextString, const FString& FindString, int32 StartPos, bool bMatchCase, bool bWholeWord, bool bRegex,
+    const FString& ReplaceString, int32& OutPos, int32& OutLength, FString& OutReplacement)
 {
-    if (!TextBox)
+    if (bRegex)
     {
-        return;
-    }
+        const TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> Pattern = FQCE_RegexPatternCache::Get(FindString, bMatchCase);
+        FRegexMatcher Matcher(*Pattern, TextString);
 
-    const FString FindString = FindTerm.ToString();
-    const FString ReplaceString = ReplaceTerm.ToString();
+        // Search from StartPos to the end first, then wrap around once and search the text before StartPos
+        const int32 ClampedStartPos = FMath::Clamp(StartPos, 0, TextString.Len());
+        for (int32 Pass = 0; Pass < 2; ++Pass)
+        {
+            const int32 PassStart = Pass == 0 ? ClampedStartPos : 0;
+            Matcher.SetLimits(PassStart, TextString.Len());
+            while (Matcher.FindNext())
+            {
+                const int32 MatchPos = Matcher.GetMatchBeginning();
+                if (Pass == 1 && MatchPos >= ClampedStartPos)
+                {
+                    break;
+                }
+
+                const int32 MatchLength = Matcher.GetMatchEnding() - MatchPos;
+                if (MatchLength == 0 || (bWholeWord && !IsWholeWordMatch(TextString, MatchPos, MatchLength)))
+                {
+                    continue;
+                }
+
+                OutPos = MatchPos;
+                OutLength = MatchLength;
+                OutReplacement = FQCE_RegexPatternCache::ExpandReplacement(ReplaceString, Matcher);
+                return true;
+            }
 
-    if (FindString.IsEmpty())
-    {
-        return;
+            if (ClampedStartPos == 0)
+            {
+                break;
+            }
+        }
+
+        return false;
     }
 
-    FString TextString = TextBox->GetText().ToString();
-    if (TextString.IsEmpty())
+    ESearchCase::Type SearchCase = bMatchCase ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+    OutLength = FindString.Len();
+    OutReplacement = ReplaceString;
+
+    int32 SearchStartPos = StartPos;
+    while (SearchStartPos <= TextString.Len())
     {
-        return;
+        OutPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
+        
+        if (OutPos == INDEX_NONE)
+        {
+            break;
+        }
+
+        if (!bWholeWord || IsWholeWordMatch(TextString, OutPos, FindString.Len()))
+        {
+            return true;
+        }
+
+        SearchStartPos = OutPos + 1;
     }
 
-    // Create a scoped transaction for undo/redo support
-    TSharedPtr<SMultiLineEditableText> EditableText = TextBox->GetEditableText();
-    if (!EditableText.IsValid())
+    SearchStartPos = 0;
+    while (SearchStartPos < StartPos)
     {
-        return;
-    }
+        OutPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
+        
+        if (OutPos == INDEX_NONE || OutPos >= StartPos)
+        {
+            break;
+        }
+
+        if (!bWholeWord || IsWholeWordMatch(TextString, OutPos, FindString.Len()))
+        {
+            return true;
+        }
 
-    SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
+        SearchStartPos = OutPos + 1;
+    }
 
-    // Use more efficient approach: find all occurrences first, then replace in reverse order
-    // This avoids position offset issues when doing multiple replacements
-    TArray<int32> OccurrencePositions;
+    return false;
+}
 
-    ESearchCase::Type SearchCase = bMatchCase ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+void QCE_FindAndReplaceManager::FindAllOccurrences(const FString& TextString, const FString& FindString, bool bMatchCase, bool bWholeWord, TArray<int32>& OutPositions)
+{
+    const ESearchCase::Type SearchCase = bMatchCase ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
     int32 SearchStartPos = 0;
 
-    while (true)
+    while (SearchStartPos < TextString.Len())
     {
-        int32 FindPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
+        const int32 FindPos = TextString.Find(FindString, SearchCase, ESearchDir::FromStart, SearchStartPos);
         if (FindPos == INDEX_NONE)
         {
             break;
         }
 
         // Check whole word boundaries if required
-        bool bValidOccurrence = true;
-        if (bWholeWord && !IsWholeWordMatch(TextString, FindPos, FindString.Len()))
+        if (!bWholeWord || IsWholeWordMatch(TextString, FindPos, FindString.Len()))
         {
-            bValidOccurrence = false;
+            // Occurrences must not overlap, the text of a replaced one is gone
+            OutPositions.Add(FindPos);
+            SearchStartPos = FindPos + FindString.Len();
         }
-
-        if (bValidOccurrence)
+        else
         {
-            OccurrencePositions.Add(FindPos);
+            SearchStartPos = FindPos + 1;
         }
-
-        SearchStartPos = FindPos + 1;
     }
+}
 
-    if (OccurrencePositions.Num() == 0)
-    {
-        return;
-    }
+void QCE_FindAndReplaceManager::FindAllRegexMatches(const FString& TextString, const FString& Pattern, bool bMatchCase, bool bWholeWord, const FString& ReplaceString,
+    TArray<int32>& OutPositions, TArray<int32>& OutLengths, TArray<FString>& OutReplacements)
+{
+    const TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> CompiledPattern = FQCE_RegexPatternCache::Get(Pattern, bMatchCase);
+    FRegexMatcher Matcher(*CompiledPattern, TextString);
 
-    FString NewText = TextString;
-    for (int32 i = OccurrencePositions.Num() - 1; i >= 0; i--)
+    while (Matcher.FindNext())
     {
-        int32 Pos = OccurrencePositions[i];
-        NewText = NewText.Left(Pos) + ReplaceString + NewText.Mid(Pos + FindString.Len());
-    }
-
-    TextBox->SetText(FText::FromString(NewText));
+        const int32 MatchPos = Matcher.GetMatchBeginning();
+        const int32 MatchLength = Matcher.GetMatchEnding() - MatchPos;
 
-    if (OccurrencePositions.Num() > 0)
-    {
-        int32 LastReplacementPos = OccurrencePositions[0]; 
-        int32 LengthDifference = ReplaceString.Len() - FindString.Len();
-        int32 AdjustedPos = LastReplacementPos;
-        for (int32 i = 1; i < OccurrencePositions.Num(); i++)
+        // Empty matches would insert the replacement between characters, which is never what Replace All is meant for
+        if (MatchLength == 0 || (bWholeWord && !IsWholeWordMatch(TextString, MatchPos, MatchLength)))
         {
-            if (OccurrencePositions[i] < LastReplacementPos)
-            {
-                AdjustedPos += LengthDifference;
-            }
+            continue;
         }
 
-        int32 LineIndex = 0;
-        int32 ColumnOffset = 0;
-        ConvertAbsolutePositionToLocation(NewText, AdjustedPos, LineIndex, ColumnOffset);
+        OutPositions.Add(MatchPos);
+        OutLengths.Add(MatchLength);
+        OutReplacements.Add(FQCE_RegexPatternCache::ExpandReplacement(ReplaceString, Matcher));
     }
-
-    TextBox->SelectWordOccurrences(FString());
-
 }
 
 bool QCE_FindAndReplaceManager::IsWholeWordMatch(const FString& TextString, int32 FindPos, int32 FindLength)
@@ -283,20 +265,3 @@ bool QCE_FindAndReplaceManager::IsWholeWordMatch(const FString& TextString, int3
 
     return true;
 }
-
-void QCE_FindAndReplaceManager::ConvertAbsolutePositionToLocation(const FString& TextString, int32 AbsolutePos, int32& OutLineIndex, int32& OutColumnOffset)
-{
-    OutLineIndex = 0;
-    int32 LineStartPos = 0;
-
-    for (int32 i = 0; i < AbsolutePos && i < TextString.Len(); i++)
-    {
-        if (TextString[i] == TEXT('\n'))
-        {
-            OutLineIndex++;
-            LineStartPos = i + 1;
-        }
-    }
-
-    OutColumnOffset = AbsolutePos - LineStartPos;
-}
\ No newline at end of file
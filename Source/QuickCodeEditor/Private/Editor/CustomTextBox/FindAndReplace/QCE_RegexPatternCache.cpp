@@ -0,0 +1,83 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/FindAndReplace/QCE_RegexPatternCache.h"
+
+namespace
+{
+    struct FCachedPattern
+    {
+        FString Pattern;
+        bool bMatchCase = true;
+        TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> Compiled;
+    };
+
+    /** Few queries are alive at once: the find panel's, plus the ones Replace runs with */
+    constexpr int32 MaxCachedPatterns = 8;
+
+    /** Most recently used last */
+    TArray<FCachedPattern> CachedPatterns;
+}
+
+TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> FQCE_RegexPatternCache::Get(const FString& Pattern, bool bMatchCase)
+{
+    check(IsInGameThread());
+
+    for (int32 Index = CachedPatterns.Num() - 1; Index >= 0; --Index)
+    {
+        if (CachedPatterns[Index].bMatchCase == bMatchCase && CachedPatterns[Index].Pattern.Equals(Pattern, ESearchCase::CaseSensitive))
+        {
+            FCachedPattern Entry = MoveTemp(CachedPatterns[Index]);
+            CachedPatterns.RemoveAt(Index);
+            return CachedPatterns.Add_GetRef(MoveTemp(Entry)).Compiled;
+        }
+    }
+
+    if (CachedPatterns.Num() >= MaxCachedPatterns)
+    {
+        CachedPatterns.RemoveAt(0);
+    }
+
+    // The inline flag keeps case-insensitive matching in the pattern itself, so matchers need no extra setup
+    const FString Source = bMatchCase ? Pattern : TEXT("(?i)") + Pattern;
+    return CachedPatterns.Add_GetRef(FCachedPattern{ Pattern, bMatchCase, MakeShared<FRegexPattern, ESPMode::ThreadSafe>(Source) }).Compiled;
+}
+
+void FQCE_RegexPatternCache::Empty()
+{
+    CachedPatterns.Empty();
+}
+
+FString FQCE_RegexPatternCache::ExpandReplacement(const FString& Replacement, FRegexMatcher& Matcher)
+{
+    int32 DollarIndex;
+    if (!Replacement.FindChar(TEXT('$'), DollarIndex))
+    {
+        return Replacement;
+    }
+
+    FString Expanded;
+    Expanded.Reserve(Replacement.Len());
+
+    for (int32 Index = 0; Index < Replacement.Len(); ++Index)
+    {
+        const TCHAR Char = Replacement[Index];
+        const TCHAR NextChar = Index + 1 < Replacement.Len() ? Replacement[Index + 1] : TEXT('\0');
+
+        if (Char == TEXT('$') && FChar::IsDigit(NextChar))
+        {
+            Expanded.Append(Matcher.GetCaptureGroup(NextChar - TEXT('0')));
+            ++Index;
+        }
+        else if (Char == TEXT('$') && NextChar == TEXT('$'))
+        {
+            Expanded.AppendChar(TEXT('$'));
+            ++Index;
+        }
+        else
+        {
+            Expanded.AppendChar(Char);
+        }
+    }
+
+    return Expanded;
+}
@@ -0,0 +1,308 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/FindAndReplace/QCE_SearchSession.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Editor/CustomTextBox/FindAndReplace/QCE_RegexPatternCache.h"
+
+struct FQCE_SearchSession::FRegexScan
+{
+    TArray<int32> Positions;
+    TArray<int32> Lengths;
+
+    /** Set by the game thread when the result is no longer wanted */
+    std::atomic<bool> bCancelled { false };
+
+    /** Set by the worker once Positions and Lengths are final */
+    std::atomic<bool> bFinished { false };
+};
+
+namespace
+{
+    /** Regex queries over texts at least this long are matched on a worker thread */
+    constexpr int32 MinWorkerRegexTextLength = 256 * 1024;
+
+    FORCEINLINE TCHAR FoldCase(TCHAR Char, bool bMatchCase)
+    {
+        return bMatchCase ? Char : FChar::ToLower(Char);
+    }
+
+    FORCEINLINE bool IsWordChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Returns true if Query occurs in Text at Position */
+    bool MatchesAt(const FString& Text, int32 Position, const FString& Query, bool bMatchCase)
+    {
+        if (Position + Query.Len() > Text.Len())
+            return false;
+
+        const TCHAR* TextChars = *Text + Position;
+        const TCHAR* QueryChars = *Query;
+        for (int32 Index = 0; Index < Query.Len(); ++Index)
+        {
+            if (FoldCase(TextChars[Index], bMatchCase) != FoldCase(QueryChars[Index], bMatchCase))
+                return false;
+        }
+        return true;
+    }
+}
+
+FQCE_SearchSession::~FQCE_SearchSession()
+{
+    CancelPendingScan();
+}
+
+void FQCE_SearchSession::Reset()
+{
+    CancelPendingScan();
+
+    Snapshot.Reset();
+    Query.Empty();
+    Candidates.Empty();
+    CandidateLengths.Empty();
+    Matches.Empty();
+    MatchLengths.Empty();
+    CurrentMatch = INDEX_NONE;
+}
+
+void FQCE_SearchSession::SetText(const TSharedRef<const FQCE_TextSnapshot>& InSnapshot)
+{
+    Snapshot = InSnapshot;
+    SearchText();
+}
+
+const FString& FQCE_SearchSession::GetText() const
+{
+    static const FString EmptyText;
+    return Snapshot.IsValid() ? Snapshot->GetString() : EmptyText;
+}
+
+void FQCE_SearchSession::SetQuery(const FString& InQuery, bool bInMatchCase, bool bInWholeWord, bool bInRegex)
+{
+    if (InQuery.Equals(Query, ESearchCase::CaseSensitive) && bInMatchCase == bMatchCase && bInRegex == bRegex)
+    {
+        if (bInWholeWord != bWholeWord)
+        {
+            bWholeWord = bInWholeWord;
+            UpdateMatches();
+        }
+        return;
+    }
+
+    // Every occurrence of a longer query starts where the shorter one occurs, so only those positions need checking
+    const bool bCanNarrow = !Query.IsEmpty()
+        && !bInRegex && !bRegex
+        && !IsSearching()
+        && bInMatchCase == bMatchCase
+        && InQuery.StartsWith(Query, bMatchCase ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase);
+
+    Query = InQuery;
+    bMatchCase = bInMatchCase;
+    bWholeWord = bInWholeWord;
+    bRegex = bInRegex;
+
+    if (bCanNarrow)
+    {
+        int32 NumKept = 0;
+        for (const int32 Position : Candidates)
+        {
+            if (MatchesAt(GetText(), Position, Query, bMatchCase))
+                Candidates[NumKept++] = Position;
+        }
+        Candidates.SetNum(NumKept, false);
+        CandidateLengths.Init(Query.Len(), NumKept);
+        UpdateMatches();
+    }
+    else
+    {
+        SearchText();
+    }
+}
+
+bool FQCE_SearchSession::UpdatePendingSearch()
+{
+    if (!PendingScan.IsValid() || !PendingScan->bFinished.load())
+        return false;
+
+    Candidates = MoveTemp(PendingScan->Positions);
+    CandidateLengths = MoveTemp(PendingScan->Lengths);
+    PendingScan.Reset();
+
+    UpdateMatches();
+    return true;
+}
+
+void FQCE_SearchSession::SearchText()
+{
+    CancelPendingScan();
+
+    Candidates.Reset();
+    CandidateLengths.Reset();
+
+    if (Query.IsEmpty())
+    {
+        UpdateMatches();
+        return;
+    }
+
+    if (!bRegex)
+    {
+        FindAll(GetText(), Query, bMatchCase, Candidates);
+        CandidateLengths.Init(Query.Len(), Candidates.Num());
+        UpdateMatches();
+        return;
+    }
+
+    const TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> Pattern = FQCE_RegexPatternCache::Get(Query, bMatchCase);
+    if (GetText().Len() < MinWorkerRegexTextLength)
+    {
+        FindAllRegex(GetText(), *Pattern, nullptr, Candidates, CandidateLengths);
+        UpdateMatches();
+        return;
+    }
+
+    // The matches stay empty until the worker is done, UpdatePendingSearch picks them up
+    UpdateMatches();
+
+    PendingScan = MakeShared<FRegexScan, ESPMode::ThreadSafe>();
+    // The worker gets its own copy, the snapshot's text is only read on the game thread
+    Async(EAsyncExecution::ThreadPool, [Scan = PendingScan.ToSharedRef(), Pattern, ScanText = GetText()]()
+    {
+        FindAllRegex(ScanText, *Pattern, &Scan->bCancelled, Scan->Positions, Scan->Lengths);
+        Scan->bFinished.store(true);
+    });
+}
+
+void FQCE_SearchSession::CancelPendingScan()
+{
+    if (PendingScan.IsValid())
+    {
+        PendingScan->bCancelled.store(true);
+        PendingScan.Reset();
+    }
+}
+
+int32 FQCE_SearchSession::FindMatchAtOrAfter(int32 Position) const
+{
+    if (Matches.Num() == 0)
+        return INDEX_NONE;
+
+    const int32 MatchIndex = Algo::LowerBound(Matches, Position);
+    return MatchIndex < Matches.Num() ? MatchIndex : 0;
+}
+
+FTextLocation FQCE_SearchSession::GetLocation(int32 Position) const
+{
+    return Snapshot.IsValid() ? Snapshot->PositionToLocation(Position) : FTextLocation(0, 0);
+}
+
+int32 FQCE_SearchSession::GetPosition(const FTextLocation& Location) const
+{
+    const int32 Position = Snapshot.IsValid() ? Snapshot->LocationToPosition(Location) : INDEX_NONE;
+    return Position != INDEX_NONE ? Position : GetText().Len();
+}
+
+int32 FQCE_SearchSession::GetLineLength(int32 LineIndex) const
+{
+    return Snapshot.IsValid() ? Snapshot->GetLine(LineIndex).Len() : 0;
+}
+
+void FQCE_SearchSession::FindAll(const FString& Text, const FString& Query, bool bMatchCase, TArray<int32>& OutPositions)
+{
+    OutPositions.Reset();
+
+    const int32 TextLen = Text.Len();
+    const int32 QueryLen = Query.Len();
+    if (QueryLen == 0 || QueryLen > TextLen)
+        return;
+
+    TArray<TCHAR, TInlineAllocator<64>> Pattern;
+    Pattern.SetNumUninitialized(QueryLen);
+    for (int32 Index = 0; Index < QueryLen; ++Index)
+    {
+        Pattern[Index] = FoldCase(Query[Index], bMatchCase);
+    }
+
+    // Bad character shifts, keyed by the low byte of the character. Characters sharing a byte
+    // get the smallest of their shifts, which can only make the search step shorter, never skip a match.
+    int32 Shifts[256];
+    for (int32& Shift : Shifts)
+    {
+        Shift = QueryLen;
+    }
+    for (int32 Index = 0; Index < QueryLen - 1; ++Index)
+    {
+        Shifts[Pattern[Index] & 0xFF] = QueryLen - 1 - Index;
+    }
+
+    const TCHAR* TextChars = *Text;
+    const TCHAR LastPatternChar = Pattern[QueryLen - 1];
+    int32 Position = 0;
+    while (Position <= TextLen - QueryLen)
+    {
+        const TCHAR LastChar = FoldCase(TextChars[Position + QueryLen - 1], bMatchCase);
+        if (LastChar == LastPatternChar)
+        {
+            int32 Index = QueryLen - 2;
+            while (Index >= 0 && FoldCase(TextChars[Position + Index], bMatchCase) == Pattern[Index])
+            {
+                --Index;
+            }
+            if (Index < 0)
+                OutPositions.Add(Position);
+        }
+        Position += Shifts[LastChar & 0xFF];
+    }
+}
+
+void FQCE_SearchSession::FindAllRegex(const FString& Text, const FRegexPattern& Pattern, const std::atomic<bool>* bCancelled, TArray<int32>& OutPositions, TArray<int32>& OutLengths)
+{
+    OutPositions.Reset();
+    OutLengths.Reset();
+
+    FRegexMatcher Matcher(Pattern, Text);
+    while ((!bCancelled || !bCancelled->load(std::memory_order_relaxed)) && Matcher.FindNext())
+    {
+        const int32 Begin = Matcher.GetMatchBeginning();
+        const int32 Length = Matcher.GetMatchEnding() - Begin;
+
+        // Empty matches (e.g. of "x*") have nothing to select or highlight
+        if (Length > 0)
+        {
+            OutPositions.Add(Begin);
+            OutLengths.Add(Length);
+        }
+    }
+}
+
+void FQCE_SearchSession::UpdateMatches()
+{
+    Matches.Reset();
+    MatchLengths.Reset();
+    CurrentMatch = INDEX_NONE;
+
+    int32 PreviousEnd = 0;
+    for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+    {
+        const int32 Position = Candidates[CandidateIndex];
+        const int32 Length = CandidateLengths[CandidateIndex];
+        if (Position < PreviousEnd || (bWholeWord && !IsWholeWordAt(Position, Length)))
+            continue;
+
+        Matches.Add(Position);
+        MatchLengths.Add(Length);
+        PreviousEnd = Position + Length;
+    }
+}
+
+bool FQCE_SearchSession::IsWholeWordAt(int32 Position, int32 Length) const
+{
+    const int32 End = Position + Length;
+    const FString& Text = GetText();
+    const bool bWordBefore = Position > 0 && IsWordChar(Text[Position - 1]);
+    const bool bWordAfter = End < Text.Len() && IsWordChar(Text[End]);
+    return !bWordBefore && !bWordAfter;
+}
@@ -18,7 +18,8 @@ bool QCE_GenerateDefinitionHelpers::HasDeclarationAtCursor(const TSharedPtr<SQCE
 		return false;
 	}
 
-	const FString FileContent = TextBox->GetText().ToString();
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+	const FString& FileContent = Snapshot->GetString();
 	if (FileContent.IsEmpty())
 	{
 		UE_LOG(LogQuickCodeEditor, Warning, TEXT("File content is empty"));
@@ -28,7 +29,7 @@ bool QCE_GenerateDefinitionHelpers::HasDeclarationAtCursor(const TSharedPtr<SQCE
 	const FTextLocation CursorLocation = TextBox->GetLastCursorLocation();
 	
 	// Convert FTextLocation to linear position in file content
-	int32 CursorPosition = QCE_CommonIOHelpers::ConvertTextLocationToPosition(FileContent, CursorLocation);
+	int32 CursorPosition = Snapshot->LocationToPosition(CursorLocation);
 	if (CursorPosition == INDEX_NONE)
 	{
 		UE_LOG(LogQuickCodeEditor, Warning, TEXT("Invalid cursor position: Line %d, Offset %d"), CursorLocation.GetLineIndex(), CursorLocation.GetOffset());
@@ -45,8 +46,10 @@ bool QCE_GenerateDefinitionHelpers::TryGenerateAndInsertDefinition(UMainEditorCo
 	if (!GetImplementationText(EditorContainer, ImplementationText))
 		return false;
 
-	FString HeaderContent = EditorContainer->GetDeclarationTextBoxWrapper()->GetTextBox()->GetText().ToString();
+	const TSharedRef<const FQCE_TextSnapshot> HeaderSnapshot = EditorContainer->GetDeclarationTextBoxWrapper()->GetTextBox()->GetSnapshot();
+	const FString& HeaderContent = HeaderSnapshot->GetString();
 	FTextLocation DeclarationCursorLocation = EditorContainer->GetDeclarationTextBoxWrapper()->GetLastCursorLocation();
+	const int32 DeclarationCursorPosition = HeaderSnapshot->LocationToPosition(DeclarationCursorLocation);
 	FTextLocation InsertLocation;
 	if (!GetInsertLocation(
 		EditorContainer->IsLoadIsolated(),
@@ -57,7 +60,7 @@ bool QCE_GenerateDefinitionHelpers::TryGenerateAndInsertDefinition(UMainEditorCo
 		return false;
 
 	FString FunctionDefinition;
-	FString FunctionName = QCE_CommonIOHelpers::GetWordAtPosition(HeaderContent, QCE_CommonIOHelpers::ConvertTextLocationToPosition(HeaderContent, DeclarationCursorLocation));
+	FString FunctionName = QCE_CommonIOHelpers::GetWordAtPosition(HeaderContent, DeclarationCursorPosition);
 	if (FunctionName.IsEmpty())
 	{
 		UE_LOG(LogQuickCodeEditor, Warning, TEXT("Could not extract function name at cursor position"));
@@ -66,7 +69,7 @@ bool QCE_GenerateDefinitionHelpers::TryGenerateAndInsertDefinition(UMainEditorCo
 	if (!GenerateDefinition(
 		FunctionName,
 		HeaderContent,
-		QCE_CommonIOHelpers::ConvertTextLocationToPosition(HeaderContent, DeclarationCursorLocation),
+		DeclarationCursorPosition,
 		FunctionDefinition))
 	{
 		return false;
@@ -167,7 +170,7 @@ bool QCE_GenerateDefinitionHelpers::GetImplementationText(UMainEditorContainer*
 		return false;
 	}
 
-	OutImplementationText = ImplementationTextBox->GetText().ToString();
+	OutImplementationText = ImplementationTextBox->GetSnapshot()->GetString();
 	return true;
 }
 
@@ -0,0 +1,93 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/LineNumbers/QCE_LineNumberGutter.h"
+
+#include "Algo/BinarySearch.h"
+#include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextLayout.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+#include "Settings/UQCE_EditorSettings.h"
+
+void SQCE_LineNumberGutter::Construct(const FArguments& InArgs)
+{
+	TextBox = InArgs._TextBox;
+	ColorAndOpacity = InArgs._ColorAndOpacity;
+	MinDesiredWidth = InArgs._MinDesiredWidth;
+}
+
+FSlateFontInfo SQCE_LineNumberGutter::GetFont()
+{
+	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+	check(Settings);
+	return FCoreStyle::GetDefaultFontStyle(TEXT("Mono"), Settings->FontSize);
+}
+
+FVector2D SQCE_LineNumberGutter::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Wide enough for the last line number, the height follows the text box next to it
+	const int32 NumLines = TextBox.IsValid() ? TextBox->GetSnapshot()->GetNumLines() : 1;
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	const float NumbersWidth = FontMeasure->Measure(FString::FromInt(NumLines), GetFont()).X;
+	return FVector2D(FMath::Max(MinDesiredWidth, NumbersWidth), 0.0f);
+}
+
+int32 SQCE_LineNumberGutter::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if (!TextBox.IsValid() || !TextBox->FQCE_TextLayout.IsValid())
+		return LayerId;
+
+	const FQCE_TextLayout& TextLayout = *TextBox->FQCE_TextLayout;
+	const TArray<FTextLayout::FLineView>& LineViews = TextLayout.GetLineViews();
+	if (LineViews.Num() == 0)
+		return LayerId;
+
+	// Line views are in the pre-scaled space of the text, which is offset from the gutter by the text box border and padding
+	const float InverseScale = Inverse(TextLayout.GetScale());
+	const float TextTop = AllottedGeometry.AbsoluteToLocal(TextBox->GetTextGeometry().LocalToAbsolute(FVector2D::ZeroVector)).Y;
+	const float VisibleTop = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft()).Y;
+	const float VisibleBottom = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight()).Y;
+
+	// Line views are sorted top to bottom, skip straight to the first one that reaches into the visible area
+	int32 ViewIndex = Algo::LowerBoundBy(LineViews, VisibleTop, [TextTop, InverseScale](const FTextLayout::FLineView& LineView)
+	{
+		return TextTop + (LineView.Offset.Y + LineView.Size.Y) * InverseScale;
+	});
+
+	const FSlateFontInfo Font = GetFont();
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	const FLinearColor Color = InWidgetStyle.GetColorAndOpacityTint() * ColorAndOpacity;
+	const ESlateDrawEffect DrawEffects = bParentEnabled ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const float GutterWidth = AllottedGeometry.GetLocalSize().X;
+
+	for (; ViewIndex < LineViews.Num(); ++ViewIndex)
+	{
+		const FTextLayout::FLineView& LineView = LineViews[ViewIndex];
+		const float LineTop = TextTop + LineView.Offset.Y * InverseScale;
+		if (LineTop > VisibleBottom)
+			break;
+
+		// A wrapped line has a view per row, only its first row gets the number
+		if (ViewIndex > 0 && LineViews[ViewIndex - 1].ModelIndex == LineView.ModelIndex)
+			continue;
+
+		const FString LineNumber = FString::FromInt(LineView.ModelIndex + 1);
+		const FVector2D NumberSize = FontMeasure->Measure(LineNumber, Font);
+
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.ToPaintGeometry(
+				NumberSize,
+				FSlateLayoutTransform(FVector2D(GutterWidth - NumberSize.X, LineTop))
+			),
+			LineNumber,
+			Font,
+			DrawEffects,
+			Color
+		);
+	}
+
+	return LayerId;
+}
@@ -2,7 +2,6 @@
 
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
 #include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextLayout.h"
-#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_CommonIOHelpers.h"
 #include "Editor/CustomTextBox/CodeCompletion/UI/QCE_CodeCompletionSuggestionBox.h"
 #include "Fonts/FontMeasure.h"
 #include "Framework/Text/TextLayout.h"
@@ -15,6 +14,18 @@
 #include "Editor/CustomTextBox/Utility/Indentation/QCE_IndentationManager.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/Commands/GenericCommands.h"
+#include "Framework/Commands/UICommandList.h"
+#include "HAL/PlatformApplicationMisc.h"
+
+namespace
+{
+	/**
+	 * Every in-place edit has a fixed cost in the editable text, so a step with more edits than this
+	 * sets the whole text at once instead. The undo history still records just the edits.
+	 */
+	constexpr int32 MaxInPlaceEdits = 1000;
+}
 
 #pragma region General
 void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
@@ -48,7 +59,7 @@ void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
 		.VScrollBar(InArgs._VScrollBar)
 		.HScrollBarPadding(InArgs._HScrollBarPadding)
 		.VScrollBarPadding(InArgs._VScrollBarPadding)
-		.OnTextChanged(InArgs._OnTextChanged)
+		.OnTextChanged(this, &SQCE_MultiLineEditableTextBox::HandleTextChanged)
 		.OnTextCommitted(InArgs._OnTextCommitted)
 		.OnVerifyTextChanged(InArgs._OnVerifyTextChanged)
 		.OnHScrollBarUserScrolled(InArgs._OnHScrollBarUserScrolled)
@@ -58,7 +69,7 @@ void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
 				this, &SQCE_MultiLineEditableTextBox::SelectCursorWordOccurrences))
 		.WrapTextAt(InArgs._WrapTextAt)
 		.AutoWrapText(InArgs._AutoWrapText)
-		.ContextMenuExtender(InArgs._ContextMenuExtender)
+		.OnContextMenuOpening(this, &SQCE_MultiLineEditableTextBox::BuildContextMenu)
 		.WrappingPolicy(InArgs._WrappingPolicy)
 		.SelectAllTextOnCommit(InArgs._SelectAllTextOnCommit)
 		.SelectWordOnMouseDoubleClick(InArgs._SelectWordOnMouseDoubleClick)
@@ -71,7 +82,12 @@ void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
 		.VirtualKeyboardDismissAction(InArgs._VirtualKeyboardDismissAction)
 	);
 
+	Document.SetText(GetText());
+	MarkTextUnmodified();
+
 	LastHighlightedWord = FString();
+	OnTextChangedCallback = InArgs._OnTextChanged;
+	ContextMenuExtender = InArgs._ContextMenuExtender;
 	OnQCEFocused = InArgs._OnQCEFocused;
 	OnSearchRequested = InArgs._OnSearchRequested;
 	OnSaveRequested = InArgs._OnSaveRequested;
@@ -79,6 +95,28 @@ void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
 	OnGoToLineRequested = InArgs._OnGoToLineRequested;
 	OnCodeCompletionRequested = InArgs._OnCodeCompletionRequested;
 	
+	ContextMenuCommands = MakeShared<FUICommandList>();
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Undo,
+		FExecuteAction::CreateLambda([this]() { Undo(); }),
+		FCanExecuteAction::CreateLambda([this]() { return !EditableText->IsTextReadOnly() && UndoHistory.PeekUndo(); }));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Redo,
+		FExecuteAction::CreateLambda([this]() { Redo(); }),
+		FCanExecuteAction::CreateLambda([this]() { return !EditableText->IsTextReadOnly() && UndoHistory.PeekRedo(); }));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Cut,
+		FExecuteAction::CreateSP(this, &SQCE_MultiLineEditableTextBox::CutSelectedText),
+		FCanExecuteAction::CreateLambda([this]() { return !EditableText->IsTextReadOnly() && HasSelectedText(); }));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Copy,
+		FExecuteAction::CreateSP(this, &SQCE_MultiLineEditableTextBox::CopySelectedText),
+		FCanExecuteAction::CreateSP(this, &SQCE_MultiLineEditableTextBox::HasSelectedText));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Paste,
+		FExecuteAction::CreateSP(this, &SQCE_MultiLineEditableTextBox::PasteText),
+		FCanExecuteAction::CreateLambda([this]() { return !EditableText->IsTextReadOnly(); }));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().Delete,
+		FExecuteAction::CreateSP(this, &SQCE_MultiLineEditableTextBox::DeleteSelectedText),
+		FCanExecuteAction::CreateLambda([this]() { return !EditableText->IsTextReadOnly() && HasSelectedText(); }));
+	ContextMenuCommands->MapAction(FGenericCommands::Get().SelectAll,
+		FExecuteAction::CreateLambda([this]() { SelectAllText(); }));
+
 	SetOnKeyDownHandler(FOnKeyDown::CreateRaw(this, &SQCE_MultiLineEditableTextBox::HandleKeyDown));
 	SetOnKeyCharHandler(FOnKeyChar::CreateRaw(this, &SQCE_MultiLineEditableTextBox::HandleKeyChar));
 
@@ -89,6 +127,27 @@ void SQCE_MultiLineEditableTextBox::Construct(const FArguments& InArgs)
 FReply SQCE_MultiLineEditableTextBox::HandleKeyDown(const FGeometry& Geometry, const FKeyEvent& KeyEvent)
 {
 	const auto Key = KeyEvent.GetKey();
+	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+	check(Settings);
+
+	const FInputChord KeyEventChord(Key,
+	                                EModifierKey::FromBools(KeyEvent.IsControlDown(), KeyEvent.IsAltDown(),
+	                                                        KeyEvent.IsShiftDown(), KeyEvent.IsCommandDown()));
+
+	// Checked before the editable text gets the key: the plugin's undo history replaces the text's own,
+	// so both shortcuts are handled even with nothing to undo or redo
+	if (Settings->UndoKeybinding.IsValidChord() && Settings->UndoKeybinding == KeyEventChord)
+	{
+		Undo();
+		return FReply::Handled();
+	}
+
+	if (Settings->RedoKeybinding.IsValidChord() && Settings->RedoKeybinding == KeyEventChord)
+	{
+		Redo();
+		return FReply::Handled();
+	}
+
 	if (Key == EKeys::BackSpace && !bIsChatBox && !bShouldFocusCodeCompletionMenu)
 	{
 		if (QCE_IndentationManager::HandleSmartBackspace(this))
@@ -149,7 +208,6 @@ FReply SQCE_MultiLineEditableTextBox::HandleKeyChar(const FGeometry& MyGeometry,
 		SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
 
 		const FTextLocation CursorLocation = EditableText->GetCursorLocation();
-		const FString FullText = GetText().ToString();
 		
 		FString CurrentIndentation;
 		QCE_IndentationManager::GetLineIndentation(this, CurrentIndentation);
@@ -308,12 +366,292 @@ void SQCE_MultiLineEditableTextBox::SelectCursorWordOccurrences(const FTextLocat
 {
 	LastCursorLocation = CursorLocation;
 
+	// Wait for the cursor to settle, so holding an arrow key does not highlight every word it passes
+	if (WordHighlightTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(WordHighlightTimerHandle.ToSharedRef());
+		WordHighlightTimerHandle.Reset();
+	}
+
+	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+	const float Delay = Settings ? Settings->WordHighlightDelaySeconds : 0.0f;
+	if (Delay <= 0.0f)
+	{
+		HighlightCursorWord();
+		return;
+	}
+
+	WordHighlightTimerHandle = RegisterActiveTimer(Delay, FWidgetActiveTimerDelegate::CreateSP(this, &SQCE_MultiLineEditableTextBox::HandleWordHighlightTimer));
+}
+
+void SQCE_MultiLineEditableTextBox::HandleTextChanged(const FText& NewText)
+{
+	if (bReplacingRanges)
+	{
+		Document.SetText(NewText);
+	}
+	else
+	{
+		// Whatever changed the text, the step only keeps the range that differs
+		FQCE_TextEdit Edit;
+		Document.SetText(NewText, &Edit);
+
+		UndoHistory.PushTyping(MoveTemp(Edit));
+	}
+
+	OnTextChangedCallback.ExecuteIfBound(NewText);
+}
+
+bool SQCE_MultiLineEditableTextBox::IsTextUnmodified() const
+{
+	if (!UnmodifiedSnapshot.IsValid())
+	{
+		return false;
+	}
+
+	const FQCE_TextSnapshot& Current = *GetSnapshot();
+	if (Current.GetVersion() == UnmodifiedSnapshot->GetVersion())
+	{
+		return true;
+	}
+
+	if (Current.Len() != UnmodifiedSnapshot->Len() || Current.GetContentHash() != UnmodifiedSnapshot->GetContentHash())
+	{
+		return false;
+	}
+
+	// Same length and hash, most likely edited back to the unmodified text
+	return Current.Equals(UnmodifiedSnapshot->GetString());
+}
+
+void SQCE_MultiLineEditableTextBox::LoadText(const FText& InText)
+{
+	if (!GetSnapshot()->Equals(InText.ToString()))
+	{
+		SetText(InText);
+		UndoHistory.Reset();
+	}
+
+	MarkTextUnmodified();
+}
+
+void SQCE_MultiLineEditableTextBox::SetReadOnlyAndResetUndo(const TAttribute<bool>& InIsReadOnly)
+{
+	const bool bWasReadOnly = EditableText->IsTextReadOnly();
+	SetIsReadOnly(InIsReadOnly);
+
+	// Steps recorded before the text was locked may no longer match it once it is editable again
+	if (EditableText->IsTextReadOnly() != bWasReadOnly)
+	{
+		UndoHistory.Reset();
+	}
+}
+
+void SQCE_MultiLineEditableTextBox::ApplyEdits(TArray<FQCE_TextEdit>&& Edits)
+{
+	if (ReplaceRanges(Edits, false))
+	{
+		UndoHistory.Push(MoveTemp(Edits));
+	}
+}
+
+bool SQCE_MultiLineEditableTextBox::Undo()
+{
+	const TArray<FQCE_TextEdit>* Edits = UndoHistory.PeekUndo();
+	if (!Edits || !ReplaceRanges(*Edits, true))
+	{
+		return false;
+	}
+
+	UndoHistory.Undo();
+	return true;
+}
+
+bool SQCE_MultiLineEditableTextBox::Redo()
+{
+	const TArray<FQCE_TextEdit>* Edits = UndoHistory.PeekRedo();
+	if (!Edits || !ReplaceRanges(*Edits, false))
+	{
+		return false;
+	}
+
+	UndoHistory.Redo();
+	return true;
+}
+
+bool SQCE_MultiLineEditableTextBox::ReplaceRanges(const TArray<FQCE_TextEdit>& Edits, const bool bRevert)
+{
+	// A text transaction must not be opened on a read-only text
+	if (!EditableText.IsValid() || EditableText->IsTextReadOnly() || Edits.Num() == 0)
+	{
+		return false;
+	}
+
+	// Edits are sorted back to front and positioned in the text before the step. Reverting, the text is the one
+	// after the step, where each edit has been shifted by what the edits in front of it added.
+	TArray<int32> Positions;
+	Positions.SetNumUninitialized(Edits.Num());
+	int32 Shift = 0;
+	int32 LengthChange = 0;
+	for (int32 EditIndex = Edits.Num() - 1; EditIndex >= 0; --EditIndex)
+	{
+		const FQCE_TextEdit& Edit = Edits[EditIndex];
+		Positions[EditIndex] = Edit.Position + Shift;
+		if (bRevert)
+		{
+			Shift += Edit.Inserted.Len() - Edit.Removed.Len();
+		}
+		LengthChange += bRevert ? Edit.Removed.Len() - Edit.Inserted.Len() : Edit.Inserted.Len() - Edit.Removed.Len();
+	}
+
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = GetSnapshot();
+	const uint32 VersionBefore = Snapshot->GetVersion();
+	{
+		// Declared before the transaction, so it is still set when ending the transaction reports the change
+		TGuardValue<bool> ReplacingRangesGuard(bReplacingRanges, true);
+		SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
+
+		if (Edits.Num() <= MaxInPlaceEdits)
+		{
+			// Back to front, so the locations resolved in the snapshot stay valid while the edits are applied
+			for (int32 EditIndex = 0; EditIndex < Edits.Num(); ++EditIndex)
+			{
+				const FQCE_TextEdit& Edit = Edits[EditIndex];
+				const FString& OldText = bRevert ? Edit.Inserted : Edit.Removed;
+				const FString& NewText = bRevert ? Edit.Removed : Edit.Inserted;
+
+				EditableText->SelectText(
+					Snapshot->PositionToLocation(Positions[EditIndex]),
+					Snapshot->PositionToLocation(Positions[EditIndex] + OldText.Len()));
+				if (NewText.IsEmpty())
+				{
+					EditableText->DeleteSelectedText();
+				}
+				else
+				{
+					EditableText->InsertTextAtCursor(FText::FromString(NewText));
+				}
+			}
+		}
+		else
+		{
+			const FString& OldString = Snapshot->GetString();
+			FString NewString;
+			NewString.Reserve(OldString.Len() + LengthChange);
+
+			int32 CopiedEnd = 0;
+			for (int32 EditIndex = Edits.Num() - 1; EditIndex >= 0; --EditIndex)
+			{
+				const FQCE_TextEdit& Edit = Edits[EditIndex];
+				const FString& OldText = bRevert ? Edit.Inserted : Edit.Removed;
+				const FString& NewText = bRevert ? Edit.Removed : Edit.Inserted;
+
+				NewString.AppendChars(*OldString + CopiedEnd, Positions[EditIndex] - CopiedEnd);
+				NewString.Append(NewText);
+				CopiedEnd = Positions[EditIndex] + OldText.Len();
+			}
+			NewString.AppendChars(*OldString + CopiedEnd, OldString.Len() - CopiedEnd);
+
+			SetText(FText::FromString(NewString));
+		}
+	}
+
+	return GetTextVersion() != VersionBefore;
+}
+
+TSharedPtr<SWidget> SQCE_MultiLineEditableTextBox::BuildContextMenu()
+{
+	// Same sections as the editable text's default menu, the owner's entries going before them
+	TSharedRef<FExtender> MenuExtender = MakeShared<FExtender>();
+	if (ContextMenuExtender.IsBound())
+	{
+		MenuExtender->AddMenuExtension("EditText", EExtensionHook::Before, TSharedPtr<FUICommandList>(), ContextMenuExtender);
+	}
+
+	FMenuBuilder MenuBuilder(true, ContextMenuCommands, MenuExtender);
+	MenuBuilder.BeginSection("EditText", NSLOCTEXT("QCE_MultiLineEditableTextBox", "ModifyTextHeading", "Modify Text"));
+	{
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Undo);
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Redo);
+	}
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection("EditableTextModify2");
+	{
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Cut);
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Copy);
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Paste);
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().Delete);
+	}
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection("EditableTextModify3");
+	{
+		MenuBuilder.AddMenuEntry(FGenericCommands::Get().SelectAll);
+	}
+	MenuBuilder.EndSection();
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SQCE_MultiLineEditableTextBox::CutSelectedText()
+{
+	CopySelectedText();
+	DeleteSelectedText();
+}
+
+void SQCE_MultiLineEditableTextBox::CopySelectedText()
+{
+	if (HasSelectedText())
+	{
+		FPlatformApplicationMisc::ClipboardCopy(*GetSelectedText().ToString());
+	}
+}
+
+void SQCE_MultiLineEditableTextBox::PasteText()
+{
+	FString ClipboardText;
+	FPlatformApplicationMisc::ClipboardPaste(ClipboardText);
+	if (!ClipboardText.IsEmpty() && !EditableText->IsTextReadOnly())
+	{
+		EditableText->InsertTextAtCursor(ClipboardText);
+	}
+}
+
+void SQCE_MultiLineEditableTextBox::DeleteSelectedText()
+{
+	if (HasSelectedText() && !EditableText->IsTextReadOnly())
+	{
+		SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
+		EditableText->DeleteSelectedText();
+	}
+}
+
+bool SQCE_MultiLineEditableTextBox::HasSelectedText() const
+{
+	return !GetSelectedText().IsEmpty();
+}
+
+EActiveTimerReturnType SQCE_MultiLineEditableTextBox::HandleWordHighlightTimer(double InCurrentTime, float InDeltaTime)
+{
+	WordHighlightTimerHandle.Reset();
+	HighlightCursorWord();
+	return EActiveTimerReturnType::Stop;
+}
+
+void SQCE_MultiLineEditableTextBox::HighlightCursorWord()
+{
 	const FString CurrentWord = GetWordAtCursor();
 	if (CurrentWord == LastHighlightedWord) return;
 
 	SelectWordOccurrences(CurrentWord);
 }
 
+int32 SQCE_MultiLineEditableTextBox::GetHighlightedWordCount() const
+{
+	return FQCE_TextLayout && !LastHighlightedWord.IsEmpty() ? FQCE_TextLayout->GetHighlightedWordCount() : 0;
+}
+
 void SQCE_MultiLineEditableTextBox::SelectWordOccurrences(const FString& TargetWord)
 {
 	if (!LastHighlightedWord.IsEmpty() && FQCE_TextLayout)
@@ -333,24 +671,10 @@ void SQCE_MultiLineEditableTextBox::SelectSpecificOccurrence(const FString& Word
 	if (FQCE_TextLayout)
 		FQCE_TextLayout->ClearHighlights();
 
-	const FString TextString = GetText().ToString();
-
-	int32 LineIndex = 0;
-	int32 LineStartPos = 0;
-	int32 CurrentPos = 0;
-
-	while (CurrentPos < AbsolutePosition && CurrentPos < TextString.Len())
-	{
-		if (TextString[CurrentPos] == TEXT('\n'))
-		{
-			LineIndex++;
-			LineStartPos = CurrentPos + 1;
-		}
-		CurrentPos++;
-	}
-
-	int32 StartOffset = AbsolutePosition - LineStartPos;
-	int32 EndOffset = StartOffset + Length;
+	const FTextLocation OccurrenceLocation = PositionToLocation(AbsolutePosition);
+	const int32 LineIndex = OccurrenceLocation.GetLineIndex();
+	const int32 StartOffset = OccurrenceLocation.GetOffset();
+	const int32 EndOffset = StartOffset + Length;
 
 	if (FQCE_TextLayout)
 	{
@@ -372,24 +696,23 @@ FString SQCE_MultiLineEditableTextBox::GetWordAtCursor() const
 
 FString SQCE_MultiLineEditableTextBox::GetWordAtLocation(const FTextLocation TargetLocation) const
 {
-	const FText CurrentText = GetText();
-	const FString TextString = CurrentText.ToString();
-	FString CurrentLine;
-	GetCurrentTextLine(CurrentLine);
-	int32 WordStart = TargetLocation.GetOffset();
+	const TSharedRef<const FQCE_TextSnapshot>& Snapshot = GetSnapshot();
+	const FStringView CurrentLine = Snapshot->GetLine(TargetLocation.GetLineIndex());
+	int32 WordStart = FMath::Clamp(TargetLocation.GetOffset(), 0, CurrentLine.Len());
 	int32 WordEnd = WordStart;
 
-	while (WordStart > 0 && FChar::IsAlnum(CurrentLine[WordStart - 1]))
+	// Same word characters as C++ identifiers, so the word can be looked up in the identifier index
+	while (WordStart > 0 && (FChar::IsAlnum(CurrentLine[WordStart - 1]) || CurrentLine[WordStart - 1] == TEXT('_')))
 	{
 		--WordStart;
 	}
 
-	while (WordEnd < CurrentLine.Len() && FChar::IsAlnum(CurrentLine[WordEnd]))
+	while (WordEnd < CurrentLine.Len() && (FChar::IsAlnum(CurrentLine[WordEnd]) || CurrentLine[WordEnd] == TEXT('_')))
 	{
 		++WordEnd;
 	}
 
-	return CurrentLine.Mid(WordStart, WordEnd - WordStart);
+	return FString(CurrentLine.Mid(WordStart, WordEnd - WordStart));
 }
 
 #pragma endregion
@@ -409,8 +732,8 @@ void SQCE_MultiLineEditableTextBox::ShowMemberSuggestions()
 	}
 
 	const FTextLocation CursorLocation = EditableText->GetCursorLocation();
-	const FString TextString = GetText().ToString();
-	int32 AbsoluteCursorPosition = QCE_CommonIOHelpers::ConvertTextLocationToPosition(TextString, CursorLocation);
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = GetSnapshot();
+	int32 AbsoluteCursorPosition = Snapshot->LocationToPosition(CursorLocation);
 	
 	if (AbsoluteCursorPosition == INDEX_NONE)
 	{
@@ -419,7 +742,7 @@ void SQCE_MultiLineEditableTextBox::ShowMemberSuggestions()
 		return;
 	}
 	
-	QCE_CodeCompletionSuggestionBox->InitSuggestions(TextString, AbsoluteCursorPosition, this);
+	QCE_CodeCompletionSuggestionBox->InitSuggestions(Snapshot->GetString(), AbsoluteCursorPosition, this);
 	
 	CodeCompletionMenuContainer = FSlateApplication::Get().PushMenu(
 		SMultiLineEditableTextBox::AsShared(),
@@ -610,7 +933,8 @@ void SQCE_MultiLineEditableTextBox::OnInlineAISuggestionConfirmed(FUserInputCont
 		FOnCompletionReceived CompletionDelegate;
 		CompletionDelegate.BindSP(this, &SQCE_MultiLineEditableTextBox::OnAICompletionReceived);
 
-		const FString CurrentTypedCode = GetText().ToString();
+		const TSharedRef<const FQCE_TextSnapshot> Snapshot = GetSnapshot();
+		const FString& CurrentTypedCode = Snapshot->GetString();
 		
 		FString RequiredCodeContext;
 		bool bCodeContextExtracted = QCE_InlineAISuggestionContextBuilder::GetAIContext(CurrentTypedCode, CursorLocation, GetTextBoxType(), UserInputContext, RequiredCodeContext);
@@ -3,8 +3,9 @@
 
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBoxWrapper.h"
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
+#include "Editor/CustomTextBox/LineNumbers/QCE_LineNumberGutter.h"
 #include "Widgets/Layout/SScrollBox.h"
-#include "Widgets/Layout/SBox.h"
+#include "Widgets/SOverlay.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Settings/UQCE_EditorSettings.h"
 
@@ -12,6 +13,7 @@ void QCE_MultiLineEditableTextBoxWrapper::Construct(const FArguments& InArgs)
 {
     bEnableLineNumberColumn = InArgs._EnableLineNumbers;
     MainEditorContainer = InArgs._MainEditorContainer;
+    OnVisibleLinesChanged = InArgs._OnVisibleLinesChanged;
     
     TSharedRef<SQCE_MultiLineEditableTextBox> TextBoxRef = SNew(SQCE_MultiLineEditableTextBox)
         .AllowMultiLine(InArgs._AllowMultiLine)
@@ -50,19 +52,15 @@ void QCE_MultiLineEditableTextBoxWrapper::Construct(const FArguments& InArgs)
     TSharedRef<SHorizontalBox> HorizontalBox = SNew(SHorizontalBox);
     if (bEnableLineNumberColumn)
     {
-        LineNumbers = SNew(STextBlock)
-            .Justification(ETextJustify::Right)
-            .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f));
+        LineNumbers = SNew(SQCE_LineNumberGutter)
+            .TextBox(TextBoxRef)
+            .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+            .MinDesiredWidth(24.0f);
         HorizontalBox->AddSlot()
             .AutoWidth()
             .Padding(4, 0, 4, 0)
             [
-                SNew(SBox)
-                .MinDesiredWidth(24.0f)
-                .MaxDesiredWidth(24.0f)
-                [
-                    LineNumbers.ToSharedRef()
-                ]
+                LineNumbers.ToSharedRef()
             ];
     }
 
@@ -74,10 +72,31 @@ void QCE_MultiLineEditableTextBoxWrapper::Construct(const FArguments& InArgs)
 
     ChildSlot
     [
-        SAssignNew(WrapperScrollBox, SScrollBox)
-        + SScrollBox::Slot()
+        SNew(SOverlay)
+        + SOverlay::Slot()
         [
-            HorizontalBox
+            SAssignNew(WrapperScrollBox, SScrollBox)
+            + SScrollBox::Slot()
+            [
+                HorizontalBox
+            ]
+        ]
+        // Occurrence count of the highlighted word, shown in the top right corner
+        + SOverlay::Slot()
+        .HAlign(HAlign_Right)
+        .VAlign(VAlign_Top)
+        .Padding(0, 2, 16, 0)
+        [
+            SNew(STextBlock)
+            .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+            .Text_Lambda([this]()
+            {
+                return FText::Format(NSLOCTEXT("QCE_MultiLineEditableTextBoxWrapper", "WordOccurrences", "{0} occurrences"), TextBox->GetHighlightedWordCount());
+            })
+            .Visibility_Lambda([this]()
+            {
+                return TextBox.IsValid() && TextBox->GetHighlightedWordCount() > 1 ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+            })
         ]
     ];
 
@@ -93,6 +112,29 @@ void QCE_MultiLineEditableTextBoxWrapper::Construct(const FArguments& InArgs)
     }
 }
 
+void QCE_MultiLineEditableTextBoxWrapper::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+    SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+    if (!OnVisibleLinesChanged.IsBound() || !WrapperScrollBox.IsValid())
+        return;
+
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    check(Settings);
+    const float FontSize = static_cast<float>(Settings->FontSize);
+    const float LineHeight = FontSize * 1.5f;
+    const float ViewportHeight = WrapperScrollBox->GetCachedGeometry().GetLocalSize().Y;
+
+    const int32 FirstLine = FMath::Max(0, FMath::FloorToInt(WrapperScrollBox->GetScrollOffset() / LineHeight));
+    const int32 LastLine = FirstLine + FMath::Max(1, FMath::CeilToInt(ViewportHeight / LineHeight));
+    if (FirstLine != LastVisibleFirstLine || LastLine != LastVisibleLastLine)
+    {
+        LastVisibleFirstLine = FirstLine;
+        LastVisibleLastLine = LastLine;
+        OnVisibleLinesChanged.Execute(FirstLine, LastLine);
+    }
+}
+
 void QCE_MultiLineEditableTextBoxWrapper::SetIsModified(bool bNewIsModified)
 {
     TextBox->SetIsModified(bNewIsModified);
@@ -114,6 +156,7 @@ bool QCE_MultiLineEditableTextBoxWrapper::ScrollToLine(const int32 TargetLine) c
     if (!WrapperScrollBox.IsValid() || !TextBox.IsValid())
         return false;
     
+    const int32 LineCount = TextBox->GetSnapshot()->GetNumLines();
     if (TargetLine < 1 || TargetLine > LineCount)
         return false;
     
@@ -139,18 +182,10 @@ void QCE_MultiLineEditableTextBoxWrapper::ScrollToPosition(const int32 TargetPos
     if (!TextBox.IsValid() || !WrapperScrollBox.IsValid())
         return;
     
-    const FString& Text = TextBox->GetText().ToString();
-    if (TargetPosition < 0 || TargetPosition >= Text.Len())
+    if (TargetPosition < 0)
         return;
 
-    int32 LineNumber = 1;
-    for (int32 i = 0; i < TargetPosition && i < Text.Len(); i++)
-    {
-        if (Text[i] == TEXT('\n'))
-        {
-            LineNumber++;
-        }
-    }
+    const int32 LineNumber = TextBox->PositionToLocation(TargetPosition).GetLineIndex() + 1;
 
     const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
     check(Settings);
@@ -162,19 +197,8 @@ void QCE_MultiLineEditableTextBoxWrapper::ScrollToPosition(const int32 TargetPos
 
 void QCE_MultiLineEditableTextBoxWrapper::UpdateLineNumbers()
 {
-    if (!bEnableLineNumberColumn || !TextBox.IsValid() || !LineNumbers.IsValid())
+    if (!bEnableLineNumberColumn || !LineNumbers.IsValid())
         return;
 
-    const FString Text = TextBox->GetText().ToString();
-    LineCount = Text.Len() - Text.Replace(TEXT("\n"), TEXT("")).Len() + 1;
-    
-    FString LineNumbersText;
-    for (int32 i = 1; i <= LineCount; ++i)
-    {
-        LineNumbersText.Append(FString::FromInt(i));
-        if (i < LineCount)
-            LineNumbersText.Append(TEXT("\n"));
-    }
-
-    LineNumbers->SetText(FText::FromString(LineNumbersText));
-}
+    LineNumbers->Invalidate(EInvalidateWidgetReason::Layout);
+}
\ No newline at end of file
@@ -2,13 +2,53 @@
 
 #include "Editor/CustomTextBox/SyntaxHighlight/CPPSyntaxHighlighterMarshaller.h"
 
+#include "Async/Async.h"
 #include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_IdentifierIndex.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_SyntaxStyleTable.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextLayout.h"
 #include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextRun.h"
 #include "Framework/Text/IRun.h"
 #include "Framework/Text/TextLayout.h"
-#include "Framework/Text/SlateTextRun.h"
+#include "HAL/PlatformTime.h"
 #include "Settings/UQCE_EditorSettings.h"
 
+#include <atomic>
+
+namespace
+{
+    /** Run name for each ECppTokenKind */
+    const TCHAR* const TokenKindRunNames[] =
+    {
+        TEXT("SyntaxHighlight.Normal"),
+        TEXT("SyntaxHighlight.Operator"),
+        TEXT("SyntaxHighlight.Keyword"),
+        TEXT("SyntaxHighlight.String"),
+        TEXT("SyntaxHighlight.Number"),
+        TEXT("SyntaxHighlight.Comment"),
+        TEXT("SyntaxHighlight.PreProcessor"),
+        TEXT("SyntaxHighlight.UnrealTypeDef"),
+        TEXT("SyntaxHighlight.FunctionName"),
+        TEXT("SyntaxHighlight.ClassName"),
+    };
+    static_assert(UE_ARRAY_COUNT(TokenKindRunNames) == static_cast<int32>(ECppTokenKind::Count), "Every token kind needs a run name");
+}
+
+struct FCPPSyntaxHighlighterMarshaller::FBackgroundTokenization
+{
+    /** Document version the snapshot was taken at */
+    uint32 DocumentVersion = 0;
+
+    FString Snapshot;
+    TArray<FCppSyntaxTokenizer::FCachedLine> LexedLines;
+
+    /** Set by the game thread when the result is no longer wanted, so a job that did not start yet can skip the work */
+    std::atomic<bool> bCancelled { false };
+
+    /** Set by the worker once LexedLines is complete */
+    std::atomic<bool> bFinished { false };
+};
+
 TSharedRef<FCPPSyntaxHighlighterMarshaller> FCPPSyntaxHighlighterMarshaller::Create()
 {
     TSharedPtr<ISyntaxTokenizer> Tokenizer = FCppSyntaxTokenizer::Create();
@@ -16,22 +56,95 @@ TSharedRef<FCPPSyntaxHighlighterMarshaller> FCPPSyntaxHighlighterMarshaller::Cre
 }
 
 FCPPSyntaxHighlighterMarshaller::FCPPSyntaxHighlighterMarshaller(TSharedPtr<ISyntaxTokenizer> InTokenizer)
-    : FSyntaxHighlighterTextLayoutMarshaller(MoveTemp(InTokenizer)), CurrentSyntaxStyle(false)
+    : FSyntaxHighlighterTextLayoutMarshaller(MoveTemp(InTokenizer))
+    , IdentifierIndex(MakeShared<FQCE_IdentifierIndex>())
+{
+    StyleTableChangedHandle = FQCE_SyntaxStyleTable::OnCurrentTableChanged().AddRaw(this, &FCPPSyntaxHighlighterMarshaller::HandleStyleTableChanged);
+}
+
+FCPPSyntaxHighlighterMarshaller::~FCPPSyntaxHighlighterMarshaller()
 {
-    if (UQCE_EditorSettings* Settings = GetMutableDefault<UQCE_EditorSettings>())
+    FQCE_SyntaxStyleTable::OnCurrentTableChanged().Remove(StyleTableChangedHandle);
+    CancelBackgroundTokenization();
+    ClearPendingLines();
+}
+
+void FCPPSyntaxHighlighterMarshaller::SetLazyHighlightLayout(const TSharedPtr<FQCE_TextLayout>& InTextLayout)
+{
+    LazyHighlightLayout = InTextLayout;
+
+    if (InTextLayout.IsValid())
+    {
+        InTextLayout->SetIdentifierIndex(IdentifierIndex);
+    }
+}
+
+void FCPPSyntaxHighlighterMarshaller::SetText(const FString& SourceString, FTextLayout& TargetTextLayout)
+{
+    // Whatever is still being lexed describes an older text
+    DocumentVersion++;
+    CancelBackgroundTokenization();
+
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const TSharedPtr<FQCE_TextLayout> LazyLayout = LazyHighlightLayout.Pin();
+
+    // Lines are re-styled in place once the worker is done, which only the lazy highlight layout supports
+    if (bShouldApplyHighlights && CppTokenizer.IsValid() && Settings && Settings->bBackgroundTokenization && LazyLayout.Get() == &TargetTextLayout)
     {
-        Settings->OnSyntaxSettingsUpdated.BindLambda([this]()
+        TArray<FTextRange> LineRanges;
+        FTextRange::CalculateLineRangesFromString(SourceString, LineRanges);
+
+        if (CppTokenizer->CountChangedLines(SourceString, LineRanges) >= Settings->BackgroundTokenizationMinLines)
+        {
+            TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines;
+            CppTokenizer->ProcessDeferred(TokenizedLines, SourceString, LineRanges);
+            ParseTokens(SourceString, TargetTextLayout, MoveTemp(TokenizedLines));
+            StartBackgroundTokenization(SourceString);
+            return;
+        }
+    }
+
+    FSyntaxHighlighterTextLayoutMarshaller::SetText(SourceString, TargetTextLayout);
+}
+
+void FCPPSyntaxHighlighterMarshaller::HandleStyleTableChanged()
+{
+    // Runs look the new table up themselves during layout, so the text does not need to be tokenized again.
+    // Line measurements are flushed as well since the font size or weight may have changed.
+    if (const TSharedPtr<FTextLayout> TextLayout = HighlightedTextLayout.Pin())
+    {
+        const int32 NumLines = TextLayout->GetLineModels().Num();
+        for (int32 LineIndex = 0; LineIndex < NumLines; ++LineIndex)
         {
-            bRefreshStyle = true;
-        });
+            TextLayout->DirtyLineLayout(LineIndex);
+        }
+        TextLayout->DirtyLayout();
     }
 }
 
 void FCPPSyntaxHighlighterMarshaller::ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines)
 {
+    // Lines left plain by the previous pass belong to lines the layout has already dropped
+    ClearPendingLines();
+
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    check(CppTokenizer.IsValid());
+    check(CppTokenizer->GetNumLines() == TokenizedLines.Num());
+
+    // The layout is about to get one line per tokenized line, keep the occurrence index in step with them
+    IdentifierIndex->ApplyDirtyLines(*CppTokenizer);
+
+    HighlightedTextLayout = TargetTextLayout.AsShared();
+    const TSharedRef<const FQCE_SyntaxStyleTable>& StyleTable = FQCE_SyntaxStyleTable::GetCurrent();
+
     // If no node is selected or text box is not set, just add the text without syntax highlighting
     if (!bShouldApplyHighlights)
     {
+        // Plain lines are not cached, so the cache no longer follows the tokenizer
+        CachedLineRuns.Reset();
+
+        const FStringView SourceView(SourceString);
         TArray<FTextLayout::FNewLineData> LinesToAdd;
         LinesToAdd.Reserve(TokenizedLines.Num());
 
@@ -39,17 +152,17 @@ void FCPPSyntaxHighlighterMarshaller::ParseTokens(const FString& SourceString, F
         {
             const ISyntaxTokenizer::FTokenizedLine& TokenizedLine = TokenizedLines[LineIndex];
             TSharedRef<FString> ModelString = MakeShareable(new FString());
+            ModelString->Reserve(TokenizedLine.Range.Len());
             TArray<TSharedRef<IRun>> Runs;
 
             for (const ISyntaxTokenizer::FToken& Token : TokenizedLine.Tokens)
             {
-                const FString TokenText = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
+                const FStringView TokenText = SourceView.Mid(Token.Range.BeginIndex, Token.Range.Len());
                 const FTextRange ModelRange(ModelString->Len(), ModelString->Len() + TokenText.Len());
-                ModelString->Append(TokenText);
+                ModelString->Append(TokenText.GetData(), TokenText.Len());
 
                 FRunInfo RunInfo(TEXT("SyntaxHighlight.Normal"));
-                TSharedRef<ISlateRun> Run = FSlateTextRun::Create(RunInfo, ModelString, GetSyntaxTextStyle().NormalTextStyle, ModelRange);
-                Runs.Add(Run);
+                Runs.Add(FQCE_TextRun::Create(RunInfo, ModelString, StyleTable, ECppTokenKind::Normal, ModelRange));
             }
 
             LinesToAdd.Add(FTextLayout::FNewLineData(MoveTemp(ModelString), MoveTemp(Runs)));
@@ -59,274 +172,366 @@ void FCPPSyntaxHighlighterMarshaller::ParseTokens(const FString& SourceString, F
         return;
     }
 
+    // Large documents only get the lines around the viewport styled now, the rest is styled in place over the next frames
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const TSharedPtr<FQCE_TextLayout> LazyLayout = LazyHighlightLayout.Pin();
+    const bool bHighlightLazily = Settings && Settings->bLazySyntaxHighlighting && LazyLayout.Get() == &TargetTextLayout &&
+        TokenizedLines.Num() >= Settings->LazyHighlightMinLines;
+    const int32 MarginLines = Settings ? Settings->LazyHighlightMarginLines : 0;
+    const int32 EagerFirstLine = bHighlightLazily ? VisibleFirstLine - MarginLines : 0;
+    const int32 EagerLastLine = bHighlightLazily ? VisibleLastLine + MarginLines : TokenizedLines.Num() - 1;
+
+    if (bHighlightLazily)
+    {
+        PendingLines.Init(false, TokenizedLines.Num());
+    }
+
+    UpdateCachedLineRuns(*CppTokenizer);
+
     TArray<FTextLayout::FNewLineData> LinesToAdd;
     LinesToAdd.Reserve(TokenizedLines.Num());
 
     for (int32 LineIndex = 0; LineIndex < TokenizedLines.Num(); ++LineIndex)
     {
         const ISyntaxTokenizer::FTokenizedLine& TokenizedLine = TokenizedLines[LineIndex];
+        FCachedLineRuns& CachedLine = CachedLineRuns[LineIndex];
+        const bool bHighlightNow = LineIndex >= EagerFirstLine && LineIndex <= EagerLastLine;
+        const bool bReuseText = CanReuseCachedLine(*CppTokenizer, LineIndex, CachedLine);
 
-        TSharedRef<FString> ModelString = MakeShareable(new FString());
-        TArray<TSharedRef<IRun>> Runs;
-
-        for (const ISyntaxTokenizer::FToken& Token : TokenizedLine.Tokens)
+        // Lines outside the dirty range keep their text and runs, a plain one only needs styling if it came into view
+        if (!bReuseText || (bHighlightNow && !CachedLine.bHighlighted))
         {
-            const FString TokenText = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
-            const FTextRange ModelRange(ModelString->Len(), ModelString->Len() + TokenText.Len());
-            ModelString->Append(TokenText);
-
-            FRunInfo RunInfo(TEXT("SyntaxHighlight.Normal"));
-             FTextBlockStyle TextBlockStyle = GetSyntaxTextStyle().NormalTextStyle;
+            if (!bReuseText)
+            {
+                // The line text is the only copy made from the source
+                CachedLine.ModelString = MakeShareable(new FString());
+                CachedLine.ModelString->Reserve(TokenizedLine.Range.Len());
+                CachedLine.ModelString->Append(*SourceString + TokenizedLine.Range.BeginIndex, TokenizedLine.Range.Len());
+            }
 
-            // Determine the style based on the token
-            if (Token.Type == ISyntaxTokenizer::ETokenType::Syntax)
+            const TSharedRef<FString> ModelString = CachedLine.ModelString.ToSharedRef();
+            CachedLine.Runs.Reset();
+            if (bHighlightNow)
             {
-                // Check for comments - trust the tokenizer's classification
-                // The tokenizer already handles proper context detection
-                if (IsCommentToken(SourceString, Token))
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.Comment");
-                    TextBlockStyle = GetSyntaxTextStyle().CommentTextStyle;
-                }
-                // Check for preprocessor directives
-                else if (TokenText.StartsWith(TEXT("#")))
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.PreProcessor");
-                    TextBlockStyle = GetSyntaxTextStyle().PreProcessorKeywordTextStyle;
-                }
-                // Check for string literals
-                else if (TokenText.StartsWith(TEXT("\"")) || TokenText.StartsWith(TEXT("'")))
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.String");
-                    TextBlockStyle = GetSyntaxTextStyle().StringTextStyle;
-                }
-                // Check for numbers
-                else if (TokenText.Len() > 0 && TokenText[0] >= TEXT('0') && TokenText[0] <= TEXT('9'))
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.Number");
-                    TextBlockStyle = GetSyntaxTextStyle().NumberTextStyle;
-                }
-                // Check if it's an Unreal typedef
-                else if (TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer))
-                {
-                    if (CppTokenizer->IsUnrealTypeDef(TokenText))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.UnrealTypeDef");
-                        TextBlockStyle = GetSyntaxTextStyle().UnrealTypedefTextStyle;
-                    }
-                    // Check if it's a known keyword
-                    else if (CppTokenizer->IsKeyword(TokenText))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.Keyword");
-                        TextBlockStyle = GetSyntaxTextStyle().KeywordTextStyle;
-                    }
-                    // Check if it's an operator
-                    else if (CppTokenizer->IsOperator(TokenText))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.Operator");
-                        TextBlockStyle = GetSyntaxTextStyle().OperatorTextStyle;
-                    }
-                    // Default to keyword style for unrecognized syntax tokens
-                    else
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.Keyword");
-                        TextBlockStyle = GetSyntaxTextStyle().KeywordTextStyle;
-                    }
-                }
-                // Fallback if tokenizer cast fails - default to keyword style
-                else
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.Keyword");
-                    TextBlockStyle = GetSyntaxTextStyle().KeywordTextStyle;
-                }
-            } else // Literal
+                CreateHighlightedRuns(*CppTokenizer, LineIndex, ModelString, StyleTable, CachedLine.Runs);
+            }
+            else
             {
-                // Check for Unreal typedefs first (with safe casting)
-                if (TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer))
-                {
-                    if (CppTokenizer->IsUnrealTypeDef(TokenText))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.UnrealTypeDef");
-                        TextBlockStyle = GetSyntaxTextStyle().UnrealTypedefTextStyle;
-                    }
-                    // Check for string literals
-                    else if (TokenText.StartsWith(TEXT("\"")) || TokenText.StartsWith(TEXT("'")))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.StringLiteral");
-                        TextBlockStyle = GetSyntaxTextStyle().StringTextStyle;
-                    }
-                    // Check for numeric literals
-                    else if (TokenText.Len() > 0 && TokenText[0] >= TEXT('0') && TokenText[0] <= TEXT('9'))
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.NumericLiteral");
-                        TextBlockStyle = GetSyntaxTextStyle().NumberTextStyle;
-                    }
-                    // Check for identifiers that might be function or class names
-                    else if (TokenText.Len() > 0 && FChar::IsAlpha(TokenText[0]))
-                    {
-                        // Look ahead to detect function names and class names
-                        FString NextTokens;
-                        int32 CurrentTokenIndex = &Token - &TokenizedLine.Tokens[0];
-                        
-                        // Collect next few tokens to analyze pattern
-                        for (int32 LookAheadIndex = CurrentTokenIndex + 1; 
-                             LookAheadIndex < TokenizedLine.Tokens.Num() && LookAheadIndex < CurrentTokenIndex + 3; 
-                             ++LookAheadIndex)
-                        {
-                            const FString NextTokenText = SourceString.Mid(
-                                TokenizedLine.Tokens[LookAheadIndex].Range.BeginIndex, 
-                                TokenizedLine.Tokens[LookAheadIndex].Range.Len()
-                            );
-                            NextTokens += NextTokenText;
-                        }
-                        
-                        // Check if followed by :: (class name)
-                        if (NextTokens.StartsWith(TEXT("::")))
-                        {
-                            RunInfo.Name = TEXT("SyntaxHighlight.ClassName");
-                            TextBlockStyle = GetSyntaxTextStyle().ClassTextStyle;
-                        }
-                        // Check if followed by ( (function name)
-                        else if (NextTokens.Contains(TEXT("(")) && !NextTokens.StartsWith(TEXT(" class")) && !NextTokens.StartsWith(TEXT(" struct")))
-                        {
-                            RunInfo.Name = TEXT("SyntaxHighlight.FunctionName");
-                            TextBlockStyle = GetSyntaxTextStyle().FunctionTextStyle;
-                        }
-                        // Default literal style
-                        else
-                        {
-                            RunInfo.Name = TEXT("SyntaxHighlight.Normal");
-                            TextBlockStyle = GetSyntaxTextStyle().NormalTextStyle;
-                        }
-                    }
-                    // Default literal style
-                    else
-                    {
-                        RunInfo.Name = TEXT("SyntaxHighlight.Normal");
-                        TextBlockStyle = GetSyntaxTextStyle().NormalTextStyle;
-                    }
-                }
-                // Fallback for when tokenizer cast fails
-                else
-                {
-                    RunInfo.Name = TEXT("SyntaxHighlight.Normal");
-                    TextBlockStyle = GetSyntaxTextStyle().NormalTextStyle;
-                }
+                FRunInfo RunInfo(TokenKindRunNames[static_cast<int32>(ECppTokenKind::Normal)]);
+                CachedLine.Runs.Add(FQCE_TextRun::Create(RunInfo, ModelString, StyleTable, ECppTokenKind::Normal, FTextRange(0, ModelString->Len())));
             }
+            CachedLine.bHighlighted = bHighlightNow;
+        }
 
-            TSharedRef<ISlateRun> Run = FQCE_TextRun::Create(RunInfo, ModelString, TextBlockStyle, ModelRange);
-            Runs.Add(Run);
+        if (!CachedLine.bHighlighted)
+        {
+            PendingLines[LineIndex] = true;
+            NumPendingLines++;
         }
 
-        LinesToAdd.Add(FTextLayout::FNewLineData(MoveTemp(ModelString), MoveTemp(Runs)));
+        LinesToAdd.Add(FTextLayout::FNewLineData(CachedLine.ModelString.ToSharedRef(), CachedLine.Runs));
     }
 
     TargetTextLayout.AddLines(LinesToAdd);
+
+    if (NumPendingLines > 0)
+    {
+        NextPendingLine = FMath::Clamp(EagerLastLine + 1, 0, TokenizedLines.Num() - 1);
+        SchedulePendingLines();
+    }
 }
 
-bool FCPPSyntaxHighlighterMarshaller::IsCommentToken(const FString& SourceString, const ISyntaxTokenizer::FToken& Token) const
+void FCPPSyntaxHighlighterMarshaller::UpdateCachedLineRuns(const FCppSyntaxTokenizer& CppTokenizer)
 {
-    const FString TokenText = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
-    
-    // Don't treat string literals as comments, even if they contain comment-like text
-    if (TokenText.StartsWith(TEXT("\"")) || TokenText.StartsWith(TEXT("'")))
+    const FCppSyntaxTokenizer::FDirtyLineRange& DirtyLineRange = CppTokenizer.GetLastDirtyLineRange();
+    const int32 NumLines = CppTokenizer.GetNumLines();
+
+    // A cache that does not match the tokenizer's previous pass, e.g. after highlighting was disabled, starts over
+    if (CachedLineRuns.Num() != NumLines - DirtyLineRange.NumNewLines + DirtyLineRange.NumOldLines ||
+        DirtyLineRange.FirstLine + DirtyLineRange.NumOldLines > CachedLineRuns.Num())
+    {
+        CachedLineRuns.Reset();
+        CachedLineRuns.SetNum(NumLines);
+        return;
+    }
+
+    CachedLineRuns.RemoveAt(DirtyLineRange.FirstLine, DirtyLineRange.NumOldLines, false);
+    CachedLineRuns.InsertDefaulted(DirtyLineRange.FirstLine, DirtyLineRange.NumNewLines);
+}
+
+bool FCPPSyntaxHighlighterMarshaller::CanReuseCachedLine(const FCppSyntaxTokenizer& CppTokenizer, int32 LineIndex, const FCachedLineRuns& CachedLine)
+{
+    if (!CachedLine.ModelString.IsValid() || !CachedLine.ModelString->Equals(CppTokenizer.GetLineText(LineIndex), ESearchCase::CaseSensitive))
     {
         return false;
     }
-    
-    // Single-line comments (must start with //)
-    if (TokenText.StartsWith(TEXT("//")))
+
+    if (!CachedLine.bHighlighted)
     {
-        return true;
+        return CachedLine.Runs.Num() == 1 && CachedLine.Runs[0]->GetTextRange() == FTextRange(0, CachedLine.ModelString->Len());
     }
-    
-    // Multiline comment start (must start with /*)
-    if (TokenText.StartsWith(TEXT("/*")))
+
+    const TArray<ISyntaxTokenizer::FToken>& Tokens = CppTokenizer.GetLineTokens(LineIndex);
+    if (CachedLine.Runs.Num() != Tokens.Num())
     {
-        return true;
+        return false;
+    }
+
+    for (int32 TokenIndex = 0; TokenIndex < Tokens.Num(); ++TokenIndex)
+    {
+        if (CachedLine.Runs[TokenIndex]->GetTextRange() != Tokens[TokenIndex].Range)
+        {
+            return false;
+        }
     }
-    
-    // Multiline comment end (must end with */ and not be a string)
-    if (TokenText.EndsWith(TEXT("*/")) && !TokenText.StartsWith(TEXT("\"")))
+    return true;
+}
+
+void FCPPSyntaxHighlighterMarshaller::CreateHighlightedRuns(const FCppSyntaxTokenizer& CppTokenizer, int32 LineIndex, const TSharedRef<FString>& ModelString,
+    const TSharedRef<const FQCE_SyntaxStyleTable>& StyleTable, TArray<TSharedRef<IRun>>& OutRuns)
+{
+    const TArray<ISyntaxTokenizer::FToken>& Tokens = CppTokenizer.GetLineTokens(LineIndex);
+    const TArray<ECppTokenKind>& TokenKinds = CppTokenizer.GetLineTokenKinds(LineIndex);
+    check(TokenKinds.Num() == Tokens.Num());
+
+    // The tokenizer already classified every token, so each one just maps to its run name and shared style
+    OutRuns.Reserve(OutRuns.Num() + Tokens.Num());
+    for (int32 TokenIndex = 0; TokenIndex < Tokens.Num(); ++TokenIndex)
     {
-        return true;
+        const ECppTokenKind TokenKind = TokenKinds[TokenIndex];
+        FRunInfo RunInfo(TokenKindRunNames[static_cast<int32>(TokenKind)]);
+        OutRuns.Add(FQCE_TextRun::Create(RunInfo, ModelString, StyleTable, TokenKind, Tokens[TokenIndex].Range));
+    }
+}
+
+void FCPPSyntaxHighlighterMarshaller::SetVisibleLineRange(int32 FirstLine, int32 LastLine)
+{
+    VisibleFirstLine = FirstLine;
+    VisibleLastLine = FMath::Max(FirstLine, LastLine);
+    SchedulePendingLines();
+}
+
+void FCPPSyntaxHighlighterMarshaller::SchedulePendingLines()
+{
+    if (NumPendingLines == 0)
+    {
+        return;
     }
-    
-    // Check for middle lines of multiline comments
-    // These typically start with whitespace followed by * (but not inside strings)
-    if (!TokenText.StartsWith(TEXT("\"")) && !TokenText.StartsWith(TEXT("'")))
+
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const int32 MarginLines = Settings ? Settings->LazyHighlightMarginLines : 0;
+    HighlightPendingLines(VisibleFirstLine - MarginLines, VisibleLastLine + MarginLines);
+
+    if (NumPendingLines > 0 && !LazyHighlightTickerHandle.IsValid())
     {
-        FString TrimmedToken = TokenText.TrimStart();
-        if (TrimmedToken.StartsWith(TEXT("*")) && TrimmedToken.Len() > 1)
+        LazyHighlightTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCPPSyntaxHighlighterMarshaller::TickLazyHighlighting));
+    }
+}
+
+void FCPPSyntaxHighlighterMarshaller::HighlightPendingLines(int32 FirstLine, int32 LastLine)
+{
+    const TSharedPtr<FQCE_TextLayout> TextLayout = LazyHighlightLayout.Pin();
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    if (!TextLayout.IsValid() || !CppTokenizer.IsValid())
+    {
+        ClearPendingLines();
+        return;
+    }
+
+    FirstLine = FMath::Max(FirstLine, 0);
+    LastLine = FMath::Min(LastLine, PendingLines.Num() - 1);
+    for (int32 LineIndex = FirstLine; LineIndex <= LastLine && NumPendingLines > 0; ++LineIndex)
+    {
+        if (PendingLines[LineIndex] && !HighlightPendingLine(*CppTokenizer, *TextLayout, LineIndex))
         {
-            // Additional check: make sure this isn't a multiplication or pointer operation
-            TCHAR SecondChar = TrimmedToken.Len() > 1 ? TrimmedToken[1] : 0;
-            if (SecondChar == TEXT(' ') || SecondChar == TEXT('\t') || FChar::IsAlpha(SecondChar))
+            ClearPendingLines();
+            return;
+        }
+    }
+}
+
+bool FCPPSyntaxHighlighterMarshaller::HighlightPendingLine(const FCppSyntaxTokenizer& CppTokenizer, FQCE_TextLayout& TextLayout, int32 LineIndex)
+{
+    // The text can be edited between two highlight passes, in which case the next pass re-schedules everything
+    const TArray<FTextLayout::FLineModel>& LineModels = TextLayout.GetLineModels();
+    if (LineModels.Num() != CppTokenizer.GetNumLines() || !LineModels.IsValidIndex(LineIndex) ||
+        !LineModels[LineIndex].Text->Equals(CppTokenizer.GetLineText(LineIndex), ESearchCase::CaseSensitive))
+    {
+        return false;
+    }
+
+    TArray<TSharedRef<IRun>> Runs;
+    CreateHighlightedRuns(CppTokenizer, LineIndex, LineModels[LineIndex].Text, FQCE_SyntaxStyleTable::GetCurrent(), Runs);
+    TextLayout.ReplaceLineRuns(LineIndex, Runs);
+
+    if (CachedLineRuns.IsValidIndex(LineIndex))
+    {
+        FCachedLineRuns& CachedLine = CachedLineRuns[LineIndex];
+        CachedLine.ModelString = LineModels[LineIndex].Text;
+        CachedLine.Runs = MoveTemp(Runs);
+        CachedLine.bHighlighted = true;
+    }
+
+    PendingLines[LineIndex] = false;
+    NumPendingLines--;
+    return true;
+}
+
+bool FCPPSyntaxHighlighterMarshaller::TickLazyHighlighting(float DeltaTime)
+{
+    const TSharedPtr<FQCE_TextLayout> TextLayout = LazyHighlightLayout.Pin();
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    if (!TextLayout.IsValid() || !CppTokenizer.IsValid() || NumPendingLines == 0)
+    {
+        LazyHighlightTickerHandle.Reset();
+        ClearPendingLines();
+        return false;
+    }
+
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const double BudgetSeconds = (Settings ? Settings->LazyHighlightFrameBudgetMs : 2.0f) / 1000.0;
+    const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+    // Checking the clock per line would cost more than styling short lines, so it is checked in small batches
+    constexpr int32 LinesPerTimeCheck = 16;
+    int32 LinesSinceTimeCheck = 0;
+
+    while (NumPendingLines > 0)
+    {
+        if (PendingLines[NextPendingLine])
+        {
+            if (!HighlightPendingLine(*CppTokenizer, *TextLayout, NextPendingLine))
             {
-                return true;
+                LazyHighlightTickerHandle.Reset();
+                ClearPendingLines();
+                return false;
             }
+
+            if (++LinesSinceTimeCheck == LinesPerTimeCheck)
+            {
+                LinesSinceTimeCheck = 0;
+                if (FPlatformTime::Seconds() >= EndTime)
+                {
+                    break;
+                }
+            }
+        }
+
+        NextPendingLine = (NextPendingLine + 1) % PendingLines.Num();
+    }
+
+    if (NumPendingLines == 0)
+    {
+        LazyHighlightTickerHandle.Reset();
+        PendingLines.Empty();
+        return false;
+    }
+    return true;
+}
+
+void FCPPSyntaxHighlighterMarshaller::ClearPendingLines()
+{
+    if (LazyHighlightTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(LazyHighlightTickerHandle);
+        LazyHighlightTickerHandle.Reset();
+    }
+
+    PendingLines.Empty();
+    NumPendingLines = 0;
+    NextPendingLine = 0;
+}
+
+void FCPPSyntaxHighlighterMarshaller::StartBackgroundTokenization(const FString& SourceString)
+{
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    check(CppTokenizer.IsValid());
+
+    TSharedRef<FBackgroundTokenization, ESPMode::ThreadSafe> Job = MakeShared<FBackgroundTokenization, ESPMode::ThreadSafe>();
+    Job->DocumentVersion = DocumentVersion;
+    Job->Snapshot = SourceString;
+    BackgroundTokenization = Job;
+
+    // The job only touches its own snapshot and the tokenizer's immutable tables
+    Async(EAsyncExecution::TaskGraph, [Job, CppTokenizer]()
+    {
+        if (!Job->bCancelled)
+        {
+            CppTokenizer->LexDocument(Job->Snapshot, Job->LexedLines);
         }
+        Job->bFinished = true;
+    });
+
+    BackgroundTokenizationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCPPSyntaxHighlighterMarshaller::TickBackgroundTokenization));
+}
+
+void FCPPSyntaxHighlighterMarshaller::CancelBackgroundTokenization()
+{
+    if (BackgroundTokenization.IsValid())
+    {
+        BackgroundTokenization->bCancelled = true;
+        BackgroundTokenization.Reset();
+    }
+
+    if (BackgroundTokenizationTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(BackgroundTokenizationTickerHandle);
+        BackgroundTokenizationTickerHandle.Reset();
     }
-    
-    return false;
 }
 
-FCPPSyntaxHighlighterMarshaller::FSyntaxTextStyle FCPPSyntaxHighlighterMarshaller::GetSyntaxTextStyle()
+bool FCPPSyntaxHighlighterMarshaller::TickBackgroundTokenization(float DeltaTime)
 {
-    if (!bRefreshStyle && CurrentSyntaxStyle.bIsSet)
+    if (BackgroundTokenization.IsValid() && !BackgroundTokenization->bFinished)
     {
-        return CurrentSyntaxStyle;
+        return true;
     }
-    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
-    check(Settings);
 
-    // Create the base font style with user settings
-    FSlateFontInfo FontInfo = FCoreStyle::GetDefaultFontStyle(
-        TEXT("Mono"), 
-        Settings->FontSize
-    );
+    BackgroundTokenizationTickerHandle.Reset();
+    const TSharedPtr<FBackgroundTokenization, ESPMode::ThreadSafe> Job = MoveTemp(BackgroundTokenization);
+    const TSharedPtr<FCppSyntaxTokenizer> CppTokenizer = StaticCastSharedPtr<FCppSyntaxTokenizer>(Tokenizer);
+    if (!Job.IsValid() || Job->bCancelled || Job->DocumentVersion != DocumentVersion || !CppTokenizer.IsValid())
+    {
+        return false;
+    }
+
+    TBitArray<> ChangedLines;
+    CppTokenizer->ApplyLexedDocument(MoveTemp(Job->LexedLines), ChangedLines);
+
+    for (TConstSetBitIterator<> It(ChangedLines); It; ++It)
+    {
+        IdentifierIndex->UpdateLine(*CppTokenizer, It.GetIndex());
+
+        // The runs of the line were made from the placeholder tokens, it is re-styled below
+        if (CachedLineRuns.IsValidIndex(It.GetIndex()))
+        {
+            CachedLineRuns[It.GetIndex()] = FCachedLineRuns();
+        }
+    }
+
+    // Occurrences on lines that were placeholders until now can be highlighted
+    if (const TSharedPtr<FQCE_TextLayout> LazyLayout = LazyHighlightLayout.Pin())
+    {
+        LazyLayout->RefreshWordHighlights();
+    }
 
-    // Apply bold if enabled
-    if (Settings->bUseBoldFont)
+    // Lines whose tokens changed are re-styled in place, the visible ones first
+    if (PendingLines.Num() != ChangedLines.Num())
     {
-        FontInfo.TypefaceFontName = TEXT("Bold");
+        PendingLines.Init(false, ChangedLines.Num());
+        NumPendingLines = 0;
+        NextPendingLine = 0;
     }
 
-    CurrentSyntaxStyle = FSyntaxTextStyle(
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->TextColor), // Normal text
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->TextColor), // Operator text
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->KeywordColor), // Keywords
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->StringColor), // String text
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->NumberColor), // Number text
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->CommentColor), // Comment text
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->KeywordColor), // Preprocessor text - same as keywords
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->TypeColor), // Unreal typedefs
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->FunctionColor), // Function names
-            FTextBlockStyle()
-            .SetFont(FontInfo)
-            .SetColorAndOpacity(Settings->ClassColor) // Class names
-        );
-
-    CurrentSyntaxStyle.bIsSet = true;
-    bRefreshStyle = false;
-    return CurrentSyntaxStyle;
-        
+    for (TConstSetBitIterator<> It(ChangedLines); It; ++It)
+    {
+        if (!PendingLines[It.GetIndex()])
+        {
+            PendingLines[It.GetIndex()] = true;
+            NumPendingLines++;
+        }
+    }
+
+    SchedulePendingLines();
+    return false;
 }
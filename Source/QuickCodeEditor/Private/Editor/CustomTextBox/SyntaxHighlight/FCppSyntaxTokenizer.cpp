@@ -4,6 +4,7 @@
 
 #pragma region Definitions
 #include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextScan.h"
 
 // C++ Keywords
 const TCHAR* CPPKeywords[] =
@@ -388,6 +389,92 @@ const TCHAR* CPPUnrealTypedefs[] = {
 };
 #pragma endregion
 
+namespace
+{
+    /**
+     * Open-addressed hash table over CPPKeywords, CPPPreProcessorKeywords and CPPUnrealTypedefs.
+     * Built once, sized to stay at most a quarter full so lookups almost always resolve in a single probe.
+     */
+    class FCppIdentifierTable
+    {
+    public:
+        FCppIdentifierTable()
+        {
+            for (const auto& Keyword : CPPKeywords)
+            {
+                Add(Keyword, ECppIdentifierKind::Keyword);
+            }
+
+            for (const auto& PreProcessorKeyword : CPPPreProcessorKeywords)
+            {
+                Add(PreProcessorKeyword, ECppIdentifierKind::PreProcessorKeyword);
+            }
+
+            for (const auto& UnrealTypeDef : CPPUnrealTypedefs)
+            {
+                Add(UnrealTypeDef, ECppIdentifierKind::UnrealTypedef);
+            }
+        }
+
+        ECppIdentifierKind Find(const TCHAR* Text, const int32 Len) const
+        {
+            for (uint32 SlotIndex = Hash(Text, Len) & SlotMask; Slots[SlotIndex].Text != nullptr; SlotIndex = (SlotIndex + 1) & SlotMask)
+            {
+                const FSlot& Slot = Slots[SlotIndex];
+                if (Slot.Len == Len && FCString::Strncmp(Slot.Text, Text, Len) == 0)
+                {
+                    return Slot.Kind;
+                }
+            }
+            return ECppIdentifierKind::None;
+        }
+
+    private:
+        struct FSlot
+        {
+            const TCHAR* Text = nullptr;
+            int32 Len = 0;
+            ECppIdentifierKind Kind = ECppIdentifierKind::None;
+        };
+
+        static constexpr uint32 NumSlots = 1024;
+        static constexpr uint32 SlotMask = NumSlots - 1;
+
+        /** FNV-1a over the characters of the identifier */
+        static FORCEINLINE uint32 Hash(const TCHAR* Text, const int32 Len)
+        {
+            uint32 Result = 2166136261u;
+            for (int32 Index = 0; Index < Len; ++Index)
+            {
+                Result = (Result ^ static_cast<uint32>(Text[Index])) * 16777619u;
+            }
+            return Result;
+        }
+
+        void Add(const TCHAR* Text, const ECppIdentifierKind Kind)
+        {
+            const int32 Len = FCString::Strlen(Text);
+            uint32 SlotIndex = Hash(Text, Len) & SlotMask;
+            while (Slots[SlotIndex].Text != nullptr)
+            {
+                // Words listed in several tables (or twice in the same one) share a slot
+                if (Slots[SlotIndex].Len == Len && FCString::Strncmp(Slots[SlotIndex].Text, Text, Len) == 0)
+                {
+                    Slots[SlotIndex].Kind |= Kind;
+                    return;
+                }
+                SlotIndex = (SlotIndex + 1) & SlotMask;
+            }
+
+            Slots[SlotIndex].Text = Text;
+            Slots[SlotIndex].Len = Len;
+            Slots[SlotIndex].Kind = Kind;
+        }
+
+        FSlot Slots[NumSlots];
+    };
+}
+
 TSharedRef<FCppSyntaxTokenizer> FCppSyntaxTokenizer::Create()
 {
     return MakeShareable(new FCppSyntaxTokenizer());
@@ -398,37 +485,45 @@ FCppSyntaxTokenizer::FCppSyntaxTokenizer()
     // Initialize operators
     for (const auto& Operator : CPPOperators)
     {
-        Operators.Emplace(Operator);
-    }
-
-    // Initialize keywords
-    for (const auto& Keyword : CPPKeywords)
-    {
-        Keywords.Emplace(Keyword);
+        // Block comment delimiters are matched before operators, so they never need to be dispatched
+        const FString OperatorString(Operator);
+        if (OperatorString != TEXT("/*") && OperatorString != TEXT("*/") && OperatorString[0] < OperatorDispatchTableSize)
+        {
+            OperatorsByFirstChar[OperatorString[0]].Add(OperatorString);
+        }
     }
 
-    // Initialize preprocessor keywords
-    for (const auto& PreProcessorKeyword : CPPPreProcessorKeywords)
+    // Keep greedy matching independent of the declaration order
+    for (TArray<FString>& Bucket : OperatorsByFirstChar)
     {
-        Keywords.Emplace(PreProcessorKeyword);
+        Bucket.StableSort([](const FString& A, const FString& B)
+        {
+            return A.Len() > B.Len();
+        });
     }
+}
 
-    for (const auto& UnrealTypeDef : CPPUnrealTypedefs)
-    {
-        UnrealTypedefs.Emplace(UnrealTypeDef);
-    }
+ECppIdentifierKind FCppSyntaxTokenizer::ClassifyIdentifier(const TCHAR* Text, const int32 Len)
+{
+    static const FCppIdentifierTable IdentifierTable;
+    return Len > 0 ? IdentifierTable.Find(Text, Len) : ECppIdentifierKind::None;
 }
 
 void FCppSyntaxTokenizer::Process(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input)
 {
-    // Reset multiline comment state for new tokenization
-    bInMultilineComment = false;
-    
 #if UE_ENABLE_ICU
     TArray<FTextRange> LineRanges;
     FTextRange::CalculateLineRangesFromString(Input, LineRanges);
-    TokenizeLineRanges(Input, LineRanges, OutTokenizedLines);
+    TokenizeLineRanges(Input, LineRanges, OutTokenizedLines, false);
 #else
+    InvalidateLineCache();
+    LastDirtyLineRange.NumNewLines = 1;
+
+    FCachedLine& FakeCachedLine = CachedLines.AddDefaulted_GetRef();
+    FakeCachedLine.Text = Input;
+    FakeCachedLine.Tokens.Emplace(FToken(ETokenType::Literal, FTextRange(0, Input.Len())));
+    FakeCachedLine.TokenKinds.Add(ECppTokenKind::Normal);
+
     FTokenizedLine FakeTokenizedLine;
     FakeTokenizedLine.Range = FTextRange(0, Input.Len());
     FakeTokenizedLine.Tokens.Emplace(FToken(ETokenType::Literal, FakeTokenizedLine.Range));
@@ -436,305 +531,468 @@ void FCppSyntaxTokenizer::Process(TArray<FTokenizedLine>& OutTokenizedLines, con
 #endif
 }
 
-void FCppSyntaxTokenizer::TokenizeLineRanges(const FString& Input, const TArray<FTextRange>& LineRanges, TArray<FTokenizedLine>& OutTokenizedLines)
+void FCppSyntaxTokenizer::InvalidateLineCache()
+{
+    CachedLines.Reset();
+    LastDirtyLineRange = FDirtyLineRange();
+}
+
+void FCppSyntaxTokenizer::FindUnchangedLines(const FString& Input, const TArray<FTextRange>& LineRanges, int32& OutNumPrefixLines, int32& OutNumSuffixLines) const
+{
+    const int32 NumNewLines = LineRanges.Num();
+    const int32 NumOldLines = CachedLines.Num();
+
+    // Lines at the top and bottom of the document that kept their text since the last pass
+    OutNumPrefixLines = 0;
+    while (OutNumPrefixLines < NumNewLines && OutNumPrefixLines < NumOldLines &&
+        IsSameLineText(CachedLines[OutNumPrefixLines], Input, LineRanges[OutNumPrefixLines]))
+    {
+        OutNumPrefixLines++;
+    }
+
+    OutNumSuffixLines = 0;
+    while (OutNumSuffixLines < NumNewLines - OutNumPrefixLines && OutNumSuffixLines < NumOldLines - OutNumPrefixLines &&
+        IsSameLineText(CachedLines[NumOldLines - 1 - OutNumSuffixLines], Input, LineRanges[NumNewLines - 1 - OutNumSuffixLines]))
+    {
+        OutNumSuffixLines++;
+    }
+}
+
+int32 FCppSyntaxTokenizer::CountChangedLines(const FString& Input, const TArray<FTextRange>& LineRanges) const
 {
-    // Process each line with proper multiline comment state tracking
+    int32 NumPrefixLines = 0;
+    int32 NumSuffixLines = 0;
+    FindUnchangedLines(Input, LineRanges, NumPrefixLines, NumSuffixLines);
+    return LineRanges.Num() - NumPrefixLines - NumSuffixLines;
+}
+
+void FCppSyntaxTokenizer::ProcessDeferred(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input, const TArray<FTextRange>& LineRanges)
+{
+    TokenizeLineRanges(Input, LineRanges, OutTokenizedLines, true);
+}
+
+void FCppSyntaxTokenizer::LexDocument(const FString& Input, TArray<FCachedLine>& OutLines) const
+{
+    TArray<FTextRange> LineRanges;
+    FTextRange::CalculateLineRangesFromString(Input, LineRanges);
+
+    OutLines.Reset(LineRanges.Num());
+    bool bStartsInMultilineComment = false;
     for (const FTextRange& LineRange : LineRanges)
     {
-        FTokenizedLine TokenizedLine;
+        FCachedLine& CachedLine = OutLines.AddDefaulted_GetRef();
+        LexLineIntoCache(Input, LineRange, bStartsInMultilineComment, CachedLine);
+        bStartsInMultilineComment = CachedLine.bEndsInMultilineComment;
+    }
+}
+
+void FCppSyntaxTokenizer::ApplyLexedDocument(TArray<FCachedLine>&& LexedLines, TBitArray<>& OutChangedLines)
+{
+    OutChangedLines.Init(true, LexedLines.Num());
+    for (int32 LineIndex = 0; LineIndex < LexedLines.Num() && LineIndex < CachedLines.Num(); ++LineIndex)
+    {
+        const FCachedLine& OldLine = CachedLines[LineIndex];
+        const FCachedLine& NewLine = LexedLines[LineIndex];
+        if (OldLine.bIsPlaceholder || OldLine.TokenKinds != NewLine.TokenKinds || OldLine.Tokens.Num() != NewLine.Tokens.Num())
+        {
+            continue;
+        }
+
+        bool bSameTokens = true;
+        for (int32 TokenIndex = 0; TokenIndex < NewLine.Tokens.Num() && bSameTokens; ++TokenIndex)
+        {
+            bSameTokens = OldLine.Tokens[TokenIndex].Type == NewLine.Tokens[TokenIndex].Type &&
+                OldLine.Tokens[TokenIndex].Range == NewLine.Tokens[TokenIndex].Range;
+        }
+        OutChangedLines[LineIndex] = !bSameTokens;
+    }
+
+    CachedLines = MoveTemp(LexedLines);
+    LastDirtyLineRange = FDirtyLineRange();
+    LastDirtyLineRange.NumNewLines = CachedLines.Num();
+    LastDirtyLineRange.NumOldLines = CachedLines.Num();
+}
+
+void FCppSyntaxTokenizer::TokenizeLineRanges(const FString& Input, const TArray<FTextRange>& LineRanges, TArray<FTokenizedLine>& OutTokenizedLines, const bool bDeferChangedLines)
+{
+    const int32 NumNewLines = LineRanges.Num();
+    const int32 NumOldLines = CachedLines.Num();
+
+    int32 NumPrefixLines = 0;
+    int32 NumSuffixLines = 0;
+    FindUnchangedLines(Input, LineRanges, NumPrefixLines, NumSuffixLines);
+
+    TArray<FCachedLine> NewCachedLines;
+    NewCachedLines.Reserve(NumNewLines);
+
+    for (int32 LineIndex = 0; LineIndex < NumPrefixLines; ++LineIndex)
+    {
+        NewCachedLines.Add(MoveTemp(CachedLines[LineIndex]));
+    }
+
+    bool bStartsInMultilineComment = NumPrefixLines > 0 && NewCachedLines.Last().bEndsInMultilineComment;
+
+    // Re-lex the edited lines, or stand in for them until a full pass is applied
+    const int32 FirstSuffixLine = NumNewLines - NumSuffixLines;
+    for (int32 LineIndex = NumPrefixLines; LineIndex < FirstSuffixLine; ++LineIndex)
+    {
+        FCachedLine& CachedLine = NewCachedLines.AddDefaulted_GetRef();
+        if (bDeferChangedLines)
+        {
+            MakePlaceholderLine(Input, LineRanges[LineIndex], bStartsInMultilineComment, CachedLine);
+        }
+        else
+        {
+            LexLineIntoCache(Input, LineRanges[LineIndex], bStartsInMultilineComment, CachedLine);
+        }
+        bStartsInMultilineComment = CachedLine.bEndsInMultilineComment;
+    }
+
+    // Unchanged lines after the edit are only re-lexed while their start state differs from the cached one,
+    // e.g. when the edit opened or closed a block comment. A deferred pass keeps them as they are until the full pass lands.
+    int32 DirtyEndLine = FirstSuffixLine;
+    const int32 OldLineOffset = NumOldLines - NumNewLines;
+    for (int32 LineIndex = FirstSuffixLine; LineIndex < NumNewLines; ++LineIndex)
+    {
+        FCachedLine& OldCachedLine = CachedLines[LineIndex + OldLineOffset];
+        if (bDeferChangedLines || OldCachedLine.bStartsInMultilineComment == bStartsInMultilineComment)
+        {
+            NewCachedLines.Add(MoveTemp(OldCachedLine));
+        }
+        else
+        {
+            FCachedLine& CachedLine = NewCachedLines.AddDefaulted_GetRef();
+            LexLineIntoCache(Input, LineRanges[LineIndex], bStartsInMultilineComment, CachedLine);
+            DirtyEndLine = LineIndex + 1;
+        }
+        bStartsInMultilineComment = NewCachedLines.Last().bEndsInMultilineComment;
+    }
+
+    CachedLines = MoveTemp(NewCachedLines);
+
+    LastDirtyLineRange.FirstLine = NumPrefixLines;
+    LastDirtyLineRange.NumNewLines = DirtyEndLine - NumPrefixLines;
+    LastDirtyLineRange.NumOldLines = DirtyEndLine - NumPrefixLines + OldLineOffset;
+
+    // Rebase the cached line-relative tokens onto the current input
+    OutTokenizedLines.Reserve(OutTokenizedLines.Num() + NumNewLines);
+    for (int32 LineIndex = 0; LineIndex < NumNewLines; ++LineIndex)
+    {
+        const FTextRange& LineRange = LineRanges[LineIndex];
+        FTokenizedLine& TokenizedLine = OutTokenizedLines.AddDefaulted_GetRef();
         TokenizedLine.Range = LineRange;
+        TokenizedLine.Tokens.Reserve(CachedLines[LineIndex].Tokens.Num());
+
+        for (const FToken& Token : CachedLines[LineIndex].Tokens)
+        {
+            TokenizedLine.Tokens.Emplace(FToken(Token.Type, FTextRange(Token.Range.BeginIndex + LineRange.BeginIndex, Token.Range.EndIndex + LineRange.BeginIndex)));
+        }
+    }
+}
+
+void FCppSyntaxTokenizer::LexLineIntoCache(const FString& Input, const FTextRange& LineRange, bool bStartsInMultilineComment, FCachedLine& OutCachedLine) const
+{
+    FLexerState LexerState;
+    LexerState.bInMultilineComment = bStartsInMultilineComment;
+
+    FTokenizedLine TokenizedLine;
+    OutCachedLine.TokenKinds.Reset();
+    TokenizeLine(Input, LineRange, LexerState, TokenizedLine, OutCachedLine.TokenKinds);
+
+    OutCachedLine.Text = Input.Mid(LineRange.BeginIndex, LineRange.Len());
+    OutCachedLine.bStartsInMultilineComment = bStartsInMultilineComment;
+    OutCachedLine.bEndsInMultilineComment = LexerState.bInMultilineComment;
+    OutCachedLine.bIsPlaceholder = false;
+    OutCachedLine.Tokens.Reset(TokenizedLine.Tokens.Num());
+    for (const FToken& Token : TokenizedLine.Tokens)
+    {
+        OutCachedLine.Tokens.Emplace(FToken(Token.Type, FTextRange(Token.Range.BeginIndex - LineRange.BeginIndex, Token.Range.EndIndex - LineRange.BeginIndex)));
+    }
+}
+
+void FCppSyntaxTokenizer::MakePlaceholderLine(const FString& Input, const FTextRange& LineRange, bool bStartsInMultilineComment, FCachedLine& OutCachedLine)
+{
+    OutCachedLine.Text = Input.Mid(LineRange.BeginIndex, LineRange.Len());
+    OutCachedLine.Tokens.Reset(1);
+    OutCachedLine.Tokens.Emplace(FToken(ETokenType::Literal, FTextRange(0, LineRange.Len())));
+    OutCachedLine.TokenKinds.Reset(1);
+    OutCachedLine.TokenKinds.Add(ECppTokenKind::Normal);
+    OutCachedLine.bStartsInMultilineComment = bStartsInMultilineComment;
+    OutCachedLine.bEndsInMultilineComment = bStartsInMultilineComment;
+    OutCachedLine.bIsPlaceholder = true;
+}
 
-        if (TokenizedLine.Range.IsEmpty())
+bool FCppSyntaxTokenizer::IsSameLineText(const FCachedLine& CachedLine, const FString& Input, const FTextRange& LineRange)
+{
+    // Placeholders were never lexed, so they must not be reused even when the text matches
+    return !CachedLine.bIsPlaceholder && CachedLine.Text.Len() == LineRange.Len() &&
+        FCString::Strncmp(*CachedLine.Text, *Input + LineRange.BeginIndex, LineRange.Len()) == 0;
+}
+
+void FCppSyntaxTokenizer::TokenizeLine(const FString& Input, const FTextRange& LineRange, FLexerState& LexerState, FTokenizedLine& TokenizedLine, TArray<ECppTokenKind>& TokenKinds) const
+{
+    TokenizedLine.Range = LineRange;
+
+    if (TokenizedLine.Range.IsEmpty())
+    {
+        TokenizedLine.Tokens.Emplace(FToken(ETokenType::Literal, TokenizedLine.Range));
+        TokenKinds.Add(ECppTokenKind::Normal);
+        return;
+    }
+
+    int32 CurrentOffset = LineRange.BeginIndex;
+
+    // If we're already in a multiline comment, handle it first
+    if (LexerState.bInMultilineComment)
+    {
+        // Look for the end of the multiline comment on this line
+        const int32 CommentEnd = FQCE_TextScan::FindBlockCommentEnd(*Input, CurrentOffset, LineRange.EndIndex);
+        
+        if (CommentEnd != INDEX_NONE)
+        {
+            // End of multiline comment found on this line
+            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, CommentEnd)));
+            TokenKinds.Add(ECppTokenKind::Comment);
+            CurrentOffset = CommentEnd;
+            LexerState.bInMultilineComment = false;
+        }
+        else
+        {
+            // Entire line is part of the multiline comment
+            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, LineRange.EndIndex)));
+            TokenKinds.Add(ECppTokenKind::Comment);
+            CurrentOffset = LineRange.EndIndex;
+        }
+    }
+
+    while (CurrentOffset < LineRange.EndIndex)
+    {
+        const TCHAR* CurrentString = &Input[CurrentOffset];
+        const TCHAR CurrentChar = Input[CurrentOffset];
+
+        bool bHasMatchedSyntax = false;
+
+        // Handle string literals first (highest priority)
+        if (CurrentChar == TEXT('\"'))
         {
-            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Literal, TokenizedLine.Range));
-            OutTokenizedLines.Add(TokenizedLine);
+            // Find the closing quote, handling escaped quotes
+            const int32 StringEnd = FQCE_TextScan::FindQuotedEnd(*Input, CurrentOffset + 1, LineRange.EndIndex, TEXT('\"'));
+
+            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, StringEnd)));
+            TokenKinds.Add(ECppTokenKind::String);
+            CurrentOffset = StringEnd;
+            bHasMatchedSyntax = true;
             continue;
         }
 
-        int32 CurrentOffset = LineRange.BeginIndex;
+        // Handle character literals
+        if (CurrentChar == TEXT('\''))
+        {
+            // Find the closing quote, handling escaped quotes
+            const int32 CharEnd = FQCE_TextScan::FindQuotedEnd(*Input, CurrentOffset + 1, LineRange.EndIndex, TEXT('\''));
+
+            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, CharEnd)));
+            TokenKinds.Add(ECppTokenKind::String);
+            CurrentOffset = CharEnd;
+            bHasMatchedSyntax = true;
+            continue;
+        }
 
-        // If we're already in a multiline comment, handle it first
-        if (bInMultilineComment)
+        // Check for multiline comment start
+        if (!LexerState.bInMultilineComment && CurrentOffset < LineRange.EndIndex - 1 && 
+            CurrentChar == TEXT('/') && Input[CurrentOffset + 1] == TEXT('*'))
         {
-            // Look for the end of the multiline comment on this line
-            int32 CommentEnd = CurrentOffset;
-            bool bFoundEnd = false;
+            // Start of multiline comment
+            const int32 CommentStart = CurrentOffset;
             
-            // Search for */ in the current line
-            while (CommentEnd < LineRange.EndIndex - 1)
-            {
-                if (Input[CommentEnd] == TEXT('*') && Input[CommentEnd + 1] == TEXT('/'))
-                {
-                    CommentEnd += 2; // Include the */
-                    bFoundEnd = true;
-                    break;
-                }
-                CommentEnd++;
-            }
+            // Look for the end of the multiline comment on the same line, after the initial /*
+            const int32 CommentEnd = FQCE_TextScan::FindBlockCommentEnd(*Input, CurrentOffset + 2, LineRange.EndIndex);
             
-            if (bFoundEnd)
+            if (CommentEnd != INDEX_NONE)
             {
-                // End of multiline comment found on this line
-                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, CommentEnd)));
+                // Complete multiline comment found on this line (e.g., /* comment */)
+                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CommentStart, CommentEnd)));
+                TokenKinds.Add(ECppTokenKind::Comment);
                 CurrentOffset = CommentEnd;
-                bInMultilineComment = false;
             }
             else
             {
-                // Entire line is part of the multiline comment
-                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, LineRange.EndIndex)));
+                // Multiline comment continues beyond this line
+                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CommentStart, LineRange.EndIndex)));
+                TokenKinds.Add(ECppTokenKind::Comment);
+                LexerState.bInMultilineComment = true;
                 CurrentOffset = LineRange.EndIndex;
             }
+            bHasMatchedSyntax = true;
+            continue;
         }
 
-        while (CurrentOffset < LineRange.EndIndex)
+        // Greedy matching for operators (longest first)
+        const int32 OperatorLength = MatchOperator(CurrentString, LineRange.EndIndex - CurrentOffset);
+        if (OperatorLength > 0)
         {
-            const TCHAR* CurrentString = &Input[CurrentOffset];
-            const TCHAR CurrentChar = Input[CurrentOffset];
-
-            bool bHasMatchedSyntax = false;
-
-            // Handle string literals first (highest priority)
-            if (CurrentChar == TEXT('\"'))
-            {
-                int32 StringEnd = CurrentOffset + 1;
-                bool bEscaped = false;
+            // Single-line comments - consume rest of line
+            const bool bIsLineComment = OperatorLength == 2 && CurrentChar == TEXT('/') && CurrentString[1] == TEXT('/');
+            const int32 SyntaxTokenEnd = bIsLineComment ? LineRange.EndIndex : CurrentOffset + OperatorLength;
+            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, SyntaxTokenEnd)));
+            TokenKinds.Add(bIsLineComment ? ECppTokenKind::Comment : ECppTokenKind::Operator);
+            CurrentOffset = SyntaxTokenEnd;
+
+            check(CurrentOffset <= LineRange.EndIndex);
+            bHasMatchedSyntax = true;
+        }
 
-                // Find the closing quote, handling escaped quotes
-                while (StringEnd < LineRange.EndIndex)
-                {
-                    const TCHAR StringChar = Input[StringEnd];
-                    
-                    if (StringChar == TEXT('\\'))
-                    {
-                        bEscaped = !bEscaped;
-                    }
-                    else if (StringChar == TEXT('\"') && !bEscaped)
-                    {
-                        // Found unescaped closing quote
-                        StringEnd++;
-                        break;
-                    }
-                    else
-                    {
-                        bEscaped = false;
-                    }
-                    
-                    StringEnd++;
-                }
+        if (bHasMatchedSyntax)
+        {
+            continue;
+        }
 
-                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, StringEnd)));
-                CurrentOffset = StringEnd;
-                bHasMatchedSyntax = true;
-                continue;
-            }
+        // Handle identifiers and keywords
+        int32 PeekOffset = CurrentOffset + 1;
+        if (CurrentChar == TEXT('#'))
+        {
+            // Match PreProcessorKeywords - they contain letters
+            PeekOffset = FQCE_TextScan::SkipAlphaChars(*Input, PeekOffset, LineRange.EndIndex);
+        }
+        else if (IsAlpha(CurrentChar) || CurrentChar == TEXT('_'))
+        {
+            // Match identifiers - start with letter or underscore, contain letters, numbers, or underscores
+            PeekOffset = FQCE_TextScan::SkipIdentifierChars(*Input, PeekOffset, LineRange.EndIndex);
+        }
+        else if (IsDigit(CurrentChar))
+        {
+            // Handle numeric literals (digits, '.', exponent signs and suffix letters)
+            PeekOffset = FQCE_TextScan::SkipNumberChars(*Input, PeekOffset, LineRange.EndIndex);
+        }
 
-            // Handle character literals
-            if (CurrentChar == TEXT('\''))
-            {
-                int32 CharEnd = CurrentOffset + 1;
-                bool bEscaped = false;
+        const int32 CurrentStringLength = PeekOffset - CurrentOffset;
 
-                // Find the closing quote, handling escaped quotes
-                while (CharEnd < LineRange.EndIndex)
-                {
-                    const TCHAR StringChar = Input[CharEnd];
-                    
-                    if (StringChar == TEXT('\\'))
-                    {
-                        bEscaped = !bEscaped;
-                    }
-                    else if (StringChar == TEXT('\'') && !bEscaped)
-                    {
-                        // Found unescaped closing quote
-                        CharEnd++;
-                        break;
-                    }
-                    else
-                    {
-                        bEscaped = false;
-                    }
-                    
-                    CharEnd++;
-                }
-
-                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, CharEnd)));
-                CurrentOffset = CharEnd;
-                bHasMatchedSyntax = true;
-                continue;
-            }
+        const ECppIdentifierKind IdentifierKind = ClassifyIdentifier(CurrentString, CurrentStringLength);
 
-            // Check for multiline comment start
-            if (!bInMultilineComment && CurrentOffset < LineRange.EndIndex - 1 && 
-                CurrentChar == TEXT('/') && Input[CurrentOffset + 1] == TEXT('*'))
+        // Check if it is a reserved keyword
+        if (EnumHasAnyFlags(IdentifierKind, ECppIdentifierKind::Keyword | ECppIdentifierKind::PreProcessorKeyword))
+        {
+            // Verify word boundary - ensure we're not matching partial words
+            const int32 SyntaxTokenEnd = CurrentOffset + CurrentStringLength;
+            if (SyntaxTokenEnd >= LineRange.EndIndex || !IsIdentifierChar(Input[SyntaxTokenEnd]))
             {
-                // Start of multiline comment
-                int32 CommentStart = CurrentOffset;
-                CurrentOffset += 2; // Skip the initial /*
-                
-                // Look for the end of the multiline comment on the same line
-                bool bFoundEnd = false;
-                while (CurrentOffset < LineRange.EndIndex - 1)
+                TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, SyntaxTokenEnd)));
+                if (CurrentChar == TEXT('#'))
                 {
-                    if (Input[CurrentOffset] == TEXT('*') && Input[CurrentOffset + 1] == TEXT('/'))
-                    {
-                        CurrentOffset += 2; // Include the */
-                        bFoundEnd = true;
-                        break;
-                    }
-                    CurrentOffset++;
+                    TokenKinds.Add(ECppTokenKind::PreProcessorKeyword);
                 }
-                
-                if (bFoundEnd)
+                else if (EnumHasAnyFlags(IdentifierKind, ECppIdentifierKind::UnrealTypedef))
                 {
-                    // Complete multiline comment found on this line (e.g., /* comment */)
-                    TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CommentStart, CurrentOffset)));
+                    TokenKinds.Add(ECppTokenKind::UnrealTypedef);
                 }
                 else
                 {
-                    // Multiline comment continues beyond this line
-                    TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CommentStart, LineRange.EndIndex)));
-                    bInMultilineComment = true;
-                    CurrentOffset = LineRange.EndIndex;
+                    TokenKinds.Add(ECppTokenKind::Keyword);
                 }
+
+                check(SyntaxTokenEnd <= LineRange.EndIndex);
+
                 bHasMatchedSyntax = true;
-                continue;
+                CurrentOffset = SyntaxTokenEnd;
             }
+        }
 
-            // Greedy matching for operators (ordered by length - longest first)
-            for (const FString& Operator : Operators)
-            {
-                if (FCString::Strncmp(CurrentString, *Operator, Operator.Len()) == 0)
-                {
-                    // Single-line comments - consume rest of line
-                    if (Operator == TEXT("//"))
-                    {
-                        const int32 SyntaxTokenEnd = LineRange.EndIndex;
-                        TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, SyntaxTokenEnd)));
-                        CurrentOffset = SyntaxTokenEnd;
-                    }
-                    // Skip multiline comment operators as they're handled above
-                    else if (Operator != TEXT("/*") && Operator != TEXT("*/"))
-                    {
-                        const int32 SyntaxTokenEnd = CurrentOffset + Operator.Len();
-                        TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, SyntaxTokenEnd)));
-                        CurrentOffset = SyntaxTokenEnd;
-                    }
-                    else
-                    {
-                        // Skip /* and */ operators when not in multiline comment context
-                        continue;
-                    }
-
-                    check(CurrentOffset <= LineRange.EndIndex);
-                    bHasMatchedSyntax = true;
-                    break;
-                }
-            }
+        if (bHasMatchedSyntax)
+        {
+            continue;
+        }
 
-            if (bHasMatchedSyntax)
-            {
-                continue;
-            }
+        // If none matched, consume the character(s) as literal text
+        // Use at least 1 character to prevent infinite loops
+        const int32 TextTokenEnd = CurrentOffset + FMath::Max(1, CurrentStringLength);
+        TokenizedLine.Tokens.Emplace(FToken(ETokenType::Literal, FTextRange(CurrentOffset, TextTokenEnd)));
+        if (EnumHasAnyFlags(IdentifierKind, ECppIdentifierKind::UnrealTypedef))
+        {
+            TokenKinds.Add(ECppTokenKind::UnrealTypedef);
+        }
+        else if (IsDigit(CurrentChar))
+        {
+            TokenKinds.Add(ECppTokenKind::Number);
+        }
+        else
+        {
+            TokenKinds.Add(ECppTokenKind::Normal);
+        }
+        CurrentOffset = TextTokenEnd;
+    }
 
-            // Handle identifiers and keywords
-            int32 PeekOffset = CurrentOffset + 1;
-            if (CurrentChar == TEXT('#'))
-            {
-                // Match PreProcessorKeywords - they contain letters
-                while (PeekOffset < LineRange.EndIndex)
-                {
-                    const TCHAR PeekChar = Input[PeekOffset];
-                    if (!IsAlpha(PeekChar))
-                    {
-                        break;
-                    }
-                    PeekOffset++;
-                }
-            }
-            else if (IsAlpha(CurrentChar) || CurrentChar == TEXT('_'))
-            {
-                // Match identifiers - start with letter or underscore, contain letters, numbers, or underscores
-                while (PeekOffset < LineRange.EndIndex)
-                {
-                    const TCHAR PeekChar = Input[PeekOffset];
-                    if (!IsIdentifierChar(PeekChar))
-                    {
-                        break;
-                    }
-                    PeekOffset++;
-                }
-            }
-            else if (IsDigit(CurrentChar))
-            {
-                // Handle numeric literals
-                while (PeekOffset < LineRange.EndIndex)
-                {
-                    const TCHAR PeekChar = Input[PeekOffset];
-                    if (!IsDigit(PeekChar) && PeekChar != TEXT('.') && PeekChar != TEXT('f') && 
-                        PeekChar != TEXT('F') && PeekChar != TEXT('u') && PeekChar != TEXT('U') &&
-                        PeekChar != TEXT('l') && PeekChar != TEXT('L') && PeekChar != TEXT('x') &&
-                        PeekChar != TEXT('X') && PeekChar != TEXT('e') && PeekChar != TEXT('E') &&
-                        PeekChar != TEXT('+') && PeekChar != TEXT('-'))
-                    {
-                        break;
-                    }
-                    PeekOffset++;
-                }
-            }
+    ResolveIdentifierKinds(Input, TokenizedLine, TokenKinds);
+}
 
-            const int32 CurrentStringLength = PeekOffset - CurrentOffset;
+void FCppSyntaxTokenizer::ResolveIdentifierKinds(const FString& Input, const FTokenizedLine& TokenizedLine, TArray<ECppTokenKind>& TokenKinds)
+{
+    const FStringView InputView(Input);
 
-            if (CurrentStringLength > 0)
-            {
-                // Check if it is a reserved keyword - FIXED COMPARISON LOGIC
-                for (const FString& Keyword : Keywords)
-                {
-                    // Proper keyword matching: 
-                    // 1. The lengths must match exactly
-                    // 2. The content must match exactly
-                    // 3. Ensure word boundary (next char is not alphanumeric/underscore)
-                    if (Keyword.Len() == CurrentStringLength && 
-                        FCString::Strncmp(CurrentString, *Keyword, Keyword.Len()) == 0)
-                    {
-                        // Verify word boundary - ensure we're not matching partial words
-                        bool bIsWordBoundary = true;
-                        if (CurrentOffset + Keyword.Len() < LineRange.EndIndex)
-                        {
-                            const TCHAR NextChar = Input[CurrentOffset + Keyword.Len()];
-                            if (IsIdentifierChar(NextChar))
-                            {
-                                bIsWordBoundary = false;
-                            }
-                        }
-
-                        if (bIsWordBoundary)
-                        {
-                            const int32 SyntaxTokenEnd = CurrentOffset + Keyword.Len();
-                            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Syntax, FTextRange(CurrentOffset, SyntaxTokenEnd)));
-
-                            check(SyntaxTokenEnd <= LineRange.EndIndex);
-
-                            bHasMatchedSyntax = true;
-                            CurrentOffset = SyntaxTokenEnd;
-                            break;
-                        }
-                    }
-                }
-            }
+    for (int32 TokenIndex = 0; TokenIndex < TokenizedLine.Tokens.Num(); ++TokenIndex)
+    {
+        const FToken& Token = TokenizedLine.Tokens[TokenIndex];
+        if (TokenKinds[TokenIndex] != ECppTokenKind::Normal || Token.Type != ETokenType::Literal || !FChar::IsAlpha(Input[Token.Range.BeginIndex]))
+        {
+            continue;
+        }
 
-            if (bHasMatchedSyntax)
-            {
-                continue;
-            }
+        // Tokens are contiguous, so the next two tokens are a single slice of the input
+        const int32 LastLookAheadIndex = FMath::Min(TokenIndex + 2, TokenizedLine.Tokens.Num() - 1);
+        if (LastLookAheadIndex == TokenIndex)
+        {
+            continue;
+        }
+
+        const int32 NextTokensBegin = TokenizedLine.Tokens[TokenIndex + 1].Range.BeginIndex;
+        const FStringView NextTokens = InputView.Mid(NextTokensBegin, TokenizedLine.Tokens[LastLookAheadIndex].Range.EndIndex - NextTokensBegin);
 
-            // If none matched, consume the character(s) as literal text
-            // Use at least 1 character to prevent infinite loops
-            const int32 TextTokenEnd = CurrentOffset + FMath::Max(1, CurrentStringLength);
-            TokenizedLine.Tokens.Emplace(FToken(ETokenType::Literal, FTextRange(CurrentOffset, TextTokenEnd)));
-            CurrentOffset = TextTokenEnd;
+        int32 OpenParenIndex = INDEX_NONE;
+
+        // Followed by :: is a class name
+        if (NextTokens.StartsWith(TEXT("::")))
+        {
+            TokenKinds[TokenIndex] = ECppTokenKind::Class;
         }
+        // Followed by ( is a function name
+        else if (NextTokens.FindChar(TEXT('('), OpenParenIndex) && !NextTokens.StartsWith(TEXT(" class")) && !NextTokens.StartsWith(TEXT(" struct")))
+        {
+            TokenKinds[TokenIndex] = ECppTokenKind::Function;
+        }
+    }
+}
 
-        OutTokenizedLines.Add(TokenizedLine);
+int32 FCppSyntaxTokenizer::MatchOperator(const TCHAR* String, int32 MaxLength) const
+{
+    const TCHAR FirstChar = String[0];
+    if (FirstChar >= OperatorDispatchTableSize)
+    {
+        return 0;
     }
-}
\ No newline at end of file
+
+    for (const FString& Operator : OperatorsByFirstChar[FirstChar])
+    {
+        if (Operator.Len() <= MaxLength && FCString::Strncmp(String, *Operator, Operator.Len()) == 0)
+        {
+            return Operator.Len();
+        }
+    }
+
+    return 0;
+}
+
+int32 FCppSyntaxTokenizer::MatchOperatorLinear(const TCHAR* String, int32 MaxLength) const
+{
+    // The buckets are longest first, so the first match is the one MatchOperator finds
+    for (const TArray<FString>& Bucket : OperatorsByFirstChar)
+    {
+        for (const FString& Operator : Bucket)
+        {
+            if (Operator.Len() <= MaxLength && FCString::Strncmp(String, *Operator, Operator.Len()) == 0)
+            {
+                return Operator.Len();
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,544 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_HighlighterBenchmark.h"
+
+#include "QuickCodeEditor.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/CPPSyntaxHighlighterMarshaller.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextScan.h"
+#include "Framework/Text/SlateTextRun.h"
+#include "Framework/Text/TextLayout.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/** Minimum number of full passes per measurement, more are run on small documents to smooth out the timings */
+	constexpr int32 MinPasses = 2;
+
+	/** Total number of lines to process per measurement on small documents */
+	constexpr int32 TargetLinesPerMeasurement = 200000;
+
+	/**
+	 * Reads the Malloc and Realloc call counters that FMalloc keeps for the memory stats.
+	 * Those are only compiled in with STATS, and only counted by allocators that implement them.
+	 */
+	class FMallocCallCounters : public FMalloc
+	{
+	public:
+		/** Total number of allocations made so far by every thread, INDEX_NONE without STATS */
+		static int64 GetNumAllocations()
+		{
+#if STATS
+			return static_cast<int64>(TotalMallocCalls) + static_cast<int64>(TotalReallocCalls);
+#else
+			return INDEX_NONE;
+#endif
+		}
+	};
+
+	/**
+	 * Counts the allocations made during its lifetime, by every thread, without touching the allocator.
+	 * Reports INDEX_NONE when the counters are not available.
+	 */
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter()
+			: StartCount(FMallocCallCounters::GetNumAllocations())
+		{
+		}
+
+		int64 GetNumAllocations() const
+		{
+			return StartCount != INDEX_NONE ? FMallocCallCounters::GetNumAllocations() - StartCount : INDEX_NONE;
+		}
+
+	private:
+		int64 StartCount = INDEX_NONE;
+	};
+
+	/** Bare text layout for laying out the highlighted runs without any widget */
+	class FBenchmarkTextLayout : public FTextLayout
+	{
+	public:
+		static TSharedRef<FBenchmarkTextLayout> Create()
+		{
+			return MakeShareable(new FBenchmarkTextLayout());
+		}
+
+	protected:
+		virtual TSharedRef<IRun> CreateDefaultTextRun(const TSharedRef<FString>& NewText, const FTextRange& NewRange) const override
+		{
+			return FSlateTextRun::Create(FRunInfo(), NewText, FTextBlockStyle::GetDefault(), NewRange);
+		}
+	};
+
+	const TCHAR* HeaderPreamble =
+		TEXT("// Copyright Epic Games, Inc. All Rights Reserved.\n")
+		TEXT("\n")
+		TEXT("#pragma once\n")
+		TEXT("\n")
+		TEXT("#include \"CoreMinimal.h\"\n")
+		TEXT("#include \"Kismet/BlueprintFunctionLibrary.h\"\n")
+		TEXT("#include \"QCE_BenchmarkLibrary.generated.h\"\n")
+		TEXT("\n")
+		TEXT("/**\n")
+		TEXT(" * Synthetic library used to benchmark the syntax highlighter.\n")
+		TEXT(" */\n")
+		TEXT("UCLASS(BlueprintType, Blueprintable, meta = (DisplayName = \"QCE Benchmark Library\"))\n")
+		TEXT("class QUICKCODEEDITOR_API UQCE_BenchmarkLibrary : public UBlueprintFunctionLibrary\n")
+		TEXT("{\n")
+		TEXT("\tGENERATED_BODY()\n")
+		TEXT("\n")
+		TEXT("public:");
+
+	const TCHAR* HeaderBlock =
+		TEXT("\t/**\n")
+		TEXT("\t * Processes the value for entry {N} and reports whether it could be applied to the \"current\" selection.\n")
+		TEXT("\t * Long doc comments like this one mention operators such as ->, :: and <<= as well as paths like C:\\Temp\\{N}.txt,\n")
+		TEXT("\t * so the comment scanner has to skip plenty of characters that would otherwise start a token.\n")
+		TEXT("\t * @param InValue   The value to process\n")
+		TEXT("\t * @param InCount   How many times to apply it\n")
+		TEXT("\t * @return True if the value was applied\n")
+		TEXT("\t */\n")
+		TEXT("\tUFUNCTION(BlueprintCallable, BlueprintPure, Category = \"QuickCodeEditor|Benchmark|Group{N}\", meta = (DisplayName = \"Process Value {N}\", Keywords = \"benchmark syntax highlight tokenizer\", AdvancedDisplay = \"InOptions\", ToolTip = \"A deliberately long tooltip string for entry {N} that keeps going so the string scanner has real work to do\"))\n")
+		TEXT("\tstatic bool ProcessValue{N}(const FString& InValue, int32 InCount, float InScale = 1.0f, const TArray<FName>& InOptions = TArray<FName>());\n")
+		TEXT("\n")
+		TEXT("\tUPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Benchmark\", meta = (ClampMin = \"0\", ClampMax = \"100\", UIMin = \"0\", UIMax = \"100\", EditCondition = \"bEnabled{N}\"))\n")
+		TEXT("\tint32 Property{N} = {N}; // Trailing comment for property {N}\n")
+		TEXT("\n")
+		TEXT("\tUPROPERTY(EditAnywhere, Category = \"Benchmark\")\n")
+		TEXT("\tbool bEnabled{N} = true;");
+
+	const TCHAR* SourcePreamble =
+		TEXT("// Copyright Epic Games, Inc. All Rights Reserved.\n")
+		TEXT("\n")
+		TEXT("#include \"QCE_BenchmarkLibrary.h\"\n")
+		TEXT("\n")
+		TEXT("#include \"Misc/Paths.h\"\n")
+		TEXT("#include \"Misc/FileHelper.h\"\n")
+		TEXT("\n")
+		TEXT("DEFINE_LOG_CATEGORY_STATIC(LogQCEBenchmark, Log, All);");
+
+	const TCHAR* SourceBlock =
+		TEXT("bool UQCE_BenchmarkLibrary::ProcessValue{N}(const FString& InValue, int32 InCount, float InScale, const TArray<FName>& InOptions)\n")
+		TEXT("{\n")
+		TEXT("\t/* Block comment inside the body of entry {N}, spanning\n")
+		TEXT("\t   two lines with a \"string\" and a // line comment marker in it */\n")
+		TEXT("\tstatic const FString Message = TEXT(\"ProcessValue{N} received a long message with escaped \\\"quotes\\\" and a path C:\\\\Temp\\\\File{N}.txt that keeps on going\");\n")
+		TEXT("\tif (InValue.IsEmpty() || InCount <= 0x{N}F)\n")
+		TEXT("\t{\n")
+		TEXT("\t\tUE_LOG(LogQCEBenchmark, Warning, TEXT(\"%s: invalid input %d (scale %f)\"), *Message, InCount, InScale * 2.5e-3f);\n")
+		TEXT("\t\treturn false;\n")
+		TEXT("\t}\n")
+		TEXT("\n")
+		TEXT("\tint32 Total = 0;\n")
+		TEXT("\tfor (int32 Index = 0; Index < InOptions.Num(); ++Index)\n")
+		TEXT("\t{\n")
+		TEXT("\t\tconst FName& Option = InOptions[Index]; // Option {N}\n")
+		TEXT("\t\tTotal += Option.ToString().Len() >> 1;\n")
+		TEXT("\t}\n")
+		TEXT("\treturn Total != 0 && FPaths::FileExists(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT(\"Benchmark{N}.txt\")));\n")
+		TEXT("}");
+
+	/** Returns the value at the given percentile (0-1) of sorted samples */
+	double GetPercentile(const TArray<double>& SortedSamples, const double Percentile)
+	{
+		if (SortedSamples.Num() == 0)
+		{
+			return -1.0;
+		}
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+
+	double GetMBPerSecond(const int32 NumChars, const double Milliseconds)
+	{
+		const double Megabytes = static_cast<double>(NumChars) * sizeof(TCHAR) / (1024.0 * 1024.0);
+		return Milliseconds > 0.0 ? Megabytes / (Milliseconds / 1000.0) : 0.0;
+	}
+
+	int32 GetNumPasses(const int32 NumLines)
+	{
+		return FMath::Max(MinPasses, TargetLinesPerMeasurement / FMath::Max(NumLines, 1));
+	}
+
+	/** Full tokenization with an empty line cache, the way a file is tokenized when it is opened */
+	void MeasureTokenize(const FString& Document, FQCE_HighlighterBenchmark::FResult& Result)
+	{
+		const TSharedRef<FCppSyntaxTokenizer> Tokenizer = FCppSyntaxTokenizer::Create();
+		TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines;
+
+		// Counted on its own pass, so the counter does not weigh on the timings
+		{
+			const FScopedAllocationCounter AllocationCounter;
+			Tokenizer->Process(TokenizedLines, Document);
+			Result.TokenizeAllocations = AllocationCounter.GetNumAllocations();
+		}
+
+		Result.NumTokens = 0;
+		for (const ISyntaxTokenizer::FTokenizedLine& TokenizedLine : TokenizedLines)
+		{
+			Result.NumTokens += TokenizedLine.Tokens.Num();
+		}
+
+		const int32 NumPasses = GetNumPasses(Result.NumLines);
+		double TotalSeconds = 0.0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			Tokenizer->InvalidateLineCache();
+
+			const double StartTime = FPlatformTime::Seconds();
+			Tokenizer->Process(TokenizedLines, Document);
+			TotalSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		Result.TokenizeMs = TotalSeconds * 1000.0 / NumPasses;
+		Result.TokenizeMBPerSecond = GetMBPerSecond(Result.NumChars, Result.TokenizeMs);
+		Result.TokensPerSecond = TotalSeconds > 0.0 ? static_cast<double>(Result.NumTokens) * NumPasses / TotalSeconds : 0.0;
+	}
+
+	/** Times one operator matcher over every punctuation character of the document. Returns the summed match lengths. */
+	template <typename MatcherType>
+	int64 TimeOperatorMatching(const FString& Document, const int32 NumPasses, MatcherType&& Matcher, double& OutMs)
+	{
+		int64 MatchedLength = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			const TCHAR* Chars = *Document;
+			for (int32 Index = 0; Index < Document.Len(); ++Index)
+			{
+				if (FChar::IsPunct(Chars[Index]))
+				{
+					MatchedLength += Matcher(Chars + Index, Document.Len() - Index);
+				}
+			}
+		}
+
+		OutMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumPasses;
+		return MatchedLength;
+	}
+
+	/** Operator matching through the first character dispatch table, against the former scan of every operator in turn */
+	void MeasureOperatorMatching(const FString& Document, FQCE_HighlighterBenchmark::FResult& Result)
+	{
+		const TSharedRef<FCppSyntaxTokenizer> Tokenizer = FCppSyntaxTokenizer::Create();
+		const int32 NumPasses = GetNumPasses(Result.NumLines);
+
+		const int64 TableLength = TimeOperatorMatching(Document, NumPasses, [&Tokenizer](const TCHAR* String, const int32 MaxLength)
+		{
+			return Tokenizer->MatchOperator(String, MaxLength);
+		}, Result.OperatorTableMs);
+
+		const int64 LinearLength = TimeOperatorMatching(Document, NumPasses, [&Tokenizer](const TCHAR* String, const int32 MaxLength)
+		{
+			return Tokenizer->MatchOperatorLinear(String, MaxLength);
+		}, Result.OperatorLinearMs);
+
+		if (TableLength != LinearLength)
+		{
+			UE_LOG(LogQuickCodeEditor, Warning, TEXT("QCE.BenchmarkHighlighter: operator matchers disagree (%lld vs %lld matched characters)"), TableLength, LinearLength);
+		}
+	}
+
+	/** Full tokenization and run creation into an empty layout, with a fresh marshaller so nothing is cached */
+	void MeasureHighlight(const FString& Document, FQCE_HighlighterBenchmark::FResult& Result)
+	{
+		const TSharedRef<FBenchmarkTextLayout> TextLayout = FBenchmarkTextLayout::Create();
+
+		{
+			const TSharedRef<FCPPSyntaxHighlighterMarshaller> Marshaller = FCPPSyntaxHighlighterMarshaller::Create();
+			Marshaller->SetHighlighterEnabled(true);
+
+			const FScopedAllocationCounter AllocationCounter;
+			Marshaller->SetText(Document, *TextLayout);
+			Result.HighlightAllocations = AllocationCounter.GetNumAllocations();
+		}
+
+		const int32 NumPasses = GetNumPasses(Result.NumLines);
+		double TotalSeconds = 0.0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			const TSharedRef<FCPPSyntaxHighlighterMarshaller> Marshaller = FCPPSyntaxHighlighterMarshaller::Create();
+			Marshaller->SetHighlighterEnabled(true);
+			TextLayout->ClearLines();
+
+			const double StartTime = FPlatformTime::Seconds();
+			Marshaller->SetText(Document, *TextLayout);
+			TotalSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		Result.HighlightMs = TotalSeconds * 1000.0 / NumPasses;
+		Result.HighlightMBPerSecond = GetMBPerSecond(Result.NumChars, Result.HighlightMs);
+	}
+
+	/**
+	 * Types a character in the middle of a random line, then deletes it again, and times how long the layout takes to be re-highlighted.
+	 * The layout is cleared and set again on every edit, the same way the editable text refreshes its layout after a keystroke.
+	 */
+	void MeasureKeystrokes(FString Document, const int32 NumKeystrokes, FQCE_HighlighterBenchmark::FResult& Result)
+	{
+		const TSharedRef<FBenchmarkTextLayout> TextLayout = FBenchmarkTextLayout::Create();
+		const TSharedRef<FCPPSyntaxHighlighterMarshaller> Marshaller = FCPPSyntaxHighlighterMarshaller::Create();
+		Marshaller->SetHighlighterEnabled(true);
+		Marshaller->SetText(Document, *TextLayout);
+
+		TArray<FTextRange> LineRanges;
+		FTextRange::CalculateLineRangesFromString(Document, LineRanges);
+
+		// Fixed seed so every run edits the same lines
+		FRandomStream RandomStream(Result.NumLines);
+		TArray<double> Samples;
+		Samples.Reserve(NumKeystrokes);
+
+		int32 EditIndex = INDEX_NONE;
+		for (int32 Keystroke = 0; Keystroke < NumKeystrokes; ++Keystroke)
+		{
+			// Every other edit removes the previous character again, so the line ranges stay valid
+			if (EditIndex == INDEX_NONE)
+			{
+				const FTextRange& LineRange = LineRanges[RandomStream.RandRange(0, LineRanges.Num() - 1)];
+				EditIndex = LineRange.BeginIndex + LineRange.Len() / 2;
+				Document.InsertAt(EditIndex, TEXT('x'));
+			}
+			else
+			{
+				Document.RemoveAt(EditIndex, 1);
+				EditIndex = INDEX_NONE;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			TextLayout->ClearLines();
+			Marshaller->SetText(Document, *TextLayout);
+			Samples.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+		Samples.Sort();
+		Result.KeystrokeP50Ms = GetPercentile(Samples, 0.50);
+		Result.KeystrokeP99Ms = GetPercentile(Samples, 0.99);
+	}
+
+	FString GetPluginVersion()
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("QuickCodeEditor"));
+		return Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString(TEXT("Unknown"));
+	}
+
+	void RunBenchmarkCommand(const TArray<FString>& Args)
+	{
+		const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+		TArray<int32> LineCounts = FQCE_HighlighterBenchmark::GetDefaultLineCounts();
+		FString LineCountsString;
+		if (FParse::Value(*CommandLine, TEXT("Lines="), LineCountsString, false))
+		{
+			TArray<FString> LineCountStrings;
+			LineCountsString.ParseIntoArray(LineCountStrings, TEXT(","));
+
+			LineCounts.Reset();
+			for (const FString& LineCountString : LineCountStrings)
+			{
+				const int32 LineCount = FCString::Atoi(*LineCountString);
+				if (LineCount > 0)
+				{
+					LineCounts.Add(LineCount);
+				}
+			}
+		}
+
+		int32 NumKeystrokes = FQCE_HighlighterBenchmark::DefaultNumKeystrokes;
+		FParse::Value(*CommandLine, TEXT("Keystrokes="), NumKeystrokes);
+
+		if (LineCounts.Num() == 0)
+		{
+			UE_LOG(LogQuickCodeEditor, Error, TEXT("QCE.BenchmarkHighlighter: no valid line count in '%s'"), *LineCountsString);
+			return;
+		}
+
+		TArray<FQCE_HighlighterBenchmark::FResult> Results;
+		FQCE_HighlighterBenchmark::RunAndSave(LineCounts, FMath::Max(NumKeystrokes, 0), Results);
+	}
+
+	FAutoConsoleCommand BenchmarkHighlighterCommand(
+		TEXT("QCE.BenchmarkHighlighter"),
+		TEXT("Measures tokenizer and syntax highlighter throughput on synthetic Unreal-style files and saves the results to Saved/QuickCodeEditor/Benchmarks.\n")
+		TEXT("Usage: QCE.BenchmarkHighlighter [Lines=1000,10000,100000] [Keystrokes=200]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmarkCommand));
+}
+
+FString FQCE_HighlighterBenchmark::GenerateDocument(const int32 NumLines, const bool bHeader)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(NumLines + 32);
+	FString(bHeader ? HeaderPreamble : SourcePreamble).ParseIntoArrayLines(Lines, false);
+
+	const FString Block = bHeader ? HeaderBlock : SourceBlock;
+	TArray<FString> BlockLines;
+	for (int32 BlockIndex = 0; Lines.Num() < NumLines; ++BlockIndex)
+	{
+		Lines.Add(FString());
+
+		BlockLines.Reset();
+		Block.Replace(TEXT("{N}"), *FString::FromInt(BlockIndex)).ParseIntoArrayLines(BlockLines, false);
+		Lines.Append(BlockLines);
+	}
+
+	// The last block is cut wherever the line count falls, which may leave a comment or a body open like a file being typed
+	Lines.SetNum(FMath::Max(NumLines - (bHeader ? 1 : 0), 0));
+	if (bHeader)
+	{
+		Lines.Add(TEXT("};"));
+	}
+
+	return FString::Join(Lines, TEXT("\n"));
+}
+
+TArray<FQCE_HighlighterBenchmark::FResult> FQCE_HighlighterBenchmark::Run(const TArray<int32>& LineCounts, const int32 NumKeystrokes)
+{
+	TArray<FResult> Results;
+
+	const bool bWasVectorized = FQCE_TextScan::IsVectorized();
+	TArray<bool> ScanModes = { false };
+	if (bWasVectorized)
+	{
+		ScanModes.Insert(true, 0);
+	}
+
+	for (const int32 NumLines : LineCounts)
+	{
+		for (const bool bHeader : { true, false })
+		{
+			const FString Document = GenerateDocument(NumLines, bHeader);
+
+			for (const bool bVectorized : ScanModes)
+			{
+				FQCE_TextScan::SetForceScalar(!bVectorized);
+
+				FResult& Result = Results.AddDefaulted_GetRef();
+				Result.DocumentKind = bHeader ? TEXT("Header") : TEXT("Source");
+				Result.ScanMode = bVectorized ? TEXT("Vector") : TEXT("Scalar");
+				Result.NumLines = NumLines;
+				Result.NumChars = Document.Len();
+
+				MeasureTokenize(Document, Result);
+				MeasureOperatorMatching(Document, Result);
+				MeasureHighlight(Document, Result);
+
+				// Latency is only tracked in the mode the editor actually runs in
+				if (NumKeystrokes > 0 && bVectorized == bWasVectorized)
+				{
+					MeasureKeystrokes(Document, NumKeystrokes, Result);
+				}
+			}
+		}
+	}
+
+	FQCE_TextScan::SetForceScalar(!bWasVectorized);
+	return Results;
+}
+
+bool FQCE_HighlighterBenchmark::RunAndSave(const TArray<int32>& LineCounts, const int32 NumKeystrokes, TArray<FResult>& OutResults)
+{
+	OutResults = Run(LineCounts, NumKeystrokes);
+	LogResults(OutResults);
+
+	FString CsvPath;
+	FString JsonPath;
+	if (!SaveResults(OutResults, CsvPath, JsonPath))
+	{
+		return false;
+	}
+
+	UE_LOG(LogQuickCodeEditor, Log, TEXT("Highlighter benchmark results saved to %s and %s"), *CsvPath, *JsonPath);
+	return true;
+}
+
+bool FQCE_HighlighterBenchmark::SaveResults(const TArray<FResult>& Results, FString& OutCsvPath, FString& OutJsonPath)
+{
+	const FString PluginVersion = GetPluginVersion();
+	const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	const FString BaseName = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("QuickCodeEditor"), TEXT("Benchmarks"), FString::Printf(TEXT("HighlighterBenchmark-%s"), *Timestamp));
+	OutCsvPath = BaseName + TEXT(".csv");
+	OutJsonPath = BaseName + TEXT(".json");
+
+	FString Csv = TEXT("PluginVersion,DocumentKind,ScanMode,Lines,Chars,Tokens,TokenizeMs,TokenizeMBps,TokensPerSecond,TokenizeAllocations,OperatorTableMs,OperatorLinearMs,HighlightMs,HighlightMBps,HighlightAllocations,KeystrokeP50Ms,KeystrokeP99Ms\n");
+	for (const FResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%d,%.3f,%.2f,%.0f,%lld,%.3f,%.3f,%.3f,%.2f,%lld,%.3f,%.3f\n"),
+			*PluginVersion, *Result.DocumentKind, *Result.ScanMode, Result.NumLines, Result.NumChars, Result.NumTokens,
+			Result.TokenizeMs, Result.TokenizeMBPerSecond, Result.TokensPerSecond, Result.TokenizeAllocations,
+			Result.OperatorTableMs, Result.OperatorLinearMs,
+			Result.HighlightMs, Result.HighlightMBPerSecond, Result.HighlightAllocations,
+			Result.KeystrokeP50Ms, Result.KeystrokeP99Ms);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for (const FResult& Result : Results)
+	{
+		const TSharedPtr<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+		JsonResult->SetStringField(TEXT("documentKind"), Result.DocumentKind);
+		JsonResult->SetStringField(TEXT("scanMode"), Result.ScanMode);
+		JsonResult->SetNumberField(TEXT("lines"), Result.NumLines);
+		JsonResult->SetNumberField(TEXT("chars"), Result.NumChars);
+		JsonResult->SetNumberField(TEXT("tokens"), Result.NumTokens);
+		JsonResult->SetNumberField(TEXT("tokenizeMs"), Result.TokenizeMs);
+		JsonResult->SetNumberField(TEXT("tokenizeMBps"), Result.TokenizeMBPerSecond);
+		JsonResult->SetNumberField(TEXT("tokensPerSecond"), Result.TokensPerSecond);
+		JsonResult->SetNumberField(TEXT("tokenizeAllocations"), static_cast<double>(Result.TokenizeAllocations));
+		JsonResult->SetNumberField(TEXT("operatorTableMs"), Result.OperatorTableMs);
+		JsonResult->SetNumberField(TEXT("operatorLinearMs"), Result.OperatorLinearMs);
+		JsonResult->SetNumberField(TEXT("highlightMs"), Result.HighlightMs);
+		JsonResult->SetNumberField(TEXT("highlightMBps"), Result.HighlightMBPerSecond);
+		JsonResult->SetNumberField(TEXT("highlightAllocations"), static_cast<double>(Result.HighlightAllocations));
+		JsonResult->SetNumberField(TEXT("keystrokeP50Ms"), Result.KeystrokeP50Ms);
+		JsonResult->SetNumberField(TEXT("keystrokeP99Ms"), Result.KeystrokeP99Ms);
+		JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+	}
+
+	const TSharedRef<FJsonObject> JsonRoot = MakeShared<FJsonObject>();
+	JsonRoot->SetStringField(TEXT("pluginVersion"), PluginVersion);
+	JsonRoot->SetStringField(TEXT("timestamp"), Timestamp);
+	JsonRoot->SetArrayField(TEXT("results"), JsonResults);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(JsonRoot, Writer);
+
+	bool bSaved = true;
+	if (!FFileHelper::SaveStringToFile(Csv, *OutCsvPath))
+	{
+		UE_LOG(LogQuickCodeEditor, Error, TEXT("Failed to save highlighter benchmark results to %s"), *OutCsvPath);
+		bSaved = false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutJsonPath))
+	{
+		UE_LOG(LogQuickCodeEditor, Error, TEXT("Failed to save highlighter benchmark results to %s"), *OutJsonPath);
+		bSaved = false;
+	}
+
+	return bSaved;
+}
+
+void FQCE_HighlighterBenchmark::LogResults(const TArray<FResult>& Results)
+{
+	for (const FResult& Result : Results)
+	{
+		UE_LOG(LogQuickCodeEditor, Log, TEXT("%s %d lines (%s): tokenize %.2f ms (%.1f MB/s, %.0f tokens/s, %lld allocs), operators %.2f ms (%.2f ms scanning every operator), highlight %.2f ms (%.1f MB/s, %lld allocs), keystroke p50 %.2f ms p99 %.2f ms"),
+			*Result.DocumentKind, Result.NumLines, *Result.ScanMode,
+			Result.TokenizeMs, Result.TokenizeMBPerSecond, Result.TokensPerSecond, Result.TokenizeAllocations,
+			Result.OperatorTableMs, Result.OperatorLinearMs,
+			Result.HighlightMs, Result.HighlightMBPerSecond, Result.HighlightAllocations,
+			Result.KeystrokeP50Ms, Result.KeystrokeP99Ms);
+	}
+}
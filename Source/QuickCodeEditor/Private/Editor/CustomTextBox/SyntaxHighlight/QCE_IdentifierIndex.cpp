@@ -0,0 +1,148 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_IdentifierIndex.h"
+
+#include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextScan.h"
+
+namespace
+{
+	bool IsIdentifierTokenKind(const ECppTokenKind TokenKind)
+	{
+		return TokenKind != ECppTokenKind::Comment && TokenKind != ECppTokenKind::String &&
+			TokenKind != ECppTokenKind::Number && TokenKind != ECppTokenKind::Operator;
+	}
+
+	bool IsIdentifierStart(const TCHAR Char)
+	{
+		return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z') || Char == TEXT('_');
+	}
+}
+
+void FQCE_IdentifierIndex::ApplyDirtyLines(const FCppSyntaxTokenizer& Tokenizer)
+{
+	const FCppSyntaxTokenizer::FDirtyLineRange& DirtyRange = Tokenizer.GetLastDirtyLineRange();
+	const int32 NumLines = Tokenizer.GetNumLines();
+
+	const bool bInSync = DirtyRange.FirstLine + DirtyRange.NumOldLines <= Lines.Num() &&
+		Lines.Num() - DirtyRange.NumOldLines + DirtyRange.NumNewLines == NumLines;
+	if (!bInSync || DirtyRange.NumNewLines == NumLines)
+	{
+		Rebuild(Tokenizer);
+		return;
+	}
+
+	for (int32 LineIndex = DirtyRange.FirstLine; LineIndex < DirtyRange.FirstLine + DirtyRange.NumOldLines; ++LineIndex)
+	{
+		for (const FLineIdentifier& Identifier : Lines[LineIndex])
+		{
+			--WordCounts[Identifier.WordId];
+		}
+	}
+
+	Lines.RemoveAt(DirtyRange.FirstLine, DirtyRange.NumOldLines);
+	Lines.InsertDefaulted(DirtyRange.FirstLine, DirtyRange.NumNewLines);
+
+	for (int32 LineIndex = DirtyRange.FirstLine; LineIndex < DirtyRange.FirstLine + DirtyRange.NumNewLines; ++LineIndex)
+	{
+		IndexLine(Tokenizer, LineIndex);
+	}
+}
+
+void FQCE_IdentifierIndex::UpdateLine(const FCppSyntaxTokenizer& Tokenizer, const int32 LineIndex)
+{
+	if (Lines.Num() != Tokenizer.GetNumLines())
+	{
+		Rebuild(Tokenizer);
+		return;
+	}
+
+	if (Lines.IsValidIndex(LineIndex))
+	{
+		IndexLine(Tokenizer, LineIndex);
+	}
+}
+
+void FQCE_IdentifierIndex::Rebuild(const FCppSyntaxTokenizer& Tokenizer)
+{
+	Lines.Reset();
+	WordIds.Reset();
+	WordCounts.Reset();
+
+	Lines.SetNum(Tokenizer.GetNumLines());
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		IndexLine(Tokenizer, LineIndex);
+	}
+}
+
+void FQCE_IdentifierIndex::FindOccurrences(const FString& Word, const int32 FirstLine, const int32 LastLine, TArray<FOccurrence>& OutOccurrences) const
+{
+	const int32* WordId = WordIds.Find(Word);
+	if (!WordId || WordCounts[*WordId] == 0)
+	{
+		return;
+	}
+
+	const int32 EndLine = FMath::Min(LastLine + 1, Lines.Num());
+	for (int32 LineIndex = FMath::Max(FirstLine, 0); LineIndex < EndLine; ++LineIndex)
+	{
+		for (const FLineIdentifier& Identifier : Lines[LineIndex])
+		{
+			if (Identifier.WordId == *WordId)
+			{
+				OutOccurrences.Add({ LineIndex, Identifier.BeginOffset, Identifier.EndOffset });
+			}
+		}
+	}
+}
+
+int32 FQCE_IdentifierIndex::CountOccurrences(const FString& Word) const
+{
+	const int32* WordId = WordIds.Find(Word);
+	return WordId ? WordCounts[*WordId] : 0;
+}
+
+void FQCE_IdentifierIndex::IndexLine(const FCppSyntaxTokenizer& Tokenizer, const int32 LineIndex)
+{
+	TArray<FLineIdentifier>& Identifiers = Lines[LineIndex];
+	for (const FLineIdentifier& Identifier : Identifiers)
+	{
+		--WordCounts[Identifier.WordId];
+	}
+	Identifiers.Reset();
+
+	if (Tokenizer.IsLinePlaceholder(LineIndex))
+	{
+		return;
+	}
+
+	const FString& LineText = Tokenizer.GetLineText(LineIndex);
+	const TArray<ISyntaxTokenizer::FToken>& Tokens = Tokenizer.GetLineTokens(LineIndex);
+	const TArray<ECppTokenKind>& TokenKinds = Tokenizer.GetLineTokenKinds(LineIndex);
+
+	for (int32 TokenIndex = 0; TokenIndex < Tokens.Num(); ++TokenIndex)
+	{
+		const FTextRange& Range = Tokens[TokenIndex].Range;
+		if (!IsIdentifierTokenKind(TokenKinds[TokenIndex]) || Range.IsEmpty() || !IsIdentifierStart(LineText[Range.BeginIndex]) ||
+			FQCE_TextScan::SkipIdentifierChars(*LineText, Range.BeginIndex, Range.EndIndex) != Range.EndIndex)
+		{
+			continue;
+		}
+
+		FString Word = LineText.Mid(Range.BeginIndex, Range.Len());
+		int32 WordId;
+		if (const int32* ExistingWordId = WordIds.Find(Word))
+		{
+			WordId = *ExistingWordId;
+		}
+		else
+		{
+			WordId = WordCounts.Add(0);
+			WordIds.Add(MoveTemp(Word), WordId);
+		}
+
+		++WordCounts[WordId];
+		Identifiers.Add({ WordId, Range.BeginIndex, Range.EndIndex });
+	}
+}
@@ -0,0 +1,87 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_SyntaxStyleTable.h"
+
+#include "Settings/UQCE_EditorSettings.h"
+#include "Styling/CoreStyle.h"
+
+namespace
+{
+	/** Owns the current table and swaps it whenever the syntax settings change */
+	struct FCurrentSyntaxStyleTable
+	{
+		TSharedRef<const FQCE_SyntaxStyleTable> Table;
+		FSimpleMulticastDelegate OnTableChanged;
+
+		FCurrentSyntaxStyleTable()
+			: Table(FQCE_SyntaxStyleTable::CreateFromSettings())
+		{
+			if (UQCE_EditorSettings* Settings = GetMutableDefault<UQCE_EditorSettings>())
+			{
+				Settings->OnSyntaxSettingsUpdated.BindRaw(this, &FCurrentSyntaxStyleTable::HandleSyntaxSettingsUpdated);
+			}
+		}
+
+		void HandleSyntaxSettingsUpdated()
+		{
+			Table = FQCE_SyntaxStyleTable::CreateFromSettings();
+			OnTableChanged.Broadcast();
+		}
+
+		static FCurrentSyntaxStyleTable& Get()
+		{
+			static FCurrentSyntaxStyleTable Instance;
+			return Instance;
+		}
+	};
+}
+
+TSharedRef<const FQCE_SyntaxStyleTable> FQCE_SyntaxStyleTable::CreateFromSettings()
+{
+	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+	check(Settings);
+
+	// Create the base font style with user settings
+	FSlateFontInfo FontInfo = FCoreStyle::GetDefaultFontStyle(
+		TEXT("Mono"),
+		Settings->FontSize
+	);
+
+	// Apply bold if enabled
+	if (Settings->bUseBoldFont)
+	{
+		FontInfo.TypefaceFontName = TEXT("Bold");
+	}
+
+	const TSharedRef<FQCE_SyntaxStyleTable> NewTable = MakeShareable(new FQCE_SyntaxStyleTable());
+
+	auto SetStyle = [&NewTable, &FontInfo](const ECppTokenKind TokenKind, const FLinearColor& Color)
+	{
+		NewTable->Styles[static_cast<int32>(TokenKind)] = FTextBlockStyle()
+			.SetFont(FontInfo)
+			.SetColorAndOpacity(Color);
+	};
+
+	SetStyle(ECppTokenKind::Normal, Settings->TextColor);
+	SetStyle(ECppTokenKind::Operator, Settings->TextColor);
+	SetStyle(ECppTokenKind::Keyword, Settings->KeywordColor);
+	SetStyle(ECppTokenKind::String, Settings->StringColor);
+	SetStyle(ECppTokenKind::Number, Settings->NumberColor);
+	SetStyle(ECppTokenKind::Comment, Settings->CommentColor);
+	SetStyle(ECppTokenKind::PreProcessorKeyword, Settings->KeywordColor); // Same as keywords
+	SetStyle(ECppTokenKind::UnrealTypedef, Settings->TypeColor);
+	SetStyle(ECppTokenKind::Function, Settings->FunctionColor);
+	SetStyle(ECppTokenKind::Class, Settings->ClassColor);
+
+	return NewTable;
+}
+
+const TSharedRef<const FQCE_SyntaxStyleTable>& FQCE_SyntaxStyleTable::GetCurrent()
+{
+	return FCurrentSyntaxStyleTable::Get().Table;
+}
+
+FSimpleMulticastDelegate& FQCE_SyntaxStyleTable::OnCurrentTableChanged()
+{
+	return FCurrentSyntaxStyleTable::Get().OnTableChanged;
+}
@@ -3,9 +3,64 @@
 
 #include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextLayout.h"
 
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_IdentifierIndex.h"
 #include "Editor/CustomTextBox/SyntaxHighlight/QCE_WordBackgroundHighlighter.h"
 #include "Settings/UQCE_EditorSettings.h"
 
+#include <atomic>
+
+struct FQCE_TextLayout::FWordCount
+{
+    int32 Count = 0;
+
+    /** Set by the game thread when the count is no longer wanted */
+    std::atomic<bool> bCancelled { false };
+
+    /** Set by the worker once Count is final */
+    std::atomic<bool> bFinished { false };
+};
+
+namespace
+{
+    bool IsWordChar(const TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Calls Callback with the begin and end offsets of every whole-word occurrence of Word in Text */
+    template <typename CallbackType>
+    void ForEachWholeWord(const FString& Text, const FString& Word, CallbackType&& Callback)
+    {
+        const int32 TextLength = Text.Len();
+        const int32 WordLength = Word.Len();
+        int32 FindBegin = 0;
+        int32 MatchBegin;
+
+        while (FindBegin < TextLength && (MatchBegin = Text.Find(Word, ESearchCase::CaseSensitive, ESearchDir::FromStart, FindBegin)) != INDEX_NONE)
+        {
+            const int32 MatchEnd = MatchBegin + WordLength;
+            FindBegin = MatchEnd;
+
+            // Only whole words count, the characters around the match must not continue it
+            if ((MatchBegin == 0 || !IsWordChar(Text[MatchBegin - 1])) && (MatchEnd == TextLength || !IsWordChar(Text[MatchEnd])))
+            {
+                Callback(MatchBegin, MatchEnd);
+            }
+        }
+    }
+}
+
+FQCE_TextLayout::~FQCE_TextLayout()
+{
+    if (WordHighlightTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(WordHighlightTickerHandle);
+    }
+    CancelWordCount();
+}
+
 int32 FQCE_TextLayout::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
                                const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
                                const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
@@ -16,77 +71,209 @@ int32 FQCE_TextLayout::OnPaint(const FPaintArgs& Args, const FGeometry& Allotted
 
 void FQCE_TextLayout::HighlightWord(const FString& Word)
 {
-    // Get highlight color from editor settings
+    RemoveWordHighlights();
+    HighlightedWord = Word;
+
+    ApplyWordHighlights();
+    UpdateHighlightedWordCount();
+}
+
+void FQCE_TextLayout::ApplyWordHighlights()
+{
+    // Only the lines around the viewport get highlights, the range follows the view as it scrolls
+    GetWordHighlightLineRange(HighlightedFirstLine, HighlightedLastLine);
+
+    // Visible lines first, so they are highlighted on this frame even when the margins have many occurrences
+    if (VisibleFirstLine <= VisibleLastLine)
+    {
+        FindWordOccurrences(HighlightedWord, FMath::Max(VisibleFirstLine, HighlightedFirstLine), FMath::Min(VisibleLastLine, HighlightedLastLine), PendingWordOccurrences);
+        FindWordOccurrences(HighlightedWord, HighlightedFirstLine, VisibleFirstLine - 1, PendingWordOccurrences);
+        FindWordOccurrences(HighlightedWord, VisibleLastLine + 1, HighlightedLastLine, PendingWordOccurrences);
+    }
+    else
+    {
+        FindWordOccurrences(HighlightedWord, HighlightedFirstLine, HighlightedLastLine, PendingWordOccurrences);
+    }
+
     const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
-    const FLinearColor BackgroundColor = Settings ? Settings->WordHighlightColor : FLinearColor(1.0f, 1.0f, 0.0f, 0.3f);
+    const int32 MaxHighlightsPerFrame = Settings ? FMath::Max(Settings->MaxWordHighlightsPerFrame, 1) : 200;
+    AddPendingWordHighlights(MaxHighlightsPerFrame);
+
+    if (NextPendingWordOccurrence < PendingWordOccurrences.Num())
+    {
+        StartWordHighlightTicker();
+    }
+}
+
+void FQCE_TextLayout::RemoveWordHighlights()
+{
+    const TArray<FTextLayout::FLineModel>& Lines = GetLineModels();
+
+    for (const FTextLineHighlight& LineHighlight : WordHighlights)
+    {
+        if (Lines.IsValidIndex(LineHighlight.LineIndex))
+        {
+            RemoveLineHighlight(LineHighlight);
+        }
+    }
+
+    WordHighlights.Empty();
+    PendingWordOccurrences.Reset();
+    NextPendingWordOccurrence = 0;
+}
 
-    // Set up search parameters
-    ESearchCase::Type SearchCase = ESearchCase::CaseSensitive;
-    const int32 SearchTextLength = Word.Len();
+void FQCE_TextLayout::AddPendingWordHighlights(const int32 MaxHighlights)
+{
     constexpr int32 SearchHighlightZOrder = -9;  // Lower Z-order ensures highlights appear behind text
 
-    // Create a highlighter object with color from settings
-    TSharedRef<FQCE_WordBackgroundHighlighter> Highlighter = FQCE_WordBackgroundHighlighter::Create(BackgroundColor);
-    
-    // Get all text lines in the layout
+    const TSharedRef<FQCE_WordBackgroundHighlighter> Highlighter = GetWordHighlighter();
+    const int32 NumLines = GetLineModels().Num();
+    const int32 EndOccurrence = FMath::Min(NextPendingWordOccurrence + MaxHighlights, PendingWordOccurrences.Num());
+
+    for (; NextPendingWordOccurrence < EndOccurrence; ++NextPendingWordOccurrence)
+    {
+        const FQCE_IdentifierIndex::FOccurrence& Occurrence = PendingWordOccurrences[NextPendingWordOccurrence];
+        if (Occurrence.LineIndex < NumLines)
+        {
+            WordHighlights.Add(FTextLineHighlight(Occurrence.LineIndex, FTextRange(Occurrence.BeginOffset, Occurrence.EndOffset), SearchHighlightZOrder, Highlighter));
+            AddLineHighlight(WordHighlights.Last());
+        }
+    }
+
+    if (NextPendingWordOccurrence == PendingWordOccurrences.Num())
+    {
+        PendingWordOccurrences.Reset();
+        NextPendingWordOccurrence = 0;
+    }
+}
+
+void FQCE_TextLayout::FindWordOccurrences(const FString& Word, const int32 FirstLine, const int32 LastLine, TArray<FQCE_IdentifierIndex::FOccurrence>& OutOccurrences) const
+{
+    if (Word.IsEmpty() || FirstLine > LastLine)
+    {
+        return;
+    }
+
+    if (IsIdentifierIndexInSync())
+    {
+        IdentifierIndex->FindOccurrences(Word, FirstLine, LastLine, OutOccurrences);
+    }
+    else
+    {
+        // No index for this text (e.g. it was not laid out by the highlighter), fall back to scanning the lines
+        ScanWordOccurrences(Word, FirstLine, LastLine, OutOccurrences);
+    }
+}
+
+void FQCE_TextLayout::ScanWordOccurrences(const FString& Word, int32 FirstLine, int32 LastLine, TArray<FQCE_IdentifierIndex::FOccurrence>& OutOccurrences) const
+{
     const TArray<FLineModel>& Lines = GetLineModels();
-    for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+    const int32 EndLine = FMath::Min(LastLine + 1, Lines.Num());
+    for (int32 LineIndex = FMath::Max(FirstLine, 0); LineIndex < EndLine; ++LineIndex)
     {
-        const FLineModel& Line = Lines[LineIndex];
+        ForEachWholeWord(*Lines[LineIndex].Text, Word, [&OutOccurrences, LineIndex](const int32 BeginOffset, const int32 EndOffset)
+        {
+            OutOccurrences.Add({ LineIndex, BeginOffset, EndOffset });
+        });
+    }
+}
+
+void FQCE_TextLayout::UpdateHighlightedWordCount()
+{
+    CancelWordCount();
+
+    if (HighlightedWord.IsEmpty())
+    {
+        HighlightedWordCount = 0;
+        return;
+    }
+
+    if (IsIdentifierIndexInSync())
+    {
+        HighlightedWordCount = IdentifierIndex->CountOccurrences(HighlightedWord);
+        return;
+    }
+
+    // Without an index the whole text has to be searched, which is left to a worker on a copy of the lines
+    const TArray<FLineModel>& Lines = GetLineModels();
+    TArray<FString> LineTexts;
+    LineTexts.Reserve(Lines.Num());
+    for (const FLineModel& Line : Lines)
+    {
+        LineTexts.Add(*Line.Text);
+    }
 
-        // Initialize search positions
-        int32 FindBegin = 0;  // Position to start searching from
-        int32 CurrentSearchBegin;  // Position where current match is found
-        const int32 TextLength = Line.Text->Len();
-        
-        // Search for all occurrences of the word in current line
-        while (FindBegin < TextLength && (CurrentSearchBegin = Line.Text->Find(Word, SearchCase, ESearchDir::FromStart, FindBegin)) != INDEX_NONE)
+    HighlightedWordCount = INDEX_NONE;
+    WordCount = MakeShared<FWordCount, ESPMode::ThreadSafe>();
+
+    Async(EAsyncExecution::TaskGraph, [Job = WordCount, Word = HighlightedWord, LineTexts = MoveTemp(LineTexts)]()
+    {
+        int32 Count = 0;
+        for (const FString& LineText : LineTexts)
         {
-            // Check if this is a whole word match by verifying boundaries
-            bool bIsWordBoundary = true;
-            
-            // Check character before the word
-            if (CurrentSearchBegin > 0 && FChar::IsAlnum((*Line.Text)[CurrentSearchBegin - 1]))
+            if (Job->bCancelled)
             {
-                bIsWordBoundary = false;
-            }
-            
-            // Check character after the word
-            const int32 EndPos = CurrentSearchBegin + SearchTextLength;
-            if (EndPos < TextLength && FChar::IsAlnum((*Line.Text)[EndPos]))
-            {
-                bIsWordBoundary = false;
+                return;
             }
 
-            // Move search position past current match
-            FindBegin = CurrentSearchBegin + SearchTextLength;
-            
-            // Only add highlight if it's a whole word match
-            if (bIsWordBoundary)
-            {
-                WordHighlights.Add(FTextLineHighlight(LineIndex, FTextRange(CurrentSearchBegin, FindBegin), SearchHighlightZOrder, Highlighter));
-            }
+            ForEachWholeWord(LineText, Word, [&Count](int32, int32) { ++Count; });
         }
+
+        Job->Count = Count;
+        Job->bFinished = true;
+    });
+
+    StartWordHighlightTicker();
+}
+
+void FQCE_TextLayout::CancelWordCount()
+{
+    if (WordCount.IsValid())
+    {
+        WordCount->bCancelled = true;
+        WordCount.Reset();
     }
+}
 
-    // Apply all collected highlights to the text layout
-    for (const FTextLineHighlight& LineHighlight : WordHighlights)
+bool FQCE_TextLayout::IsIdentifierIndexInSync() const
+{
+    return IdentifierIndex.IsValid() && IdentifierIndex->GetNumLines() == GetLineModels().Num();
+}
+
+void FQCE_TextLayout::StartWordHighlightTicker()
+{
+    if (!WordHighlightTickerHandle.IsValid())
     {
-        AddLineHighlight(LineHighlight);
+        WordHighlightTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FQCE_TextLayout::TickWordHighlights));
     }
 }
 
-void FQCE_TextLayout::HighlightSpecificOccurrence(const FString& Word, int32 LineIndex, int32 StartOffset, int32 EndOffset)
+bool FQCE_TextLayout::TickWordHighlights(float DeltaTime)
 {
-    // Get highlight color from editor settings
-    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
-    const FLinearColor BackgroundColor = Settings ? Settings->WordHighlightColor : FLinearColor(1.0f, 1.0f, 0.0f, 0.3f);
+    if (NextPendingWordOccurrence < PendingWordOccurrences.Num())
+    {
+        const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+        AddPendingWordHighlights(Settings ? FMath::Max(Settings->MaxWordHighlightsPerFrame, 1) : 200);
+    }
 
+    if (WordCount.IsValid() && WordCount->bFinished)
+    {
+        HighlightedWordCount = WordCount->Count;
+        WordCount.Reset();
+    }
+
+    const bool bHasWorkLeft = NextPendingWordOccurrence < PendingWordOccurrences.Num() || WordCount.IsValid();
+    if (!bHasWorkLeft)
+    {
+        WordHighlightTickerHandle.Reset();
+    }
+    return bHasWorkLeft;
+}
+
+void FQCE_TextLayout::HighlightSpecificOccurrence(const FString& Word, int32 LineIndex, int32 StartOffset, int32 EndOffset)
+{
     constexpr int32 SearchHighlightZOrder = -9;  // Lower Z-order ensures highlights appear behind text
 
-    // Create a highlighter object with color from settings
-    TSharedRef<FQCE_WordBackgroundHighlighter> Highlighter = FQCE_WordBackgroundHighlighter::Create(BackgroundColor);
-    
     // Get all text lines in the layout
     const TArray<FLineModel>& Lines = GetLineModels();
     
@@ -97,17 +284,102 @@ void FQCE_TextLayout::HighlightSpecificOccurrence(const FString& Word, int32 Lin
     }
 
     // Add highlight for the specific occurrence
-    WordHighlights.Add(FTextLineHighlight(LineIndex, FTextRange(StartOffset, EndOffset), SearchHighlightZOrder, Highlighter));
+    WordHighlights.Add(FTextLineHighlight(LineIndex, FTextRange(StartOffset, EndOffset), SearchHighlightZOrder, GetWordHighlighter()));
     
     // Apply the highlight to the text layout
     AddLineHighlight(WordHighlights.Last());
 }
 
 void FQCE_TextLayout::ClearHighlights()
+{
+    RemoveWordHighlights();
+    CancelWordCount();
+
+    HighlightedWord.Reset();
+    HighlightedWordCount = 0;
+}
+
+void FQCE_TextLayout::RefreshWordHighlights()
+{
+    if (HighlightedWord.IsEmpty())
+    {
+        return;
+    }
+
+    RemoveWordHighlights();
+    ApplyWordHighlights();
+
+    // The index has the count at hand, a count running on a worker is still valid
+    if (IsIdentifierIndexInSync())
+    {
+        UpdateHighlightedWordCount();
+    }
+}
+
+void FQCE_TextLayout::SetVisibleLineRange(int32 FirstLine, int32 LastLine)
+{
+    VisibleFirstLine = FirstLine;
+    VisibleLastLine = LastLine;
+
+    // Scrolled past the lines that have highlights
+    if (!HighlightedWord.IsEmpty() && (FirstLine < HighlightedFirstLine || LastLine > HighlightedLastLine))
+    {
+        RemoveWordHighlights();
+        ApplyWordHighlights();
+    }
+
+    if (SearchMatches.Num() > 0 && (FirstLine < SearchHighlightedFirstLine || LastLine > SearchHighlightedLastLine))
+    {
+        RemoveSearchHighlights();
+        ApplySearchHighlights();
+    }
+}
+
+void FQCE_TextLayout::SetSearchMatches(TArray<FQCE_IdentifierIndex::FOccurrence>&& InSearchMatches)
+{
+    RemoveSearchHighlights();
+    SearchMatches = MoveTemp(InSearchMatches);
+    ApplySearchHighlights();
+}
+
+void FQCE_TextLayout::ClearSearchMatches()
+{
+    RemoveSearchHighlights();
+    SearchMatches.Empty();
+}
+
+void FQCE_TextLayout::ApplySearchHighlights()
+{
+    constexpr int32 SearchMatchZOrder = -10;  // Behind the word highlights
+
+    GetWordHighlightLineRange(SearchHighlightedFirstLine, SearchHighlightedLastLine);
+    if (SearchMatches.Num() == 0)
+    {
+        return;
+    }
+
+    const TSharedRef<FQCE_WordBackgroundHighlighter> Highlighter = GetSearchHighlighter();
+    const int32 NumLines = GetLineModels().Num();
+
+    int32 MatchIndex = Algo::LowerBoundBy(SearchMatches, SearchHighlightedFirstLine, &FQCE_IdentifierIndex::FOccurrence::LineIndex);
+    for (; MatchIndex < SearchMatches.Num(); ++MatchIndex)
+    {
+        const FQCE_IdentifierIndex::FOccurrence& Match = SearchMatches[MatchIndex];
+        if (Match.LineIndex > SearchHighlightedLastLine || Match.LineIndex >= NumLines)
+        {
+            break;
+        }
+
+        SearchHighlights.Add(FTextLineHighlight(Match.LineIndex, FTextRange(Match.BeginOffset, Match.EndOffset), SearchMatchZOrder, Highlighter));
+        AddLineHighlight(SearchHighlights.Last());
+    }
+}
+
+void FQCE_TextLayout::RemoveSearchHighlights()
 {
     const TArray<FTextLayout::FLineModel>& Lines = GetLineModels();
 
-    for (const FTextLineHighlight& LineHighlight : WordHighlights)
+    for (const FTextLineHighlight& LineHighlight : SearchHighlights)
     {
         if (Lines.IsValidIndex(LineHighlight.LineIndex))
         {
@@ -115,5 +387,76 @@ void FQCE_TextLayout::ClearHighlights()
         }
     }
 
-    WordHighlights.Empty();
+    SearchHighlights.Empty();
+}
+
+void FQCE_TextLayout::GetWordHighlightLineRange(int32& OutFirstLine, int32& OutLastLine) const
+{
+    const int32 LastLine = GetLineModels().Num() - 1;
+    if (VisibleLastLine < VisibleFirstLine)
+    {
+        OutFirstLine = 0;
+        OutLastLine = LastLine;
+        return;
+    }
+
+    // One page of margin on each side, so short scrolls do not need new highlights
+    const int32 NumVisibleLines = VisibleLastLine - VisibleFirstLine + 1;
+    OutFirstLine = FMath::Max(VisibleFirstLine - NumVisibleLines, 0);
+    OutLastLine = FMath::Min(VisibleLastLine + NumVisibleLines, LastLine);
+}
+
+TSharedRef<FQCE_WordBackgroundHighlighter> FQCE_TextLayout::GetWordHighlighter()
+{
+    // Get highlight color from editor settings
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const FLinearColor BackgroundColor = Settings ? Settings->WordHighlightColor : FLinearColor(1.0f, 1.0f, 0.0f, 0.3f);
+
+    // All highlights share one highlighter, so changing the color applies to the ones already shown
+    if (!WordHighlighter.IsValid())
+    {
+        WordHighlighter = FQCE_WordBackgroundHighlighter::Create(BackgroundColor);
+    }
+    else
+    {
+        WordHighlighter->SetBackgroundColor(BackgroundColor);
+    }
+
+    return WordHighlighter.ToSharedRef();
+}
+
+TSharedRef<FQCE_WordBackgroundHighlighter> FQCE_TextLayout::GetSearchHighlighter()
+{
+    const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
+    const FLinearColor BackgroundColor = Settings ? Settings->SearchHighlightColor : FLinearColor(0.85f, 0.55f, 0.1f, 0.35f);
+
+    if (!SearchHighlighter.IsValid())
+    {
+        SearchHighlighter = FQCE_WordBackgroundHighlighter::Create(BackgroundColor);
+    }
+    else
+    {
+        SearchHighlighter->SetBackgroundColor(BackgroundColor);
+    }
+
+    return SearchHighlighter.ToSharedRef();
+}
+
+bool FQCE_TextLayout::ReplaceLineRuns(int32 LineIndex, const TArray<TSharedRef<IRun>>& Runs)
+{
+    if (!LineModels.IsValidIndex(LineIndex))
+    {
+        return false;
+    }
+
+    FLineModel& LineModel = LineModels[LineIndex];
+    LineModel.Runs.Reset(Runs.Num());
+    for (const TSharedRef<IRun>& Run : Runs)
+    {
+        LineModel.Runs.Add(FRunModel(Run));
+    }
+
+    DirtyLineLayout(LineIndex);
+    DirtyLayout();
+    return true;
 }
\ No newline at end of file
@@ -4,15 +4,40 @@
 
 #include "Fonts/FontMeasure.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Framework/Text/DefaultLayoutBlock.h"
+#include "Framework/Text/ShapedTextCache.h"
+#include "Rendering/DrawElements.h"
+
+int16 FQCE_TextRun::GetBaseLine(float Scale) const
+{
+    const FTextBlockStyle& Style = GetStyle();
+    const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+    return FontMeasure->GetBaseline(Style.Font, Scale) - FMath::Min(0.0f, Style.ShadowOffset.Y * Scale);
+}
+
+int16 FQCE_TextRun::GetMaxHeight(float Scale) const
+{
+    const FTextBlockStyle& Style = GetStyle();
+    const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+    return FontMeasure->GetMaxCharacterHeight(Style.Font, Scale) + FMath::Abs(Style.ShadowOffset.Y * Scale);
+}
 
 FVector2D FQCE_TextRun::Measure(int32 StartIndex, int32 EndIndex, float Scale, const FRunTextContext& TextContext) const
 {
-    // Get the base measurement from the parent class
-    FVector2D BaseSize = FSlateTextRun::Measure(StartIndex, EndIndex, Scale, TextContext);
-    
+    const FTextBlockStyle& Style = GetStyle();
+    const FVector2D ShadowOffsetToApply((EndIndex == Range.EndIndex) ? FMath::Abs(Style.ShadowOffset.X * Scale) : 0.0f, FMath::Abs(Style.ShadowOffset.Y * Scale));
+
+    if (EndIndex - StartIndex == 0)
+    {
+        return FVector2D(ShadowOffsetToApply.X * Scale, GetMaxHeight(Scale));
+    }
+
+    // Shape the whole line (rather than the run range) so that text that spans runs is still shaped correctly
+    FVector2D BaseSize = ShapedTextCacheUtil::MeasureShapedText(TextContext.ShapedTextCache, FCachedShapedTextKey(FTextRange(0, Text->Len()), Scale, TextContext, Style.Font), FTextRange(StartIndex, EndIndex), **Text) + ShadowOffsetToApply;
+
     const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
     check(Settings);
-    
+
     // Count tab characters in the measured range
     int32 TabCount = 0;
     const FString& Text2 = *Text;
@@ -23,13 +48,156 @@ FVector2D FQCE_TextRun::Measure(int32 StartIndex, int32 EndIndex, float Scale, c
             TabCount++;
         }
     }
-    
+
     if (TabCount > 0)
     {
         const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
         const float SpaceWidth = FontMeasure->Measure(TEXT(" "), Style.Font).X;
         BaseSize.X = SpaceWidth * Settings->TabSpaceCount * TabCount;
     }
-    
+
     return BaseSize;
-} 
\ No newline at end of file
+}
+
+int8 FQCE_TextRun::GetKerning(int32 CurrentIndex, float Scale, const FRunTextContext& TextContext) const
+{
+    const int32 PreviousIndex = CurrentIndex - 1;
+    if (PreviousIndex < 0 || CurrentIndex == Text->Len())
+    {
+        return 0;
+    }
+
+    return ShapedTextCacheUtil::GetShapedGlyphKerning(TextContext.ShapedTextCache, FCachedShapedTextKey(FTextRange(0, Text->Len()), Scale, TextContext, GetStyle().Font), PreviousIndex, **Text);
+}
+
+TSharedRef<ILayoutBlock> FQCE_TextRun::CreateBlock(int32 StartIndex, int32 EndIndex, FVector2D Size, const FLayoutBlockTextContext& TextContext, const TSharedPtr<IRunRenderer>& Renderer)
+{
+    return FDefaultLayoutBlock::Create(SharedThis(this), FTextRange(StartIndex, EndIndex), Size, TextContext, Renderer);
+}
+
+int32 FQCE_TextRun::GetTextIndexAt(const TSharedRef<ILayoutBlock>& Block, const FVector2D& Location, float Scale, ETextHitPoint* const OutHitPoint) const
+{
+    const FVector2D& BlockOffset = Block->GetLocationOffset();
+    const FVector2D& BlockSize = Block->GetSize();
+
+    const bool bContainsPoint = Location.X >= BlockOffset.X && Location.X < BlockOffset.X + BlockSize.X &&
+        Location.Y >= BlockOffset.Y && Location.Y < BlockOffset.Y + BlockSize.Y;
+    if (!bContainsPoint)
+    {
+        return INDEX_NONE;
+    }
+
+    const FTextRange BlockRange = Block->GetTextRange();
+    const FLayoutBlockTextContext BlockTextContext = Block->GetTextContext();
+
+    const int32 Index = ShapedTextCacheUtil::FindCharacterIndexAtOffset(BlockTextContext.ShapedTextCache, FCachedShapedTextKey(FTextRange(0, Text->Len()), Scale, BlockTextContext, GetStyle().Font), BlockRange, **Text, Location.X - BlockOffset.X);
+    if (OutHitPoint)
+    {
+        *OutHitPoint = (Index == BlockRange.EndIndex) ? ETextHitPoint::RightGutter : ETextHitPoint::WithinText;
+    }
+
+    return Index;
+}
+
+FVector2D FQCE_TextRun::GetLocationAt(const TSharedRef<ILayoutBlock>& Block, int32 Offset, float Scale) const
+{
+    const FVector2D& BlockOffset = Block->GetLocationOffset();
+    const FTextRange& BlockRange = Block->GetTextRange();
+    const FLayoutBlockTextContext BlockTextContext = Block->GetTextContext();
+
+    const FTextRange RangeToMeasure = (BlockTextContext.TextDirection == TextBiDi::ETextDirection::LeftToRight) ? FTextRange(BlockRange.BeginIndex, Offset) : FTextRange(Offset, BlockRange.EndIndex);
+    const FVector2D OffsetLocation = ShapedTextCacheUtil::MeasureShapedText(BlockTextContext.ShapedTextCache, FCachedShapedTextKey(FTextRange(0, Text->Len()), Scale, BlockTextContext, GetStyle().Font), RangeToMeasure, **Text);
+
+    return BlockOffset + OffsetLocation;
+}
+
+void FQCE_TextRun::BeginLayout()
+{
+    StyleTable = FQCE_SyntaxStyleTable::GetCurrent();
+}
+
+void FQCE_TextRun::Move(const TSharedRef<FString>& NewText, const FTextRange& NewRange)
+{
+    Text = NewText;
+    Range = NewRange;
+}
+
+TSharedRef<IRun> FQCE_TextRun::Clone() const
+{
+    return FQCE_TextRun::Create(RunInfo, Text, StyleTable, TokenKind, Range);
+}
+
+void FQCE_TextRun::AppendTextTo(FString& AppendToText) const
+{
+    AppendToText.Append(**Text + Range.BeginIndex, Range.Len());
+}
+
+void FQCE_TextRun::AppendTextTo(FString& AppendToText, const FTextRange& PartialRange) const
+{
+    check(Range.BeginIndex <= PartialRange.BeginIndex);
+    check(Range.EndIndex >= PartialRange.EndIndex);
+
+    AppendToText.Append(**Text + PartialRange.BeginIndex, PartialRange.Len());
+}
+
+int32 FQCE_TextRun::OnPaint(const FPaintArgs& PaintArgs, const FTextArgs& TextArgs, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const FTextBlockStyle& Style = GetStyle();
+    const TSharedRef<ILayoutBlock>& Block = TextArgs.Block;
+    const FTextLayout::FLineView& Line = TextArgs.Line;
+
+    const ESlateDrawEffect DrawEffects = bParentEnabled ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+    const FTextRange BlockRange = Block->GetTextRange();
+    const FLayoutBlockTextContext BlockTextContext = Block->GetTextContext();
+
+    // The block size and offset are pre-scaled, so undo the scale when turning them into paint geometry
+    const float InverseScale = Inverse(AllottedGeometry.Scale);
+
+    // A negative shadow offset is applied as a positive offset to the text so neither gets clipped
+    const FVector2D DrawShadowOffset(
+        (Style.ShadowOffset.X > 0.0f) ? Style.ShadowOffset.X * AllottedGeometry.Scale : 0.0f,
+        (Style.ShadowOffset.Y > 0.0f) ? Style.ShadowOffset.Y * AllottedGeometry.Scale : 0.0f);
+    const FVector2D DrawTextOffset(
+        (Style.ShadowOffset.X < 0.0f) ? -Style.ShadowOffset.X * AllottedGeometry.Scale : 0.0f,
+        (Style.ShadowOffset.Y < 0.0f) ? -Style.ShadowOffset.Y * AllottedGeometry.Scale : 0.0f);
+
+    // Shape the whole line view (rather than the run range) so that text that spans runs is still shaped correctly
+    const FShapedGlyphSequenceRef ShapedText = ShapedTextCacheUtil::GetShapedTextSubSequence(
+        BlockTextContext.ShapedTextCache,
+        FCachedShapedTextKey(Line.Range, AllottedGeometry.GetAccumulatedLayoutTransform().GetScale(), BlockTextContext, Style.Font),
+        BlockRange,
+        **Text,
+        BlockTextContext.TextDirection);
+
+    const FLinearColor OutlineColor = InWidgetStyle.GetColorAndOpacityTint() * Style.Font.OutlineSettings.OutlineColor;
+
+    const bool bShouldDropShadow = Style.ShadowColorAndOpacity.A > 0.f && Style.ShadowOffset.SizeSquared() > 0.f;
+    if (bShouldDropShadow)
+    {
+        FSlateDrawElement::MakeShapedText(
+            OutDrawElements,
+            ++LayerId,
+            AllottedGeometry.ToPaintGeometry(TransformVector(InverseScale, Block->GetSize()), FSlateLayoutTransform(TransformPoint(InverseScale, Block->GetLocationOffset() + DrawShadowOffset))),
+            ShapedText,
+            DrawEffects,
+            InWidgetStyle.GetColorAndOpacityTint() * Style.ShadowColorAndOpacity,
+            OutlineColor);
+    }
+
+    FSlateDrawElement::MakeShapedText(
+        OutDrawElements,
+        ++LayerId,
+        AllottedGeometry.ToPaintGeometry(TransformVector(InverseScale, Block->GetSize()), FSlateLayoutTransform(TransformPoint(InverseScale, Block->GetLocationOffset() + DrawTextOffset))),
+        ShapedText,
+        DrawEffects,
+        InWidgetStyle.GetColorAndOpacityTint() * Style.ColorAndOpacity.GetColor(InWidgetStyle),
+        OutlineColor);
+
+    return LayerId;
+}
+
+const TArray<TSharedRef<SWidget>>& FQCE_TextRun::GetChildren()
+{
+    static const TArray<TSharedRef<SWidget>> NoChildren;
+    return NoChildren;
+}
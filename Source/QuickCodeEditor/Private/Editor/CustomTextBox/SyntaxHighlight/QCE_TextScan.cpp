@@ -0,0 +1,289 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_TextScan.h"
+
+#include <atomic>
+
+#define QCE_TEXTSCAN_SSE2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && !PLATFORM_TCHAR_IS_4_BYTES)
+#if QCE_TEXTSCAN_SSE2 && defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2
+#define QCE_TEXTSCAN_AVX2 1
+#else
+#define QCE_TEXTSCAN_AVX2 0
+#endif
+
+#if QCE_TEXTSCAN_SSE2
+#include <emmintrin.h>
+#endif
+#if QCE_TEXTSCAN_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	std::atomic<bool> bForceScalarScan { false };
+
+#if QCE_TEXTSCAN_SSE2
+	/** 8 x 16-bit lanes */
+	struct FSse2Lanes
+	{
+		using FVector = __m128i;
+		static constexpr int32 NumLanes = 8;
+
+		/** MoveMask gives two bits per lane */
+		static constexpr uint32 FullMask = 0xFFFFu;
+
+		static FORCEINLINE FVector Load(const TCHAR* Text) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Text)); }
+		static FORCEINLINE FVector Splat(const uint16 Value) { return _mm_set1_epi16(static_cast<short>(Value)); }
+		static FORCEINLINE FVector Equal(const FVector A, const FVector B) { return _mm_cmpeq_epi16(A, B); }
+		static FORCEINLINE FVector Or(const FVector A, const FVector B) { return _mm_or_si128(A, B); }
+		static FORCEINLINE FVector Sub(const FVector A, const FVector B) { return _mm_sub_epi16(A, B); }
+
+		/** Lanes where A <= B, comparing as unsigned: the saturating difference is zero exactly then */
+		static FORCEINLINE FVector LessOrEqual(const FVector A, const FVector B) { return _mm_cmpeq_epi16(_mm_subs_epu16(A, B), _mm_setzero_si128()); }
+
+		static FORCEINLINE uint32 MoveMask(const FVector A) { return static_cast<uint32>(_mm_movemask_epi8(A)); }
+	};
+#endif
+
+#if QCE_TEXTSCAN_AVX2
+	/** 16 x 16-bit lanes */
+	struct FAvx2Lanes
+	{
+		using FVector = __m256i;
+		static constexpr int32 NumLanes = 16;
+		static constexpr uint32 FullMask = 0xFFFFFFFFu;
+
+		static FORCEINLINE FVector Load(const TCHAR* Text) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Text)); }
+		static FORCEINLINE FVector Splat(const uint16 Value) { return _mm256_set1_epi16(static_cast<short>(Value)); }
+		static FORCEINLINE FVector Equal(const FVector A, const FVector B) { return _mm256_cmpeq_epi16(A, B); }
+		static FORCEINLINE FVector Or(const FVector A, const FVector B) { return _mm256_or_si256(A, B); }
+		static FORCEINLINE FVector Sub(const FVector A, const FVector B) { return _mm256_sub_epi16(A, B); }
+		static FORCEINLINE FVector LessOrEqual(const FVector A, const FVector B) { return _mm256_cmpeq_epi16(_mm256_subs_epu16(A, B), _mm256_setzero_si256()); }
+		static FORCEINLINE uint32 MoveMask(const FVector A) { return static_cast<uint32>(_mm256_movemask_epi8(A)); }
+	};
+#endif
+
+	/** Lanes of C within [First, First + Count) */
+	template <typename Lanes>
+	FORCEINLINE typename Lanes::FVector InRange(const typename Lanes::FVector C, const uint16 First, const uint16 Count)
+	{
+		return Lanes::LessOrEqual(Lanes::Sub(C, Lanes::Splat(First)), Lanes::Splat(Count - 1));
+	}
+
+	/** ASCII letters, folded to lower case: OR-ing 0x20 only lands in a-z for characters that were in A-Z or a-z */
+	template <typename Lanes>
+	FORCEINLINE typename Lanes::FVector IsAlphaLanes(const typename Lanes::FVector C)
+	{
+		return InRange<Lanes>(Lanes::Or(C, Lanes::Splat(0x20)), TEXT('a'), 26);
+	}
+
+	FORCEINLINE bool IsAlphaChar(const TCHAR C)
+	{
+		return (C >= TEXT('a') && C <= TEXT('z')) || (C >= TEXT('A') && C <= TEXT('Z'));
+	}
+
+	FORCEINLINE bool IsDigitChar(const TCHAR C)
+	{
+		return C >= TEXT('0') && C <= TEXT('9');
+	}
+
+	/** Character classes, each with a scalar test and the same test on a vector of lanes */
+	struct FQuoteOrBackslashClass
+	{
+		TCHAR Quote;
+
+		FORCEINLINE bool Scalar(const TCHAR C) const { return C == Quote || C == TEXT('\\'); }
+
+		template <typename Lanes>
+		FORCEINLINE typename Lanes::FVector Vector(const typename Lanes::FVector C) const
+		{
+			return Lanes::Or(Lanes::Equal(C, Lanes::Splat(Quote)), Lanes::Equal(C, Lanes::Splat(TEXT('\\'))));
+		}
+	};
+
+	struct FSingleCharClass
+	{
+		TCHAR Char;
+
+		FORCEINLINE bool Scalar(const TCHAR C) const { return C == Char; }
+
+		template <typename Lanes>
+		FORCEINLINE typename Lanes::FVector Vector(const typename Lanes::FVector C) const
+		{
+			return Lanes::Equal(C, Lanes::Splat(Char));
+		}
+	};
+
+	struct FAlphaClass
+	{
+		FORCEINLINE bool Scalar(const TCHAR C) const { return IsAlphaChar(C); }
+
+		template <typename Lanes>
+		FORCEINLINE typename Lanes::FVector Vector(const typename Lanes::FVector C) const
+		{
+			return IsAlphaLanes<Lanes>(C);
+		}
+	};
+
+	struct FIdentifierClass
+	{
+		FORCEINLINE bool Scalar(const TCHAR C) const { return IsAlphaChar(C) || IsDigitChar(C) || C == TEXT('_'); }
+
+		template <typename Lanes>
+		FORCEINLINE typename Lanes::FVector Vector(const typename Lanes::FVector C) const
+		{
+			return Lanes::Or(Lanes::Or(IsAlphaLanes<Lanes>(C), InRange<Lanes>(C, TEXT('0'), 10)), Lanes::Equal(C, Lanes::Splat(TEXT('_'))));
+		}
+	};
+
+	struct FNumberClass
+	{
+		FORCEINLINE bool Scalar(const TCHAR C) const
+		{
+			const TCHAR Lower = C | 0x20;
+			return IsDigitChar(C) || C == TEXT('.') || C == TEXT('+') || C == TEXT('-') ||
+				(IsAlphaChar(C) && (Lower == TEXT('f') || Lower == TEXT('u') || Lower == TEXT('l') || Lower == TEXT('x') || Lower == TEXT('e')));
+		}
+
+		template <typename Lanes>
+		FORCEINLINE typename Lanes::FVector Vector(const typename Lanes::FVector C) const
+		{
+			const typename Lanes::FVector Symbols = Lanes::Or(Lanes::Or(InRange<Lanes>(C, TEXT('0'), 10), Lanes::Equal(C, Lanes::Splat(TEXT('.')))),
+				Lanes::Or(Lanes::Equal(C, Lanes::Splat(TEXT('+'))), Lanes::Equal(C, Lanes::Splat(TEXT('-')))));
+
+			// Folding to lower case is only safe on letters, and the suffix letters are all letters
+			const typename Lanes::FVector Lower = Lanes::Or(C, Lanes::Splat(0x20));
+			const typename Lanes::FVector Suffixes = Lanes::Or(Lanes::Or(Lanes::Equal(Lower, Lanes::Splat(TEXT('f'))), Lanes::Equal(Lower, Lanes::Splat(TEXT('u')))),
+				Lanes::Or(Lanes::Or(Lanes::Equal(Lower, Lanes::Splat(TEXT('l'))), Lanes::Equal(Lower, Lanes::Splat(TEXT('x')))), Lanes::Equal(Lower, Lanes::Splat(TEXT('e')))));
+
+			return Lanes::Or(Symbols, Suffixes);
+		}
+	};
+
+#if QCE_TEXTSCAN_SSE2
+	/**
+	 * Advances InOutIndex one full vector at a time until a lane's class membership equals bMember.
+	 * Returns true with InOutIndex on that character, or false with InOutIndex on the first character left for the scalar tail.
+	 */
+	template <typename Lanes, bool bMember, typename FClass>
+	FORCEINLINE bool FindVector(const TCHAR* Text, int32& InOutIndex, const int32 End, const FClass& Class)
+	{
+		for (; InOutIndex + Lanes::NumLanes <= End; InOutIndex += Lanes::NumLanes)
+		{
+			uint32 Mask = Lanes::MoveMask(Class.template Vector<Lanes>(Lanes::Load(Text + InOutIndex)));
+			if (!bMember)
+			{
+				Mask = ~Mask & Lanes::FullMask;
+			}
+
+			if (Mask != 0)
+			{
+				InOutIndex += FMath::CountTrailingZeros(Mask) / 2;
+				return true;
+			}
+		}
+		return false;
+	}
+#endif
+
+	/** Returns the index of the first character in [Start, End) whose class membership equals bMember, or End */
+	template <bool bMember, typename FClass>
+	FORCEINLINE int32 Find(const TCHAR* Text, const int32 Start, const int32 End, const FClass& Class)
+	{
+		int32 Index = Start;
+
+#if QCE_TEXTSCAN_SSE2
+		if (!bForceScalarScan.load(std::memory_order_relaxed))
+		{
+#if QCE_TEXTSCAN_AVX2
+			if (FindVector<FAvx2Lanes, bMember>(Text, Index, End, Class))
+			{
+				return Index;
+			}
+#endif
+			if (FindVector<FSse2Lanes, bMember>(Text, Index, End, Class))
+			{
+				return Index;
+			}
+		}
+#endif
+
+		while (Index < End && Class.Scalar(Text[Index]) != bMember)
+		{
+			Index++;
+		}
+		return Index;
+	}
+}
+
+int32 FQCE_TextScan::FindQuotedEnd(const TCHAR* Text, const int32 Start, const int32 End, const TCHAR Quote)
+{
+	int32 Index = Start;
+	while (true)
+	{
+		Index = Find<true>(Text, Index, End, FQuoteOrBackslashClass{ Quote });
+		if (Index >= End)
+		{
+			return End;
+		}
+
+		if (Text[Index] != TEXT('\\'))
+		{
+			return Index + 1;
+		}
+
+		// Skip the backslash and the character it escapes
+		Index += 2;
+	}
+}
+
+int32 FQCE_TextScan::FindBlockCommentEnd(const TCHAR* Text, const int32 Start, const int32 End)
+{
+	// The delimiter is two characters long, so it can only start before the last character
+	const int32 LastStart = End - 1;
+	int32 Index = Start;
+	while (Index < LastStart)
+	{
+		Index = Find<true>(Text, Index, LastStart, FSingleCharClass{ TEXT('*') });
+		if (Index >= LastStart)
+		{
+			break;
+		}
+
+		if (Text[Index + 1] == TEXT('/'))
+		{
+			return Index + 2;
+		}
+		Index++;
+	}
+	return INDEX_NONE;
+}
+
+int32 FQCE_TextScan::SkipIdentifierChars(const TCHAR* Text, const int32 Start, const int32 End)
+{
+	return Find<false>(Text, Start, End, FIdentifierClass());
+}
+
+int32 FQCE_TextScan::SkipAlphaChars(const TCHAR* Text, const int32 Start, const int32 End)
+{
+	return Find<false>(Text, Start, End, FAlphaClass());
+}
+
+int32 FQCE_TextScan::SkipNumberChars(const TCHAR* Text, const int32 Start, const int32 End)
+{
+	return Find<false>(Text, Start, End, FNumberClass());
+}
+
+bool FQCE_TextScan::IsVectorized()
+{
+#if QCE_TEXTSCAN_SSE2
+	return !bForceScalarScan.load(std::memory_order_relaxed);
+#else
+	return false;
+#endif
+}
+
+void FQCE_TextScan::SetForceScalar(const bool bInForceScalar)
+{
+	bForceScalarScan.store(bInForceScalar, std::memory_order_relaxed);
+}
@@ -4,17 +4,19 @@
 
 #include "QuickCodeEditor.h"
 
-#include "Misc/FileHelper.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Modules/ModuleManager.h"
 #include "SourceCodeNavigation.h"
 #include "Editor/CustomTextBox/GenerateDefinition/QCE_GenerateDefinitionHelpers.h"
 #include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_CommonIOHelpers.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
 #include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ParameterMatcher.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ProjectSymbolIndex.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SourceFileCache.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SymbolTable.h"
 #include "UObject/Script.h"
 #include "UObject/UnrealType.h"
-#include "Misc/CRC.h"
 
 FFunctionCppReader::FFunctionCppReader()
 {
@@ -29,13 +31,13 @@ bool FFunctionCppReader::GetFunctionDeclaration(const UFunction* Function, FFunc
         return true;
     }
         
-    FString FileContent;
-    FString HeaderPath;
-    if (!ReadCppFileContent(Function, FileContent, HeaderPath, QCE_CppFileType::Header))
+    const TSharedPtr<const FQCE_SourceFile> HeaderFile = ReadCppFile(Function, QCE_CppFileType::Header);
+    if (!HeaderFile.IsValid())
         return false;
 
-    OutDeclarationInfo.HeaderPath = HeaderPath;
-    OutDeclarationInfo.ContentChecksum = FCrc::StrCrc32(*FileContent);
+    const FString& FileContent = HeaderFile->GetContent();
+    OutDeclarationInfo.HeaderPath = HeaderFile->GetPath();
+    OutDeclarationInfo.ContentChecksum = HeaderFile->GetChecksum();
     OutDeclarationInfo.InitialFileContent = FileContent;
     OutDeclarationInfo.ClassName = QCE_CommonIOHelpers::ExtractClassNameFromDeclarationFile(FileContent);
     
@@ -56,17 +58,24 @@ bool FFunctionCppReader::GetFunctionImplementation(const UFunction* Function, FF
         return true;
     }
     
-    FString CppPath;
-    FString FileContent;
-    if (!ReadCppFileContent(Function, FileContent, CppPath, QCE_CppFileType::Implementation))
-        return false;
+    const TSharedPtr<const FQCE_SourceFile> CppFile = ReadCppFile(Function, QCE_CppFileType::Implementation);
+    if (!CppFile.IsValid())
+    {
+        // A class without a source file of its own name can still have its functions implemented elsewhere
+        if (!ParseImplementationFromProjectIndex(Function, FString(), OutImplementationInfo))
+            return false;
 
-    OutImplementationInfo.CppPath = CppPath;
-    OutImplementationInfo.ContentChecksum = FCrc::StrCrc32(*FileContent);
-    OutImplementationInfo.InitialFileContent = FileContent;
+        LoadedImplementationInfo = OutImplementationInfo;
+        return true;
+    }
+
+    OutImplementationInfo.CppPath = CppFile->GetPath();
+    OutImplementationInfo.ContentChecksum = CppFile->GetChecksum();
+    OutImplementationInfo.InitialFileContent = CppFile->GetContent();
     
     
-    bool bIsImplementationParsed = ParseImplementation(Function, OutImplementationInfo, CppPath);
+    bool bIsImplementationParsed = ParseImplementation(Function, CppFile->GetContent(), OutImplementationInfo)
+        || ParseImplementationFromProjectIndex(Function, CppFile->GetPath(), OutImplementationInfo);
     if (!bIsImplementationParsed)
     {
         OutImplementationInfo.FunctionImplementation = OutImplementationInfo.InitialFileContent;
@@ -96,15 +105,11 @@ bool FFunctionCppReader::ParseDeclaration(const UFunction* Function, const FStri
     return true;
 }
 
-bool FFunctionCppReader::ParseImplementation(const UFunction* Function, FFunctionImplementationInfo& OutImplementationInfo, FString& OutCppPath)
+bool FFunctionCppReader::ParseImplementation(const UFunction* Function, const FString& FileContent, FFunctionImplementationInfo& OutImplementationInfo)
 {
     FFunctionDeclarationInfo DeclarationInfo;
     if (!GetFunctionDeclaration(Function, DeclarationInfo))
         return false;
-    
-    FString FileContent;
-    if (!ReadCppFileContent(Function, FileContent, OutCppPath, QCE_CppFileType::Implementation))
-        return false;
 
     // Try to find the function implementation start position
     int32 FuncPos;
@@ -149,7 +154,6 @@ bool FFunctionCppReader::ParseImplementation(const UFunction* Function, FFunctio
     // Fill out implementation info
     OutImplementationInfo.FunctionName = DeclarationInfo.FunctionName;
     OutImplementationInfo.Parameters = QCE_ParameterMatcher::ToParameterArray(ParameterString);
-    OutImplementationInfo.CppPath = OutCppPath;
     OutImplementationInfo.bIsConst = QCE_CommonIOHelpers::HasConstModifier(ImplementationLine);
     OutImplementationInfo.FunctionImplementation = FileContent.Mid(HeaderStartPos, CloseBracePos - HeaderStartPos + 1);
     
@@ -160,39 +164,77 @@ bool FFunctionCppReader::ParseImplementation(const UFunction* Function, FFunctio
     return true;
 }
 
+bool FFunctionCppReader::ParseImplementationFromProjectIndex(const UFunction* Function, const FString& SkippedPath, FFunctionImplementationInfo& OutImplementationInfo)
+{
+    if (!Function || !Function->GetOwnerClass() || !QCE_CommonIOHelpers::ValidateFunctionFlags(Function))
+        return false;
+
+    const FQuickCodeEditorModule& QCEModule = FModuleManager::GetModuleChecked<FQuickCodeEditorModule>("QuickCodeEditor");
+    const FQCE_ProjectSymbolIndex* SymbolIndex = QCEModule.GetProjectSymbolIndex();
+    if (!SymbolIndex)
+        return false;
+
+    TArray<FString> CandidatePaths;
+    SymbolIndex->FindDefinitionFiles(Function->GetName(), Function->GetOwnerClass()->GetName(), CandidatePaths);
+
+    for (const FString& CandidatePath : CandidatePaths)
+    {
+        if (CandidatePath.Equals(SkippedPath, ESearchCase::CaseSensitive))
+            continue;
+
+        const TSharedPtr<const FQCE_SourceFile> CandidateFile = FQCE_SourceFileCache::Get(CandidatePath);
+        if (!CandidateFile.IsValid())
+            continue;
+
+        FFunctionImplementationInfo CandidateInfo;
+        if (!ParseImplementation(Function, CandidateFile->GetContent(), CandidateInfo))
+            continue;
+
+        CandidateInfo.CppPath = CandidateFile->GetPath();
+        CandidateInfo.ContentChecksum = CandidateFile->GetChecksum();
+        CandidateInfo.InitialFileContent = CandidateFile->GetContent();
+        OutImplementationInfo = MoveTemp(CandidateInfo);
+
+        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found implementation of function '%s' in '%s' through the project symbol index"), *Function->GetName(), *CandidatePath);
+        return true;
+    }
+
+    return false;
+}
+
 bool FFunctionCppReader::FindDeclarationPositionInFile(const FString& FileContent, const UFunction* Function, int32& OutFunctionPosition)
 {
     const FString FunctionName = Function->GetName();
     
-    TArray<int32> PossibleMatchPositions;
-    if (!QCE_CommonIOHelpers::FilterPositionsByName(FileContent, FunctionName, PossibleMatchPositions))
+    TArray<const FQCE_FunctionSymbol*> Symbols;
+    FQCE_SymbolTable::Get(FileContent)->FindFunctions(FunctionName, Symbols);
+    if (Symbols.Num() == 0)
     {
         UE_LOG(LogQuickCodeEditor, Warning, TEXT("Function '%s' not found in file content"), *FunctionName);
         return false;
     }
     
-    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found %d name matches for function '%s'"), PossibleMatchPositions.Num(), *FunctionName);
-    
-    TArray<int32> NonCommentMatches;
-    if (!QCE_CommonIOHelpers::FilterCommentedPositions(FileContent, PossibleMatchPositions, NonCommentMatches))
+    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found %d declarations of function '%s'"), Symbols.Num(), *FunctionName);
+
+    TArray<const FQCE_FunctionSymbol*> NativeMatches;
+    for (const FQCE_FunctionSymbol* Symbol : Symbols)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("All %d name matches for function '%s' were in comments"), PossibleMatchPositions.Num(), *FunctionName);
-        return false;
+        if (Symbol->HasUFunction())
+        {
+            NativeMatches.Add(Symbol);
+        }
     }
-    
-    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("After comment filtering: %d matches for function '%s'"), NonCommentMatches.Num(), *FunctionName);
 
-    TArray<int32> NativeMatches;
-    if (!QCE_CommonIOHelpers::FilterNativeFunctionPositions(FileContent, NonCommentMatches, NativeMatches))
+    if (NativeMatches.Num() == 0)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("None of the %d non-comment matches for function '%s' have UFUNCTION macros"), NonCommentMatches.Num(), *FunctionName);
+        UE_LOG(LogQuickCodeEditor, Warning, TEXT("None of the %d declarations of function '%s' have UFUNCTION macros"), Symbols.Num(), *FunctionName);
         return false;
     }
     
     UE_LOG(LogQuickCodeEditor, Verbose, TEXT("After UFUNCTION filtering: %d matches for function '%s'"), NativeMatches.Num(), *FunctionName);
 
-    TArray<int32> TypeMatches;
-    if (!FilterPositionsByMatchingNodeParams(FileContent, NativeMatches, Function, TypeMatches))
+    TArray<const FQCE_FunctionSymbol*> TypeMatches;
+    if (!FilterSymbolsByMatchingNodeParams(NativeMatches, Function, TypeMatches))
     {
         UE_LOG(LogQuickCodeEditor, Warning, TEXT("None of the %d UFUNCTION matches for function '%s' have matching parameter types"), NativeMatches.Num(), *FunctionName);
         return false;
@@ -207,7 +249,7 @@ bool FFunctionCppReader::FindDeclarationPositionInFile(const FString& FileConten
         return false;
     }
     
-    OutFunctionPosition = TypeMatches[0];
+    OutFunctionPosition = TypeMatches[0]->NamePosition;
     return true;
 }
 
@@ -228,10 +270,11 @@ bool FFunctionCppReader::FilterPositionsByParamNum(const FString& FileContent, c
     TArray<FString> FoundParameterStrings;
     
     // Filter only positions which have same number of parameters as node
+    const TSharedRef<const FQCE_LexicalMask> Mask = FQCE_LexicalMask::Get(FileContent);
     for (int32 MatchPos : PossibleMatchPositions)
     {
         FString ParameterString;
-        if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, MatchPos, ParameterString))
+        if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, *Mask, MatchPos, ParameterString))
         {
             UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Could not extract parameter string at position %d for function '%s'"), MatchPos, *FunctionName);
             continue;
@@ -267,7 +310,7 @@ bool FFunctionCppReader::FilterPositionsByParamNum(const FString& FileContent, c
     return OutParameterMatches.Num() != 0;
 }
 
-bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const UFunction* Function, TArray<int32>& OutTypeMatches)
+bool FFunctionCppReader::FilterSymbolsByMatchingNodeParams(const TArray<const FQCE_FunctionSymbol*>& Symbols, const UFunction* Function, TArray<const FQCE_FunctionSymbol*>& OutTypeMatches)
 {
     TArray<TPair<FString, bool>> ExpectedNodeParamsWithRef = QCE_CommonIOHelpers::GetExpectedParameterSignature(Function);
     TArray<FString> ExpectedNodeParams;
@@ -279,17 +322,11 @@ bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& File
     const FString FunctionName = Function->GetName();
     UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Function '%s' expects %d parameter types"), *FunctionName, ExpectedNodeParams.Num());
     
-    TArray<FString> FoundParameterStrings;
-    for (int32 MatchPos : PossibleMatchPositions)
+    for (const FQCE_FunctionSymbol* Symbol : Symbols)
     {
-        FString FoundParameterString;
-        if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, MatchPos, FoundParameterString))
-        {
-            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Could not extract parameter string at position %d for function '%s'"), MatchPos, *FunctionName);
-            continue;
-        }
-        
-        TArray<FString> FoundCodeParams = QCE_ParameterMatcher::ToParameterArray(FoundParameterString);
+        // Already split and normalized by the symbol table, the parameter list is not read from the text again
+        const int32 MatchPos = Symbol->NamePosition;
+        const TArray<FString>& FoundCodeParams = Symbol->Parameters;
         
         if (FoundCodeParams.Num() != ExpectedNodeParams.Num())
         {
@@ -312,8 +349,7 @@ bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& File
 
         if (bTypesMatch)
         {
-            OutTypeMatches.Add(MatchPos);
-            FoundParameterStrings.Add(FoundParameterString);
+            OutTypeMatches.Add(Symbol);
             UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Parameter type match at position %d for function '%s'"), MatchPos, *FunctionName);
         }
         else
@@ -332,8 +368,7 @@ bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& File
             }
             if (bTypesMatch)
             {
-                OutTypeMatches.Add(MatchPos);
-                FoundParameterStrings.Add(FoundParameterString);
+                OutTypeMatches.Add(Symbol);
                 UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Parameter type match at position %d for function '%s'"), MatchPos, *FunctionName);
             }
         }
@@ -350,10 +385,10 @@ bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& File
     }
     else if (OutTypeMatches.Num() > 1)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Found %d parameter type matches for function '%s'. All parameter strings:"), OutTypeMatches.Num(), *FunctionName);
-        for (int32 i = 0; i < FoundParameterStrings.Num(); ++i)
+        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Found %d parameter type matches for function '%s'. All parameter lists:"), OutTypeMatches.Num(), *FunctionName);
+        for (int32 i = 0; i < OutTypeMatches.Num(); ++i)
         {
-            UE_LOG(LogQuickCodeEditor, Warning, TEXT("  Match %d at position %d for function '%s': '%s'"), i + 1, OutTypeMatches[i], *FunctionName, *FoundParameterStrings[i]);
+            UE_LOG(LogQuickCodeEditor, Warning, TEXT("  Match %d at position %d for function '%s': '%s'"), i + 1, OutTypeMatches[i]->NamePosition, *FunctionName, *FString::Join(OutTypeMatches[i]->Parameters, TEXT(", ")));
         }
     }
     
@@ -361,43 +396,41 @@ bool FFunctionCppReader::FilterPositionsByMatchingNodeParams(const FString& File
 }
 
 
-bool FFunctionCppReader::ReadCppFileContent(const UFunction* Function, FString& FileContent, FString& OutFilePath, QCE_CppFileType FileType)
+TSharedPtr<const FQCE_SourceFile> FFunctionCppReader::ReadCppFile(const UFunction* Function, QCE_CppFileType FileType)
 {
     if (!Function || !Function->GetOwnerClass())
-        return false;
+        return nullptr;
     
     // Validate function flags before proceeding with search
     if (!QCE_CommonIOHelpers::ValidateFunctionFlags(Function))
-        return false;
+        return nullptr;
     
+    FString FilePath;
     if (FileType == QCE_CppFileType::Header)
     {
-        if (!FSourceCodeNavigation::FindClassHeaderPath(Function->GetOwnerClass(), OutFilePath))
+        if (!FSourceCodeNavigation::FindClassHeaderPath(Function->GetOwnerClass(), FilePath))
         {
             UE_LOG(LogQuickCodeEditor, Error, TEXT("Could not load header file for %s"),
                    *Function->GetOwnerClass()->GetName());
-            return false;
+            return nullptr;
         }
     }
     else if (FileType == QCE_CppFileType::Implementation)
     {
-        if (!FSourceCodeNavigation::FindClassSourcePath(Function->GetOwnerClass(), OutFilePath))
+        if (!FSourceCodeNavigation::FindClassSourcePath(Function->GetOwnerClass(), FilePath))
         {
             UE_LOG(LogQuickCodeEditor, Error, TEXT("Could not load source file for %s"), *Function->GetOwnerClass()->GetName());
-            return false;
+            return nullptr;
         } 
     }
     else
     {
-        return false;
+        return nullptr;
     }
    
 
-    // Read the header file content
-    if (!FFileHelper::LoadFileToString(FileContent, *OutFilePath))
-        return false;
-
-    return true;
+    // Only reads the file if it is not cached or changed on disk
+    return FQCE_SourceFileCache::Get(FilePath);
 }
 
 
@@ -424,16 +457,16 @@ bool FFunctionCppReader::HasFunctionDeclarationChangedOnDisk(const UFunction* Fu
         return true; // Consider it changed if paths don't match
     }
 
-    // Read current file content from disk
-    FString DiskContent;
-    if (!FFileHelper::LoadFileToString(DiskContent, *HeaderPath))
+    // Only reads the file again if its size or modification time changed
+    const TSharedPtr<const FQCE_SourceFile> DiskFile = FQCE_SourceFileCache::Get(HeaderPath);
+    if (!DiskFile.IsValid())
     {
         UE_LOG(LogQuickCodeEditor, Warning, TEXT("Failed to read header file '%s' from disk"), *HeaderPath);
         return false; // If we can't read the file, assume no change to avoid false positives
     }
 
-    // Calculate and compare checksums
-    const uint32 DiskChecksum = FCrc::StrCrc32(*DiskContent);
+    // Compare checksums
+    const uint32 DiskChecksum = DiskFile->GetChecksum();
     const bool bHasChanged = DiskChecksum != DeclarationInfo.ContentChecksum;
 
     if (bHasChanged)
@@ -460,16 +493,16 @@ bool FFunctionCppReader::HasFunctionImplementationChangedOnDisk(const UFunction*
         return true; // Consider it changed if paths don't match
     }
 
-    // Read current file content from disk
-    FString DiskContent;
-    if (!FFileHelper::LoadFileToString(DiskContent, *CppPath))
+    // Only reads the file again if its size or modification time changed
+    const TSharedPtr<const FQCE_SourceFile> DiskFile = FQCE_SourceFileCache::Get(CppPath);
+    if (!DiskFile.IsValid())
     {
         UE_LOG(LogQuickCodeEditor, Warning, TEXT("Failed to read implementation file '%s' from disk"), *CppPath);
         return false; // If we can't read the file, assume no change to avoid false positives
     }
 
-    // Calculate and compare checksums
-    const uint32 DiskChecksum = FCrc::StrCrc32(*DiskContent);
+    // Compare checksums
+    const uint32 DiskChecksum = DiskFile->GetChecksum();
     const bool bHasChanged = DiskChecksum != CurrentImplementationInfo.ContentChecksum;
 
     if (bHasChanged)
@@ -9,6 +9,7 @@
 #include "Misc/FileHelper.h"
 #include "Misc/CRC.h"
 #include "QuickCodeEditor.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SourceFileCache.h"
 
 bool FFunctionCppWriter::WriteFunctionDeclaration(const FFunctionDeclarationInfo& DeclarationInfo,
     const FString& UpdatedDeclarationCode, const bool bIsLoadedIsolated, const bool bForceOverwrite)
@@ -86,6 +87,9 @@ bool FFunctionCppWriter::WriteFunctionDeclaration(const FFunctionDeclarationInfo
     }
   
 
+    // Whatever the write ends up doing, the cached copy of the file is stale
+    FQCE_SourceFileCache::Invalidate(DeclarationInfo.HeaderPath);
+
     // Write the updated content to file
     if (!FFileHelper::SaveStringToFile(NewFileContent, *DeclarationInfo.HeaderPath))
     {
@@ -180,6 +184,9 @@ bool FFunctionCppWriter::WriteFunctionImplementation(const FFunctionImplementati
     }
    
 
+    // Whatever the write ends up doing, the cached copy of the file is stale
+    FQCE_SourceFileCache::Invalidate(ImplementationInfo.CppPath);
+
     // Write the updated content to file
     if (!FFileHelper::SaveStringToFile(NewFileContent, *ImplementationInfo.CppPath))
     {
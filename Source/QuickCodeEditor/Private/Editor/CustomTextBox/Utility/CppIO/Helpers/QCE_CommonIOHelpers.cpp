@@ -3,7 +3,10 @@
 
 #include "QuickCodeEditor.h"
 #include "Editor/CustomTextBox/GenerateDefinition/QCE_GenerateDefinitionHelpers.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
 #include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ParameterMatcher.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SourceFileCache.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SymbolTable.h"
 
 #include "Misc/FileHelper.h"
 #include "HAL/FileManager.h"
@@ -55,9 +58,10 @@ bool QCE_CommonIOHelpers::FilterPositionsByName(const FString& FileContent, cons
 
 bool QCE_CommonIOHelpers::FilterCommentedPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, TArray<int32>& OutNonCommentMatches)
 {
+    const TSharedRef<const FQCE_LexicalMask> Mask = FQCE_LexicalMask::Get(FileContent);
     for (int32 MatchPos : PossibleMatchPositions)
     {
-        if (!IsPositionInComment(FileContent, MatchPos))
+        if (!IsPositionInComment(*Mask, MatchPos))
         {
             OutNonCommentMatches.Add(MatchPos);
         }
@@ -66,82 +70,14 @@ bool QCE_CommonIOHelpers::FilterCommentedPositions(const FString& FileContent, c
     return OutNonCommentMatches.Num() != 0;
 }
 
-bool QCE_CommonIOHelpers::FilterNativeFunctionPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, TArray<int32>& OutUFunctionMatches)
-{
-    for (int32 MatchPos : PossibleMatchPositions)
-    {
-        FString UFunctionString;
-        int32 MacroStartPos;
-        if (FunctionHasUFunction(FileContent, MatchPos, UFunctionString, MacroStartPos))
-        {
-            OutUFunctionMatches.Add(MatchPos);
-            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found UFUNCTION macro at position %d"), MatchPos);
-        }
-    }
-
-    return OutUFunctionMatches.Num() != 0;
-}
-
-bool QCE_CommonIOHelpers::FilterScopedFunctionPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const FString& ClassName, TArray<int32>& OutScopedMatches)
+bool QCE_CommonIOHelpers::IsPositionInComment(const FString& FileContent, int32 Position)
 {
-    // If ClassName is empty, all possible match positions are considered valid
-    if (ClassName.IsEmpty())
-    {
-        OutScopedMatches = PossibleMatchPositions;
-        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Empty class name provided - all %d positions considered valid scoped matches"), PossibleMatchPositions.Num());
-        return OutScopedMatches.Num() != 0;
-    }
-
-    for (int32 MatchPos : PossibleMatchPositions)
-    {
-        // Check if this match has the class scope before it
-        int32 ScopeStart = MatchPos - ClassName.Len() - 2; // -2 for "::"
-        if (ScopeStart >= 0)
-        {
-            FString ScopeCheck = FileContent.Mid(ScopeStart, ClassName.Len() + 2);
-            if (ScopeCheck == ClassName + TEXT("::"))
-            {
-                // Verify the scope operator is not inside a string or comment
-                if (!QCE_ParameterMatcher::IsPositionInStringOrComment(FileContent, ScopeStart + ClassName.Len()))
-                {
-                    OutScopedMatches.Add(MatchPos);
-                    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found scoped match at position %d for class '%s'"), MatchPos, *ClassName);
-                }
-            }
-        }
-    }
-
-    return OutScopedMatches.Num() != 0;
+    return IsPositionInComment(*FQCE_LexicalMask::Get(FileContent), Position);
 }
 
-bool QCE_CommonIOHelpers::IsPositionInComment(const FString& FileContent, int32 Position)
+bool QCE_CommonIOHelpers::IsPositionInComment(const FQCE_LexicalMask& Mask, int32 Position)
 {
-    // Check for single-line comment
-    int32 LineStart = Position;
-    while (LineStart > 0 && FileContent[LineStart - 1] != '\n')
-    {
-        LineStart--;
-    }
-
-    FString LineUpToPosition = FileContent.Mid(LineStart, Position - LineStart);
-    int32 SingleCommentPos = LineUpToPosition.Find(TEXT("//"));
-    if (SingleCommentPos != INDEX_NONE)
-    {
-        return true; // Position is after // on the same line
-    }
-
-    // Check for multi-line comment
-    int32 BlockCommentStart = FileContent.Find(TEXT("/*"), ESearchCase::CaseSensitive, ESearchDir::FromEnd, Position);
-    if (BlockCommentStart != INDEX_NONE)
-    {
-        int32 BlockCommentEnd = FileContent.Find(TEXT("*/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, BlockCommentStart);
-        if (BlockCommentEnd != INDEX_NONE && Position < BlockCommentEnd + 2)
-        {
-            return true; // Position is within /* */ block
-        }
-    }
-
-    return false;
+    return Mask.IsComment(Position);
 }
 
 bool QCE_CommonIOHelpers::FunctionHasUFunction(const FString& FileContent, int32 FunctionNamePos, FString& OutUFunctionString, int32& OutMacroStartPos)
@@ -284,16 +220,19 @@ bool QCE_CommonIOHelpers::ValidateFunctionFlags(const UFunction* Function)
 
 bool QCE_CommonIOHelpers::ReadFileContent(const FString& FilePath, FString& OutContent)
 {
-    if (!FFileHelper::LoadFileToString(OutContent, *FilePath))
+    const TSharedPtr<const FQCE_SourceFile> File = FQCE_SourceFileCache::Get(FilePath);
+    if (!File.IsValid())
     {
         UE_LOG(LogQuickCodeEditor, Error, TEXT("Failed to read file: %s"), *FilePath);
         return false;
     }
+    OutContent = File->GetContent();
     return true;
 }
 
 bool QCE_CommonIOHelpers::WriteFileContent(const FString& FilePath, const FString& Content)
 {
+    FQCE_SourceFileCache::Invalidate(FilePath);
     if (!FFileHelper::SaveStringToFile(Content, *FilePath))
     {
         UE_LOG(LogQuickCodeEditor, Error, TEXT("Failed to write file: %s"), *FilePath);
@@ -321,10 +260,15 @@ TArray<TPair<FString, bool>> QCE_CommonIOHelpers::GetExpectedParameterSignature(
 }
 
 bool QCE_CommonIOHelpers::DoesParameterSignatureMatch(const FString& FileContent, int32 Position, const UFunction* Function)
+{
+    return DoesParameterSignatureMatch(FileContent, *FQCE_LexicalMask::Get(FileContent), Position, Function);
+}
+
+bool QCE_CommonIOHelpers::DoesParameterSignatureMatch(const FString& FileContent, const FQCE_LexicalMask& Mask, int32 Position, const UFunction* Function)
 {
     // Extract parameter string from this position
     FString ParameterString;
-    if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, Position, ParameterString))
+    if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, Mask, Position, ParameterString))
     {
         return false;
     }
@@ -355,9 +299,10 @@ bool QCE_CommonIOHelpers::DoesParameterSignatureMatch(const FString& FileContent
 
 bool QCE_CommonIOHelpers::FilterPositionsByParameterSignature(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const UFunction* Function, TArray<int32>& OutSignatureMatches)
 {
+    const TSharedRef<const FQCE_LexicalMask> Mask = FQCE_LexicalMask::Get(FileContent);
     for (int32 MatchPos : PossibleMatchPositions)
     {
-        if (DoesParameterSignatureMatch(FileContent, MatchPos, Function))
+        if (DoesParameterSignatureMatch(FileContent, *Mask, MatchPos, Function))
         {
             OutSignatureMatches.Add(MatchPos);
             UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Parameter signature match at position %d for function '%s'"), MatchPos, *Function->GetName());
@@ -541,79 +486,49 @@ bool QCE_CommonIOHelpers::HasConstModifier(const FString& FunctionDeclaration)
     return PostParenPart.Contains(TEXT("const"));
 }
 
-bool QCE_CommonIOHelpers::DoesImplementationSignatureMatchDeclaration(const FString& FileContent, int32 FunctionNamePos, const FFunctionDeclarationInfo& DeclarationInfo)
+bool QCE_CommonIOHelpers::DoesImplementationSignatureMatchDeclaration(const FQCE_FunctionSymbol& Symbol, const FFunctionDeclarationInfo& DeclarationInfo)
 {
-    // Extract implementation parameters from the current position
-    FString ImplementationParameterList;
-    if (!QCE_ParameterMatcher::GetParameterStringAtPosition(FileContent, FunctionNamePos, ImplementationParameterList))
-        return false;
-    
-    TArray<FString> ImplementationParams = QCE_ParameterMatcher::ToParameterArray(ImplementationParameterList);
-        
     // Check if parameter count matches
-    if (DeclarationInfo.Parameters.Num() != ImplementationParams.Num())
+    if (DeclarationInfo.Parameters.Num() != Symbol.Parameters.Num())
     {
         return false;
     }
     
-    // Use QCE_ParameterMatcher to compare parameters
-    // TODO do a for loop like FilterPositionsByMatchingNodeParams
     // Check if parameter types match using individual comparison
     for (int32 i = 0; i < DeclarationInfo.Parameters.Num(); ++i)
     {
-        if (!QCE_ParameterMatcher::DoParameterTypesMatch(ImplementationParams[i], DeclarationInfo.Parameters[i]))
+        if (!QCE_ParameterMatcher::DoParameterTypesMatch(Symbol.Parameters[i], DeclarationInfo.Parameters[i]))
         {
             UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Parameter type mismatch at param %d: expected '%s', found '%s' for function '%s'"), 
-                   i, *DeclarationInfo.Parameters[i], *ImplementationParams[i], *DeclarationInfo.FunctionName);
+                   i, *DeclarationInfo.Parameters[i], *Symbol.Parameters[i], *DeclarationInfo.FunctionName);
             return false;
         }
     }
     
-    // Find the line containing this function to check modifiers
-    int32 LineStart = FunctionNamePos;
-    while (LineStart > 0 && FileContent[LineStart - 1] != '\n')
-    {
-        LineStart--;
-    }
-    
-    int32 LineEnd = FunctionNamePos;
-    while (LineEnd < FileContent.Len() && FileContent[LineEnd] != '{' && FileContent[LineEnd] != ';')
-    {
-        LineEnd++;
-    }
-    
-    FString ImplementationLine = FileContent.Mid(LineStart, LineEnd - LineStart);
-    
     // Check const-ness match
-    bool bImplementationIsConst = HasConstModifier(ImplementationLine);
-    if (bImplementationIsConst != DeclarationInfo.bIsConst)
-    {
-        return false;
-    }
-    
-    return true;
+    return Symbol.bIsConst == DeclarationInfo.bIsConst;
 }
 
-bool QCE_CommonIOHelpers::FilterPositionsBySignatureMatch(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const FFunctionDeclarationInfo& DeclarationInfo, TArray<int32>& OutSignatureMatches)
+bool QCE_CommonIOHelpers::FilterSymbolsBySignatureMatch(const TArray<const FQCE_FunctionSymbol*>& Symbols, const FFunctionDeclarationInfo& DeclarationInfo, TArray<const FQCE_FunctionSymbol*>& OutSignatureMatches)
 {
     const FString FunctionName = DeclarationInfo.FunctionName;
     
-    for (int32 MatchPos : PossibleMatchPositions)
+    for (const FQCE_FunctionSymbol* Symbol : Symbols)
     {
-        if (DoesImplementationSignatureMatchDeclaration(FileContent, MatchPos, DeclarationInfo))
+        if (DoesImplementationSignatureMatchDeclaration(*Symbol, DeclarationInfo))
         {
-            OutSignatureMatches.Add(MatchPos);
-            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Signature match found at position %d for function '%s'"), MatchPos, *FunctionName);
+            OutSignatureMatches.Add(Symbol);
+            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Signature match found at position %d for function '%s'"), Symbol->NamePosition, *FunctionName);
         }
         else
         {
-            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Signature mismatch at position %d for function '%s'"), MatchPos, *FunctionName);
+            UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Signature mismatch at position %d for function '%s'"), Symbol->NamePosition, *FunctionName);
         }
     }
     
     if (OutSignatureMatches.Num() == 0)
     {
-        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("No signature matches found for function '%s' among %d positions"), *FunctionName, PossibleMatchPositions.Num());
+        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("No signature matches found for function '%s' among %d positions"), *FunctionName, Symbols.Num());
     }
     
     return OutSignatureMatches.Num() != 0;
@@ -623,39 +538,49 @@ bool QCE_CommonIOHelpers::FindImplementationPositionInContent(const FString& Fil
 {
     const FString FunctionName = DeclarationInfo.FunctionName;
     
-    TArray<int32> PossibleMatchPositions;
-    if (!FilterPositionsByName(FileContent, FunctionName, PossibleMatchPositions))
+    TArray<const FQCE_FunctionSymbol*> Symbols;
+    FQCE_SymbolTable::Get(FileContent)->FindFunctions(FunctionName, Symbols);
+
+    // Only functions with a body can be the implementation, calls and comments never make it into the table
+    TArray<const FQCE_FunctionSymbol*> DefinitionMatches;
+    TArray<const FQCE_FunctionSymbol*> ScopedMatches;
+    for (const FQCE_FunctionSymbol* Symbol : Symbols)
     {
-        return false;
+        if (!Symbol->bIsDefinition)
+        {
+            continue;
+        }
+
+        DefinitionMatches.Add(Symbol);
+
+        // The owner class name comes without its prefix, "MyActor" has to match "AMyActor::"
+        if (ClassName.IsEmpty() || Symbol->ScopeName.EndsWith(ClassName, ESearchCase::CaseSensitive))
+        {
+            ScopedMatches.Add(Symbol);
+        }
     }
-    
-    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found %d name matches for function '%s' in implementation"), PossibleMatchPositions.Num(), *FunctionName);
 
-    TArray<int32> NonCommentMatches;
-    if (!FilterCommentedPositions(FileContent, PossibleMatchPositions, NonCommentMatches))
+    if (DefinitionMatches.Num() == 0)
     {
-        UE_LOG(LogQuickCodeEditor, Warning, TEXT("All %d name matches for function '%s' were in comments in implementation"), PossibleMatchPositions.Num(), *FunctionName);
         return false;
     }
     
-    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("After comment filtering: %d matches for function '%s' in implementation"), NonCommentMatches.Num(), *FunctionName);
+    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Found %d definitions of function '%s' in implementation"), DefinitionMatches.Num(), *FunctionName);
 
-    // Filter matches that have the class scope (ClassName::FunctionName)
-    TArray<int32> ScopedMatches;
-    if (!FilterScopedFunctionPositions(FileContent, NonCommentMatches, ClassName, ScopedMatches))
+    if (ScopedMatches.Num() == 0)
     {
-        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("No scoped matches found for function '%s' in class '%s', using non-comment matches as fallback"), *FunctionName, *ClassName);
-        // If no scoped matches found, try using non-comment matches as fallback
-        ScopedMatches = NonCommentMatches;
+        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("No scoped matches found for function '%s' in class '%s', using all definitions as fallback"), *FunctionName, *ClassName);
+        // If no scoped matches found, try using every definition as fallback
+        ScopedMatches = DefinitionMatches;
     }
     else
     {
         UE_LOG(LogQuickCodeEditor, Verbose, TEXT("After scope filtering: %d matches for function '%s' in class '%s'"), ScopedMatches.Num(), *FunctionName, *ClassName);
     }
 
-    // Check parameter signature match
-    TArray<int32> SignatureMatches;
-    if (!FilterPositionsBySignatureMatch(FileContent, ScopedMatches, DeclarationInfo, SignatureMatches))
+    // Check parameter signature match against the parameters the table recorded, the text is not read again
+    TArray<const FQCE_FunctionSymbol*> SignatureMatches;
+    if (!FilterSymbolsBySignatureMatch(ScopedMatches, DeclarationInfo, SignatureMatches))
     {
         return false;
     }
@@ -669,7 +594,7 @@ bool QCE_CommonIOHelpers::FindImplementationPositionInContent(const FString& Fil
         return false;
     }
 
-     OutFunctionPosition = SignatureMatches[0];
+    OutFunctionPosition = SignatureMatches[0]->NamePosition;
     return true;
 }
 
@@ -0,0 +1,199 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
+
+namespace
+{
+    struct FCachedMask
+    {
+        FString Content;
+        TSharedRef<const FQCE_LexicalMask> Mask;
+    };
+
+    /** A function lookup works on a header and a source file at a time, plus the editor text for completion */
+    constexpr int32 MaxCachedMasks = 4;
+
+    /** Shorter texts, such as single parameters, are cheaper to lex again than to keep, and would push the files out of the cache */
+    constexpr int32 MinCachedContentLength = 4 * 1024;
+
+    /** Longest delimiter of a raw string literal the standard allows */
+    constexpr int32 MaxRawStringDelimiterLength = 16;
+
+    /** Most recently used last */
+    TArray<FCachedMask> CachedMasks;
+
+    FORCEINLINE bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Returns the start of the identifier or number that ends right before Position, Position if there is none */
+    int32 FindTokenStart(const TCHAR* Chars, int32 Position)
+    {
+        int32 Start = Position;
+        while (Start > 0 && (IsIdentifierChar(Chars[Start - 1]) || Chars[Start - 1] == TEXT('\'')))
+        {
+            --Start;
+        }
+        return Start;
+    }
+
+    /** Returns the end of a quoted literal whose opening quote is at Start. Literals that are not closed end at the line break. */
+    int32 FindQuotedLiteralEnd(const TCHAR* Chars, int32 Len, int32 Start, TCHAR Quote)
+    {
+        int32 End = Start + 1;
+        while (End < Len)
+        {
+            const TCHAR Char = Chars[End];
+            if (Char == TEXT('\\'))
+            {
+                End += 2;
+                continue;
+            }
+            if (Char == Quote)
+                return End + 1;
+            if (Char == TEXT('\n'))
+                return End;
+            ++End;
+        }
+        return Len;
+    }
+
+    /** Returns the end of a raw string literal whose opening quote is at Start, INDEX_NONE if the quote does not open one */
+    int32 FindRawStringEnd(const TCHAR* Chars, int32 Len, int32 Start)
+    {
+        // R"delimiter( ... )delimiter", where R can carry an encoding prefix and is not the end of another identifier
+        if (Start == 0 || Chars[Start - 1] != TEXT('R'))
+            return INDEX_NONE;
+
+        const int32 PrefixStart = FindTokenStart(Chars, Start);
+        const FStringView Prefix(Chars + PrefixStart, Start - PrefixStart);
+        bool bIsRawPrefix = false;
+        for (const TCHAR* RawPrefix : { TEXT("R"), TEXT("u8R"), TEXT("uR"), TEXT("UR"), TEXT("LR") })
+        {
+            bIsRawPrefix |= Prefix.Equals(RawPrefix, ESearchCase::CaseSensitive);
+        }
+        if (!bIsRawPrefix)
+            return INDEX_NONE;
+
+        int32 OpenParen = Start + 1;
+        while (OpenParen < Len && OpenParen - Start - 1 <= MaxRawStringDelimiterLength && Chars[OpenParen] != TEXT('('))
+        {
+            const TCHAR Char = Chars[OpenParen];
+            if (Char == TEXT(')') || Char == TEXT('\\') || FChar::IsWhitespace(Char))
+                return INDEX_NONE;
+            ++OpenParen;
+        }
+        if (OpenParen >= Len || Chars[OpenParen] != TEXT('('))
+            return INDEX_NONE;
+
+        const FStringView Delimiter(Chars + Start + 1, OpenParen - Start - 1);
+        for (int32 Close = OpenParen + 1; Close + Delimiter.Len() + 1 < Len; ++Close)
+        {
+            if (Chars[Close] == TEXT(')')
+                && FStringView(Chars + Close + 1, Delimiter.Len()).Equals(Delimiter, ESearchCase::CaseSensitive)
+                && Chars[Close + Delimiter.Len() + 1] == TEXT('"'))
+            {
+                return Close + Delimiter.Len() + 2;
+            }
+        }
+        return Len;
+    }
+}
+
+FQCE_LexicalMask::FQCE_LexicalMask(FStringView Content)
+{
+    const TCHAR* Chars = Content.GetData();
+    const int32 Len = Content.Len();
+    Kinds.SetNumUninitialized(Len);
+
+    int32 Index = 0;
+    while (Index < Len)
+    {
+        const TCHAR Char = Chars[Index];
+        const TCHAR NextChar = Index + 1 < Len ? Chars[Index + 1] : TEXT('\0');
+
+        EQCE_LexicalKind Kind = EQCE_LexicalKind::Code;
+        int32 End = Index + 1;
+
+        if (Char == TEXT('/') && NextChar == TEXT('/'))
+        {
+            // The line break belongs to the comment it ends
+            Kind = EQCE_LexicalKind::Comment;
+            End = Index + 2;
+            while (End < Len && Chars[End] != TEXT('\n'))
+            {
+                ++End;
+            }
+            End = FMath::Min(End + 1, Len);
+        }
+        else if (Char == TEXT('/') && NextChar == TEXT('*'))
+        {
+            Kind = EQCE_LexicalKind::Comment;
+            End = Index + 2;
+            while (End + 1 < Len && !(Chars[End] == TEXT('*') && Chars[End + 1] == TEXT('/')))
+            {
+                ++End;
+            }
+            End = FMath::Min(End + 2, Len);
+        }
+        else if (Char == TEXT('"'))
+        {
+            Kind = EQCE_LexicalKind::String;
+            End = FindRawStringEnd(Chars, Len, Index);
+            if (End == INDEX_NONE)
+            {
+                End = FindQuotedLiteralEnd(Chars, Len, Index, Char);
+            }
+        }
+        else if (Char == TEXT('\''))
+        {
+            // A quote inside a number is a digit separator, as in 1'000'000
+            const int32 TokenStart = FindTokenStart(Chars, Index);
+            if (TokenStart == Index || !FChar::IsDigit(Chars[TokenStart]))
+            {
+                Kind = EQCE_LexicalKind::Char;
+                End = FindQuotedLiteralEnd(Chars, Len, Index, Char);
+            }
+        }
+
+        End = FMath::Min(End, Len);
+        for (; Index < End; ++Index)
+        {
+            Kinds[Index] = Kind;
+        }
+    }
+}
+
+TSharedRef<const FQCE_LexicalMask> FQCE_LexicalMask::Get(const FString& Content)
+{
+    check(IsInGameThread());
+
+    if (Content.Len() < MinCachedContentLength)
+    {
+        return MakeShared<FQCE_LexicalMask>(Content);
+    }
+
+    for (int32 Index = CachedMasks.Num() - 1; Index >= 0; --Index)
+    {
+        // Comparing the text is a fraction of the cost of lexing it
+        if (CachedMasks[Index].Content.Equals(Content, ESearchCase::CaseSensitive))
+        {
+            FCachedMask Entry = MoveTemp(CachedMasks[Index]);
+            CachedMasks.RemoveAt(Index);
+            return CachedMasks.Add_GetRef(MoveTemp(Entry)).Mask;
+        }
+    }
+
+    if (CachedMasks.Num() >= MaxCachedMasks)
+    {
+        CachedMasks.RemoveAt(0);
+    }
+
+    return CachedMasks.Add_GetRef(FCachedMask{ Content, MakeShared<FQCE_LexicalMask>(Content) }).Mask;
+}
+
+void FQCE_LexicalMask::Empty()
+{
+    CachedMasks.Empty();
+}
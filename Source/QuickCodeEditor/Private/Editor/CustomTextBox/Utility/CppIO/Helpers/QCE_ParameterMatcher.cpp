@@ -1,6 +1,7 @@
 ﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
 
 #include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ParameterMatcher.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
 
 #include "CoreMinimal.h"
 #include "Internationalization/Regex.h"
@@ -290,14 +291,19 @@ TArray<FString> QCE_ParameterMatcher::ToParameterArray(const FString& ParameterS
 }
 
 bool QCE_ParameterMatcher::GetParameterStringAtPosition(const FString& FileContent, const int32 MatchPos, FString& ParameterString)
+{
+	return GetParameterStringAtPosition(FileContent, *FQCE_LexicalMask::Get(FileContent), MatchPos, ParameterString);
+}
+
+bool QCE_ParameterMatcher::GetParameterStringAtPosition(const FString& FileContent, const FQCE_LexicalMask& Mask, const int32 MatchPos, FString& ParameterString)
 {
 	// We want to get the outtermost parantheses of this function and get the string between them
 	int32 OpenParenPos = INDEX_NONE;
-	if (!FindCharacterRespectingContext(FileContent, TEXT("("), MatchPos, ESearchDir::FromStart, OpenParenPos))
+	if (!FindCharacterRespectingContext(FileContent, Mask, TEXT("("), MatchPos, ESearchDir::FromStart, OpenParenPos))
 		return false;
 
 	int32 CloseParenPos = INDEX_NONE;
-	if (!FindMatchingBracket(FileContent, OpenParenPos, TEXT('('), TEXT(')'), CloseParenPos, false))
+	if (!FindMatchingBracket(FileContent, Mask, OpenParenPos, TEXT('('), TEXT(')'), CloseParenPos, false))
 		return false;
 
 	ParameterString = FileContent.Mid(OpenParenPos + 1, CloseParenPos - OpenParenPos - 1).TrimStartAndEnd();
@@ -306,98 +312,26 @@ bool QCE_ParameterMatcher::GetParameterStringAtPosition(const FString& FileConte
 
 bool QCE_ParameterMatcher::FindMatchingBracket(const FString& Content, int32 OpenBracketPos, TCHAR OpenBracket, TCHAR CloseBracket, int32& OutCloseBracketPos, bool bIncludeSingleQuotes)
 {
-	if (OpenBracketPos >= Content.Len() || Content[OpenBracketPos] != OpenBracket)
+	if (OpenBracketPos < 0 || OpenBracketPos >= Content.Len() || Content[OpenBracketPos] != OpenBracket)
 		return false;
 
-	int32 BracketCount = 1;
-	int32 SearchPos = OpenBracketPos + 1;
-	bool bInDoubleQuotes = false;
-	bool bInSingleQuotes = false;
-	bool bInLineComment = false;
-	bool bInBlockComment = false;
-	bool bEscapeNext = false;
+	return FindMatchingBracket(Content, *FQCE_LexicalMask::Get(Content), OpenBracketPos, OpenBracket, CloseBracket, OutCloseBracketPos, bIncludeSingleQuotes);
+}
 
-	while (BracketCount > 0 && SearchPos < Content.Len())
+bool QCE_ParameterMatcher::FindMatchingBracket(const FString& Content, const FQCE_LexicalMask& Mask, int32 OpenBracketPos, TCHAR OpenBracket, TCHAR CloseBracket, int32& OutCloseBracketPos, bool bIncludeSingleQuotes)
+{
+	if (OpenBracketPos < 0 || OpenBracketPos >= Content.Len() || Content[OpenBracketPos] != OpenBracket)
+		return false;
+
+	int32 BracketCount = 1;
+	for (int32 SearchPos = OpenBracketPos + 1; SearchPos < Content.Len(); SearchPos++)
 	{
-		TCHAR CurrentChar = Content[SearchPos];
-		TCHAR NextChar = (SearchPos + 1 < Content.Len()) ? Content[SearchPos + 1] : 0;
-        
-		// Handle escape sequences
-		if (bEscapeNext)
-		{
-			bEscapeNext = false;
-			SearchPos++;
+		// Only count brackets in code, and in character literals unless those are skipped too
+		const EQCE_LexicalKind Kind = Mask.GetKind(SearchPos);
+		if (Kind != EQCE_LexicalKind::Code && (bIncludeSingleQuotes || Kind != EQCE_LexicalKind::Char))
 			continue;
-		}
-        
-		if (CurrentChar == TEXT('\\') && (bInDoubleQuotes || (bIncludeSingleQuotes && bInSingleQuotes)))
-		{
-			bEscapeNext = true;
-			SearchPos++;
-			continue;
-		}
-        
-		// Handle line comments
-		if (bInLineComment)
-		{
-			if (CurrentChar == TEXT('\n'))
-			{
-				bInLineComment = false;
-			}
-			SearchPos++;
-			continue;
-		}
-		
-		// Handle block comments
-		if (bInBlockComment)
-		{
-			if (CurrentChar == TEXT('*') && NextChar == TEXT('/'))
-			{
-				bInBlockComment = false;
-				SearchPos++; // Skip the '/'
-			}
-			SearchPos++;
-			continue;
-		}
-        
-		// Handle quote states
-		if (CurrentChar == TEXT('"') && (!bIncludeSingleQuotes || !bInSingleQuotes))
-		{
-			bInDoubleQuotes = !bInDoubleQuotes;
-			SearchPos++;
-			continue;
-		}
-        
-		if (bIncludeSingleQuotes && CurrentChar == TEXT('\'') && !bInDoubleQuotes)
-		{
-			bInSingleQuotes = !bInSingleQuotes;
-			SearchPos++;
-			continue;
-		}
-        
-		// If we're in quotes, just continue
-		if (bInDoubleQuotes || (bIncludeSingleQuotes && bInSingleQuotes))
-		{
-			SearchPos++;
-			continue;
-		}
-		
-		// Check for comment starts (only when not in quotes)
-		if (CurrentChar == TEXT('/') && NextChar == TEXT('/'))
-		{
-			bInLineComment = true;
-			SearchPos++;
-			continue;
-		}
-		
-		if (CurrentChar == TEXT('/') && NextChar == TEXT('*'))
-		{
-			bInBlockComment = true;
-			SearchPos++;
-			continue;
-		}
-		
-		// Only count brackets when NOT inside quotes or comments
+
+		const TCHAR CurrentChar = Content[SearchPos];
 		if (CurrentChar == OpenBracket)
 			BracketCount++;
 		else if (CurrentChar == CloseBracket)
@@ -408,8 +342,6 @@ bool QCE_ParameterMatcher::FindMatchingBracket(const FString& Content, int32 Ope
 			OutCloseBracketPos = SearchPos;
 			return true;
 		}
-
-		SearchPos++;
 	}
 
 	return false;
@@ -743,99 +675,20 @@ FString QCE_ParameterMatcher::RemoveParameterName(const FString& Parameter)
 
 bool QCE_ParameterMatcher::IsPositionInStringOrComment(const FString& Content, int32 Position)
 {
-	bool bInLineComment = false;
-	bool bInBlockComment = false;
-	bool bInString = false;
-	bool bInSingleQuotes = false;
-	bool bEscapeNext = false;
-	
-	for (int32 i = 0; i < Position && i < Content.Len(); i++)
-	{
-		TCHAR Char = Content[i];
-		TCHAR NextChar = (i + 1 < Content.Len()) ? Content[i + 1] : 0;
-		
-		if (bEscapeNext)
-		{
-			bEscapeNext = false;
-			continue;
-		}
-		
-		if (Char == TEXT('\\') && (bInString || bInSingleQuotes))
-		{
-			bEscapeNext = true;
-			continue;
-		}
-		
-		if (bInLineComment)
-		{
-			if (Char == TEXT('\n'))
-			{
-				bInLineComment = false;
-			}
-			continue;
-		}
-		
-		if (bInBlockComment)
-		{
-			if (Char == TEXT('*') && NextChar == TEXT('/'))
-			{
-				bInBlockComment = false;
-				i++; // Skip the '/'
-			}
-			continue;
-		}
-		
-		if (bInString)
-		{
-			if (Char == TEXT('"'))
-			{
-				bInString = false;
-			}
-			continue;
-		}
-		
-		if (bInSingleQuotes)
-		{
-			if (Char == TEXT('\''))
-			{
-				bInSingleQuotes = false;
-			}
-			continue;
-		}
-		
-		// Check for comment starts
-		if (Char == TEXT('/') && NextChar == TEXT('/'))
-		{
-			bInLineComment = true;
-			i++; // Skip the second '/'
-			continue;
-		}
-		
-		if (Char == TEXT('/') && NextChar == TEXT('*'))
-		{
-			bInBlockComment = true;
-			i++; // Skip the '*'
-			continue;
-		}
-		
-		// Check for string starts
-		if (Char == TEXT('"'))
-		{
-			bInString = true;
-			continue;
-		}
-		
-		if (Char == TEXT('\''))
-		{
-			bInSingleQuotes = true;
-			continue;
-		}
-	}
-	
-	return bInLineComment || bInBlockComment || bInString || bInSingleQuotes;
+	return IsPositionInStringOrComment(*FQCE_LexicalMask::Get(Content), Position);
+}
+
+bool QCE_ParameterMatcher::IsPositionInStringOrComment(const FQCE_LexicalMask& Mask, int32 Position)
+{
+	return Mask.IsStringOrComment(Position);
 }
 
 bool QCE_ParameterMatcher::FindCharacterRespectingContext(const FString& Content, const FString& SearchChar, int32 StartPos, ESearchDir::Type Direction, int32& OutPosition)
+{
+	return FindCharacterRespectingContext(Content, *FQCE_LexicalMask::Get(Content), SearchChar, StartPos, Direction, OutPosition);
+}
+
+bool QCE_ParameterMatcher::FindCharacterRespectingContext(const FString& Content, const FQCE_LexicalMask& Mask, const FString& SearchChar, int32 StartPos, ESearchDir::Type Direction, int32& OutPosition)
 {
 	int32 SearchPos = StartPos;
 	int32 Step = (Direction == ESearchDir::FromStart) ? 1 : -1;
@@ -848,7 +701,7 @@ bool QCE_ParameterMatcher::FindCharacterRespectingContext(const FString& Content
 			return false;
 		
 		// Check if this position is in a string or comment
-		if (!IsPositionInStringOrComment(Content, FoundPos))
+		if (Mask.IsCode(FoundPos))
 		{
 			OutPosition = FoundPos;
 			return true;
@@ -0,0 +1,463 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ProjectSymbolIndex.h"
+
+#include "QuickCodeEditor.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "DirectoryWatcherModule.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SymbolTable.h"
+#include "HAL/FileManager.h"
+#include "IDirectoryWatcher.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+struct FQCE_ProjectSymbolIndex::FScanJob
+{
+    /** Directories to look for new and changed files in, empty when only Paths are scanned */
+    TArray<FString> Directories;
+
+    /** Size and modification time of every indexed file, to tell which files in Directories changed */
+    TMap<FString, TPair<int64, FDateTime>> KnownFiles;
+
+    /** Files to scan, the enumeration of Directories adds to them */
+    TArray<FString> Paths;
+
+    /** One per path, a file that is gone comes back with a FileSize of INDEX_NONE */
+    TArray<FQCE_IndexedFile> Results;
+
+    /** Set by the game thread when the result is no longer wanted */
+    std::atomic<bool> bCancelled { false };
+
+    /** Set by the worker once Paths and Results are final */
+    std::atomic<bool> bFinished { false };
+};
+
+namespace
+{
+    /** "QCEI" */
+    constexpr uint32 IndexFileMagic = 0x51434549;
+
+    /** Bump when the file layout or what the scanner records changes, older index files are then scanned again */
+    constexpr int32 IndexFileVersion = 1;
+
+    bool IsSourceFile(const FString& Path)
+    {
+        const FString Extension = FPaths::GetExtension(Path);
+        return Extension == TEXT("cpp") || Extension == TEXT("h") || Extension == TEXT("hpp") || Extension == TEXT("inl");
+    }
+
+    /** Same as the paths of FQCE_SourceFileCache, so index entries can be compared with loaded files */
+    FString NormalizePath(const FString& FilePath)
+    {
+        FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+        FPaths::NormalizeFilename(FullPath);
+        return FullPath;
+    }
+}
+
+FQCE_ProjectSymbolIndex::~FQCE_ProjectSymbolIndex()
+{
+    Shutdown();
+}
+
+void FQCE_ProjectSymbolIndex::Initialize()
+{
+    check(IsInGameThread());
+
+    if (bIsInitialized)
+    {
+        return;
+    }
+    bIsInitialized = true;
+
+    TArray<FString> CandidateDirectories;
+    CandidateDirectories.Add(FPaths::GameSourceDir());
+    for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+    {
+        if (Plugin->GetLoadedFrom() == EPluginLoadedFrom::Project)
+        {
+            CandidateDirectories.Add(FPaths::Combine(Plugin->GetBaseDir(), TEXT("Source")));
+        }
+    }
+
+    for (const FString& Directory : CandidateDirectories)
+    {
+        if (IFileManager::Get().DirectoryExists(*Directory))
+        {
+            SourceDirectories.AddUnique(NormalizePath(Directory));
+        }
+    }
+
+    if (LoadIndex())
+    {
+        UE_LOG(LogQuickCodeEditor, Log, TEXT("Loaded symbol index of %d files from '%s'"), Files.Num(), *GetIndexFilePath());
+    }
+
+    // Watch first, a file saved while the directories are enumerated is scanned again once the scan is done
+    if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::LoadModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+    {
+        if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+        {
+            for (const FString& Directory : SourceDirectories)
+            {
+                FDelegateHandle Handle;
+                if (DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FQCE_ProjectSymbolIndex::OnDirectoryChanged), Handle))
+                {
+                    WatcherHandles.Add(Directory, Handle);
+                }
+            }
+        }
+    }
+
+    StartScan(SourceDirectories, TArray<FString>());
+}
+
+void FQCE_ProjectSymbolIndex::Shutdown()
+{
+    if (!bIsInitialized)
+    {
+        return;
+    }
+    bIsInitialized = false;
+
+    // The directory watcher may already be unloaded when the editor shuts down
+    if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+    {
+        if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+        {
+            for (const TPair<FString, FDelegateHandle>& Pair : WatcherHandles)
+            {
+                DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Pair.Key, Pair.Value);
+            }
+        }
+    }
+    WatcherHandles.Empty();
+
+    if (ScanTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ScanTickerHandle);
+        ScanTickerHandle.Reset();
+    }
+
+    // Files the scan did not get to keep their old size and time, so the next start scans them
+    if (ScanJob.IsValid())
+    {
+        ScanJob->bCancelled = true;
+        ScanFuture.Wait();
+        ScanJob.Reset();
+    }
+    ScanFuture = TFuture<void>();
+
+    if (bIsDirty)
+    {
+        SaveIndex();
+    }
+
+    Files.Empty();
+    FilesByFunctionName.Empty();
+    SourceDirectories.Empty();
+    PendingPaths.Empty();
+}
+
+void FQCE_ProjectSymbolIndex::FindDefinitionFiles(const FString& FunctionName, const FString& ClassName, TArray<FString>& OutPaths) const
+{
+    check(IsInGameThread());
+
+    const TArray<FString>* Paths = FilesByFunctionName.Find(FunctionName);
+    if (!Paths)
+    {
+        return;
+    }
+
+    for (const FString& Path : *Paths)
+    {
+        const FQCE_IndexedFile& File = Files.FindChecked(Path);
+        const bool bDefinesFunction = File.Functions.ContainsByPredicate([&FunctionName, &ClassName](const FQCE_IndexedFunction& Function)
+        {
+            return Function.Name.Equals(FunctionName, ESearchCase::CaseSensitive)
+                && (ClassName.IsEmpty() || Function.ScopeName.EndsWith(ClassName, ESearchCase::CaseSensitive));
+        });
+
+        if (bDefinesFunction)
+        {
+            OutPaths.Add(Path);
+        }
+    }
+}
+
+FString FQCE_ProjectSymbolIndex::GetIndexFilePath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("QuickCodeEditor"), TEXT("SymbolIndex.bin"));
+}
+
+void FQCE_ProjectSymbolIndex::StartScan(TArray<FString> Directories, TArray<FString> Paths)
+{
+    check(!ScanJob.IsValid());
+
+    TSharedRef<FScanJob, ESPMode::ThreadSafe> Job = MakeShared<FScanJob, ESPMode::ThreadSafe>();
+    Job->Directories = MoveTemp(Directories);
+    Job->Paths = MoveTemp(Paths);
+    if (Job->Directories.Num() > 0)
+    {
+        Job->KnownFiles.Reserve(Files.Num());
+        for (const TPair<FString, FQCE_IndexedFile>& Pair : Files)
+        {
+            Job->KnownFiles.Add(Pair.Key, TPair<int64, FDateTime>(Pair.Value.FileSize, Pair.Value.ModificationTime));
+        }
+    }
+    ScanJob = Job;
+
+    // The job only touches its own paths and results, Shutdown waits for it before the module goes away
+    ScanFuture = Async(EAsyncExecution::ThreadPool, [Job]()
+    {
+        RunScan(*Job);
+        Job->bFinished = true;
+    });
+
+    ScanTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FQCE_ProjectSymbolIndex::TickScan));
+}
+
+void FQCE_ProjectSymbolIndex::RunScan(FScanJob& Job)
+{
+    if (Job.Directories.Num() > 0)
+    {
+        TSet<FString> FoundFiles;
+        for (const FString& Directory : Job.Directories)
+        {
+            IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&Job, &FoundFiles](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+            {
+                if (Job.bCancelled)
+                {
+                    return false;
+                }
+
+                if (StatData.bIsDirectory || !IsSourceFile(FilenameOrDirectory))
+                {
+                    return true;
+                }
+
+                FString Path = NormalizePath(FilenameOrDirectory);
+                const TPair<int64, FDateTime>* KnownFile = Job.KnownFiles.Find(Path);
+                if (!KnownFile || KnownFile->Key != StatData.FileSize || KnownFile->Value != StatData.ModificationTime)
+                {
+                    Job.Paths.Add(Path);
+                }
+                FoundFiles.Add(MoveTemp(Path));
+                return true;
+            });
+        }
+
+        // Deleted while the editor was closed, scanning them removes them from the index
+        for (const TPair<FString, TPair<int64, FDateTime>>& Pair : Job.KnownFiles)
+        {
+            if (!FoundFiles.Contains(Pair.Key))
+            {
+                Job.Paths.Add(Pair.Key);
+            }
+        }
+    }
+
+    Job.Results.SetNum(Job.Paths.Num());
+    ParallelFor(Job.Paths.Num(), [&Job](int32 Index)
+    {
+        if (!Job.bCancelled)
+        {
+            ScanFile(Job.Paths[Index], Job.Results[Index]);
+        }
+    });
+}
+
+void FQCE_ProjectSymbolIndex::ScanFile(const FString& Path, FQCE_IndexedFile& OutFile)
+{
+    OutFile.Path = Path;
+
+    // Stat before reading, so a change made while reading shows up as a newer time on the next start
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*Path);
+    FString Content;
+    if (!StatData.bIsValid || StatData.bIsDirectory || !FFileHelper::LoadFileToString(Content, *Path))
+    {
+        OutFile.FileSize = INDEX_NONE;
+        return;
+    }
+
+    OutFile.FileSize = StatData.FileSize;
+    OutFile.ModificationTime = StatData.ModificationTime;
+
+    const FQCE_SymbolTable SymbolTable(Content);
+    for (const FQCE_FunctionSymbol& Function : SymbolTable.GetFunctions())
+    {
+        if (Function.bIsDefinition)
+        {
+            OutFile.Functions.Add(FQCE_IndexedFunction{ Function.Name, Function.ScopeName });
+        }
+    }
+}
+
+bool FQCE_ProjectSymbolIndex::TickScan(float DeltaTime)
+{
+    if (ScanJob.IsValid() && !ScanJob->bFinished)
+    {
+        return true;
+    }
+
+    ScanTickerHandle.Reset();
+    const TSharedPtr<FScanJob, ESPMode::ThreadSafe> Job = MoveTemp(ScanJob);
+    ScanFuture = TFuture<void>();
+    if (!Job.IsValid() || Job->bCancelled)
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Job->Paths.Num(); ++Index)
+    {
+        if (Job->Results[Index].FileSize == INDEX_NONE)
+        {
+            RemoveFile(Job->Paths[Index]);
+        }
+        else
+        {
+            AddFile(MoveTemp(Job->Results[Index]));
+        }
+    }
+
+    UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Symbol index scanned %d files, %d files indexed"), Job->Paths.Num(), Files.Num());
+
+    // Save after the startup scan, so an editor that does not shut down cleanly still starts from it next time
+    if (Job->Directories.Num() > 0 && bIsDirty)
+    {
+        SaveIndex();
+    }
+
+    if (PendingPaths.Num() > 0)
+    {
+        StartScan(TArray<FString>(), PendingPaths.Array());
+        PendingPaths.Reset();
+    }
+
+    return false;
+}
+
+void FQCE_ProjectSymbolIndex::AddFile(FQCE_IndexedFile&& File)
+{
+    RemoveFile(File.Path);
+
+    for (const FQCE_IndexedFunction& Function : File.Functions)
+    {
+        FilesByFunctionName.FindOrAdd(Function.Name).AddUnique(File.Path);
+    }
+
+    const FString Path = File.Path;
+    Files.Add(Path, MoveTemp(File));
+    bIsDirty = true;
+}
+
+void FQCE_ProjectSymbolIndex::RemoveFile(const FString& Path)
+{
+    FQCE_IndexedFile File;
+    if (!Files.RemoveAndCopyValue(Path, File))
+    {
+        return;
+    }
+
+    for (const FQCE_IndexedFunction& Function : File.Functions)
+    {
+        if (TArray<FString>* Paths = FilesByFunctionName.Find(Function.Name))
+        {
+            Paths->Remove(Path);
+            if (Paths->Num() == 0)
+            {
+                FilesByFunctionName.Remove(Function.Name);
+            }
+        }
+    }
+    bIsDirty = true;
+}
+
+void FQCE_ProjectSymbolIndex::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+    for (const FFileChangeData& Change : Changes)
+    {
+        if (IsSourceFile(Change.Filename))
+        {
+            PendingPaths.Add(NormalizePath(Change.Filename));
+        }
+    }
+
+    // A running scan starts the next one when it is done
+    if (!ScanJob.IsValid() && PendingPaths.Num() > 0)
+    {
+        StartScan(TArray<FString>(), PendingPaths.Array());
+        PendingPaths.Reset();
+    }
+}
+
+bool FQCE_ProjectSymbolIndex::LoadIndex()
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *GetIndexFilePath(), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Data);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    Reader << Magic << Version;
+    if (Magic != IndexFileMagic || Version != IndexFileVersion)
+    {
+        UE_LOG(LogQuickCodeEditor, Log, TEXT("Symbol index '%s' is from another version, scanning all files again"), *GetIndexFilePath());
+        return false;
+    }
+
+    int32 NumFiles = 0;
+    Reader << NumFiles;
+
+    TArray<FQCE_IndexedFile> LoadedFiles;
+    for (int32 Index = 0; Index < NumFiles && !Reader.IsError(); ++Index)
+    {
+        Reader << LoadedFiles.AddDefaulted_GetRef();
+    }
+
+    if (Reader.IsError())
+    {
+        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Symbol index '%s' is damaged, scanning all files again"), *GetIndexFilePath());
+        return false;
+    }
+
+    for (FQCE_IndexedFile& File : LoadedFiles)
+    {
+        AddFile(MoveTemp(File));
+    }
+    bIsDirty = false;
+
+    return true;
+}
+
+void FQCE_ProjectSymbolIndex::SaveIndex()
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+
+    uint32 Magic = IndexFileMagic;
+    int32 Version = IndexFileVersion;
+    int32 NumFiles = Files.Num();
+    Writer << Magic << Version << NumFiles;
+    for (TPair<FString, FQCE_IndexedFile>& Pair : Files)
+    {
+        Writer << Pair.Value;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Data, *GetIndexFilePath()))
+    {
+        UE_LOG(LogQuickCodeEditor, Warning, TEXT("Failed to save symbol index to '%s'"), *GetIndexFilePath());
+        return;
+    }
+
+    bIsDirty = false;
+}
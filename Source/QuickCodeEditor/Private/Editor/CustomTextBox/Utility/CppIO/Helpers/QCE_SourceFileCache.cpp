@@ -0,0 +1,103 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SourceFileCache.h"
+
+#include "QuickCodeEditor.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/CRC.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    /** Enough for the header and source files of the classes being switched between */
+    constexpr int32 MaxCachedFiles = 16;
+
+    /** Most recently used last */
+    TArray<TSharedRef<const FQCE_SourceFile>> CachedFiles;
+
+    FString NormalizePath(const FString& FilePath)
+    {
+        FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+        FPaths::NormalizeFilename(FullPath);
+        return FullPath;
+    }
+
+    int32 FindCachedFile(const FString& FullPath)
+    {
+        return CachedFiles.IndexOfByPredicate([&FullPath](const TSharedRef<const FQCE_SourceFile>& File)
+        {
+            return File->GetPath().Equals(FullPath, ESearchCase::CaseSensitive);
+        });
+    }
+}
+
+FQCE_SourceFile::FQCE_SourceFile(FString InPath, FString InContent, int64 InFileSize, const FDateTime& InModificationTime)
+    : Path(MoveTemp(InPath))
+    , Content(MoveTemp(InContent))
+    , Checksum(FCrc::StrCrc32(*Content))
+    , FileSize(InFileSize)
+    , ModificationTime(InModificationTime)
+{
+}
+
+TSharedPtr<const FQCE_SourceFile> FQCE_SourceFileCache::Get(const FString& FilePath)
+{
+    check(IsInGameThread());
+
+    const FString FullPath = NormalizePath(FilePath);
+    const int32 CachedIndex = FindCachedFile(FullPath);
+
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FullPath);
+    if (!StatData.bIsValid || StatData.bIsDirectory)
+    {
+        if (CachedIndex != INDEX_NONE)
+        {
+            CachedFiles.RemoveAt(CachedIndex);
+        }
+        return nullptr;
+    }
+
+    if (CachedIndex != INDEX_NONE)
+    {
+        TSharedRef<const FQCE_SourceFile> File = CachedFiles[CachedIndex];
+        CachedFiles.RemoveAt(CachedIndex);
+
+        if (File->GetFileSize() == StatData.FileSize && File->GetModificationTime() == StatData.ModificationTime)
+        {
+            CachedFiles.Add(File);
+            return File;
+        }
+
+        UE_LOG(LogQuickCodeEditor, Verbose, TEXT("Source file '%s' changed on disk, reading it again"), *FullPath);
+    }
+
+    // Stat before reading, so a change made while reading shows up as a newer time on the next lookup
+    FString Content;
+    if (!FFileHelper::LoadFileToString(Content, *FullPath))
+    {
+        return nullptr;
+    }
+
+    if (CachedFiles.Num() >= MaxCachedFiles)
+    {
+        CachedFiles.RemoveAt(0);
+    }
+
+    return CachedFiles.Add_GetRef(MakeShared<FQCE_SourceFile>(FullPath, MoveTemp(Content), StatData.FileSize, StatData.ModificationTime));
+}
+
+void FQCE_SourceFileCache::Invalidate(const FString& FilePath)
+{
+    const int32 CachedIndex = FindCachedFile(NormalizePath(FilePath));
+    if (CachedIndex != INDEX_NONE)
+    {
+        CachedFiles.RemoveAt(CachedIndex);
+    }
+}
+
+void FQCE_SourceFileCache::Empty()
+{
+    CachedFiles.Empty();
+}
@@ -0,0 +1,702 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SymbolTable.h"
+
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ParameterMatcher.h"
+
+namespace
+{
+    struct FCachedTable
+    {
+        FString Content;
+        TSharedRef<const FQCE_SymbolTable> Table;
+    };
+
+    /** Same reasoning as the lexical mask cache: a header and a source file at a time */
+    constexpr int32 MaxCachedTables = 4;
+
+    /** Shorter texts are cheaper to scan again than to keep */
+    constexpr int32 MinCachedTableContentLength = 4 * 1024;
+
+    /** Most recently used last */
+    TArray<FCachedTable> CachedTables;
+
+    FORCEINLINE bool IsNameStartChar(TCHAR Char)
+    {
+        return FChar::IsAlpha(Char) || Char == TEXT('_');
+    }
+
+    FORCEINLINE bool IsNameChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Words that can be followed by parentheses without naming a function */
+    bool IsKeyword(FStringView Word)
+    {
+        static const TCHAR* const Keywords[] =
+        {
+            TEXT("if"), TEXT("for"), TEXT("while"), TEXT("switch"), TEXT("return"), TEXT("sizeof"), TEXT("decltype"),
+            TEXT("alignof"), TEXT("alignas"), TEXT("catch"), TEXT("static_assert"), TEXT("noexcept"), TEXT("throw"),
+            TEXT("new"), TEXT("delete"), TEXT("void"), TEXT("operator"), TEXT("__declspec"), TEXT("__attribute__")
+        };
+        for (const TCHAR* Keyword : Keywords)
+        {
+            if (Word.Equals(Keyword, ESearchCase::CaseSensitive))
+                return true;
+        }
+        return false;
+    }
+
+    /** Macros such as UFUNCTION, GENERATED_BODY or TEXT are written in capitals, their arguments are not parameters */
+    bool IsMacroName(FStringView Word)
+    {
+        if (Word.Len() < 2)
+            return false;
+
+        for (const TCHAR Char : Word)
+        {
+            if (!FChar::IsUpper(Char) && !FChar::IsDigit(Char) && Char != TEXT('_'))
+                return false;
+        }
+        return true;
+    }
+
+    /** Walks a file once, keeping only the state of the statement being read and the class and namespace scopes around it */
+    class FSymbolScanner
+    {
+    public:
+        FSymbolScanner(const FString& InContent, TArray<FQCE_ClassSymbol>& InClasses, TArray<FQCE_FunctionSymbol>& InFunctions)
+            : Content(InContent)
+            // The mask cache belongs to the game thread, workers scanning files build their own
+            , Mask(IsInGameThread() ? FQCE_LexicalMask::Get(InContent) : MakeShared<const FQCE_LexicalMask>(InContent))
+            , Classes(InClasses)
+            , Functions(InFunctions)
+        {
+        }
+
+        void Scan()
+        {
+            ResetStatement();
+
+            while (Position < Content.Len())
+            {
+                const EQCE_LexicalKind Kind = Mask->GetKind(Position);
+                if (Kind == EQCE_LexicalKind::Comment)
+                {
+                    Position++;
+                    continue;
+                }
+
+                const TCHAR Char = Content[Position];
+                if (Kind != EQCE_LexicalKind::Code)
+                {
+                    // A string or character literal is one token
+                    BeginToken(ETokenType::Other);
+                    while (Position < Content.Len() && Mask->GetKind(Position) == Kind)
+                    {
+                        Position++;
+                    }
+                }
+                else if (FChar::IsWhitespace(Char))
+                {
+                    Position++;
+                }
+                else if (Char == TEXT('#') && IsAtLineStart(Position))
+                {
+                    Position = SkipDirective(Position);
+                }
+                else if (IsNameStartChar(Char))
+                {
+                    ReadIdentifier();
+                }
+                else if (FChar::IsDigit(Char))
+                {
+                    BeginToken(ETokenType::Other);
+                    while (Position < Content.Len() && (IsNameChar(Content[Position]) || Content[Position] == TEXT('.') || Content[Position] == TEXT('\'')))
+                    {
+                        Position++;
+                    }
+                }
+                else
+                {
+                    ReadPunctuation(Char);
+                }
+            }
+        }
+
+    private:
+        enum class ETokenType : uint8
+        {
+            None,
+            Identifier,
+            ScopeOperator,
+            Other,
+        };
+
+        /** What the keywords read so far make of the statement */
+        enum class EPendingScope : uint8
+        {
+            None,
+            Class,
+            Enum,
+            Namespace,
+            Extern,
+        };
+
+        struct FScope
+        {
+            /** Index into Classes, INDEX_NONE for namespaces and extern blocks */
+            int32 ClassIndex = INDEX_NONE;
+        };
+
+        void ResetStatement()
+        {
+            StatementStart = INDEX_NONE;
+            PendingScope = EPendingScope::None;
+            PendingClassName.Reset();
+            bInBaseClassList = false;
+            bHasAssignment = false;
+            bIsDestructorName = false;
+            UFunctionStart = INDEX_NONE;
+            UFunctionEnd = INDEX_NONE;
+            LastToken = ETokenType::None;
+        }
+
+        void BeginToken(ETokenType Type)
+        {
+            if (StatementStart == INDEX_NONE)
+            {
+                StatementStart = Position;
+            }
+            LastToken = Type;
+        }
+
+        FStringView GetView(int32 Start, int32 End) const
+        {
+            return FStringView(*Content + Start, End - Start);
+        }
+
+        bool IsAtLineStart(int32 CharPosition) const
+        {
+            for (int32 Index = CharPosition - 1; Index >= 0 && Content[Index] != TEXT('\n'); --Index)
+            {
+                if (!FChar::IsWhitespace(Content[Index]))
+                    return false;
+            }
+            return true;
+        }
+
+        /** Returns the position after a preprocessor directive, following its line continuations */
+        int32 SkipDirective(int32 Start) const
+        {
+            int32 End = Start;
+            while (End < Content.Len())
+            {
+                if (Content[End] == TEXT('\n'))
+                {
+                    const bool bContinued = (End > 0 && Content[End - 1] == TEXT('\\'))
+                        || (End > 1 && Content[End - 1] == TEXT('\r') && Content[End - 2] == TEXT('\\'));
+                    if (!bContinued)
+                        return End + 1;
+                }
+                End++;
+            }
+            return End;
+        }
+
+        /** Returns the position of the bracket closing the one at OpenPosition, counting code only. INDEX_NONE if it is not closed. */
+        int32 FindClosingBracket(int32 OpenPosition, TCHAR OpenBracket, TCHAR CloseBracket) const
+        {
+            int32 Depth = 0;
+            for (int32 Index = OpenPosition; Index < Content.Len(); ++Index)
+            {
+                if (!Mask->IsCode(Index))
+                    continue;
+
+                if (Content[Index] == OpenBracket)
+                {
+                    Depth++;
+                }
+                else if (Content[Index] == CloseBracket && --Depth == 0)
+                {
+                    return Index;
+                }
+            }
+            return INDEX_NONE;
+        }
+
+        void ReadIdentifier()
+        {
+            const int32 Start = Position;
+            while (Position < Content.Len() && IsNameChar(Content[Position]))
+            {
+                Position++;
+            }
+            const FStringView Word = GetView(Start, Position);
+
+            const bool bQualified = LastToken == ETokenType::ScopeOperator;
+            const bool bDestructor = Start > 0 && Content[Start - 1] == TEXT('~') && LastToken != ETokenType::Identifier;
+
+            if (StatementStart == INDEX_NONE)
+            {
+                StatementStart = Start;
+            }
+            LastToken = ETokenType::Identifier;
+
+            LastIdentifierStart = Start;
+            LastIdentifierEnd = Position;
+            bIsDestructorName = bDestructor;
+            LastIdentifierQualifier = bQualified ? PendingQualifier : FString();
+
+            if (Word.Equals(TEXT("class"), ESearchCase::CaseSensitive) || Word.Equals(TEXT("struct"), ESearchCase::CaseSensitive) || Word.Equals(TEXT("union"), ESearchCase::CaseSensitive))
+            {
+                // "enum class" stays an enum
+                if (PendingScope != EPendingScope::Enum)
+                {
+                    PendingScope = EPendingScope::Class;
+                    PendingClassName.Reset();
+                    bInBaseClassList = false;
+                }
+            }
+            else if (Word.Equals(TEXT("enum"), ESearchCase::CaseSensitive))
+            {
+                PendingScope = EPendingScope::Enum;
+            }
+            else if (Word.Equals(TEXT("namespace"), ESearchCase::CaseSensitive))
+            {
+                PendingScope = EPendingScope::Namespace;
+            }
+            else if (Word.Equals(TEXT("extern"), ESearchCase::CaseSensitive))
+            {
+                if (PendingScope == EPendingScope::None)
+                {
+                    PendingScope = EPendingScope::Extern;
+                }
+            }
+            else if (PendingScope == EPendingScope::Class && !bInBaseClassList && !IsMacroName(Word) && !Word.Equals(TEXT("final"), ESearchCase::CaseSensitive))
+            {
+                // The last word before the base classes or the body, after the export macro
+                PendingClassName = FString(Word);
+            }
+        }
+
+        void ReadPunctuation(TCHAR Char)
+        {
+            const TCHAR NextChar = Position + 1 < Content.Len() ? Content[Position + 1] : TEXT('\0');
+
+            switch (Char)
+            {
+            case TEXT(':'):
+                if (NextChar == TEXT(':'))
+                {
+                    PendingQualifier = LastToken == ETokenType::Identifier ? FString(GetView(LastIdentifierStart, LastIdentifierEnd)) : FString();
+                    BeginToken(ETokenType::ScopeOperator);
+                    Position += 2;
+                    return;
+                }
+                if (LastToken == ETokenType::Identifier && PendingScope == EPendingScope::None && IsAccessSpecifier(GetView(LastIdentifierStart, LastIdentifierEnd)))
+                {
+                    Position++;
+                    ResetStatement();
+                    return;
+                }
+                if (PendingScope == EPendingScope::Class)
+                {
+                    bInBaseClassList = true;
+                }
+                break;
+
+            case TEXT('('):
+                ReadParentheses();
+                return;
+
+            case TEXT('{'):
+                ReadOpenBrace();
+                return;
+
+            case TEXT('}'):
+                if (Scopes.Num() > 0)
+                {
+                    const FScope Scope = Scopes.Pop(false);
+                    if (Scope.ClassIndex != INDEX_NONE)
+                    {
+                        Classes[Scope.ClassIndex].End = Position + 1;
+                    }
+                }
+                Position++;
+                ResetStatement();
+                return;
+
+            case TEXT(';'):
+                Position++;
+                ResetStatement();
+                return;
+
+            case TEXT('='):
+                bHasAssignment = true;
+                break;
+
+            case TEXT('~'):
+                // Keeps the qualifier of "AMyActor::~AMyActor" for the destructor name
+                if (LastToken == ETokenType::ScopeOperator)
+                {
+                    Position++;
+                    return;
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            BeginToken(ETokenType::Other);
+            Position++;
+        }
+
+        static bool IsAccessSpecifier(FStringView Word)
+        {
+            return Word.Equals(TEXT("public"), ESearchCase::CaseSensitive)
+                || Word.Equals(TEXT("protected"), ESearchCase::CaseSensitive)
+                || Word.Equals(TEXT("private"), ESearchCase::CaseSensitive);
+        }
+
+        void ReadParentheses()
+        {
+            const int32 OpenParen = Position;
+            const int32 CloseParen = FindClosingBracket(OpenParen, TEXT('('), TEXT(')'));
+            if (CloseParen == INDEX_NONE)
+            {
+                Position = Content.Len();
+                return;
+            }
+
+            const bool bAfterIdentifier = LastToken == ETokenType::Identifier;
+            BeginToken(ETokenType::Other);
+            Position = CloseParen + 1;
+
+            if (!bAfterIdentifier)
+                return;
+
+            const FStringView Word = GetView(LastIdentifierStart, LastIdentifierEnd);
+
+            if (Word.Equals(TEXT("UFUNCTION"), ESearchCase::CaseSensitive))
+            {
+                UFunctionStart = LastIdentifierStart;
+                UFunctionEnd = CloseParen + 1;
+                return;
+            }
+
+            if (bHasAssignment || IsKeyword(Word) || IsMacroName(Word))
+                return;
+
+            // A class keyword in front of a function is part of its return type
+            if (PendingScope == EPendingScope::Class)
+            {
+                PendingScope = EPendingScope::None;
+            }
+
+            ReadFunction(OpenParen, CloseParen);
+        }
+
+        /** Reads what follows the parameter list of a possible function, up to its semicolon or the end of its body */
+        void ReadFunction(int32 OpenParen, int32 CloseParen)
+        {
+            bool bIsConst = false;
+            bool bInInitializerList = false;
+            bool bInAssignment = false;
+            TCHAR PreviousChar = TEXT(')');
+            int32 BodyStart = INDEX_NONE;
+            int32 End = INDEX_NONE;
+
+            int32 Index = CloseParen + 1;
+            while (Index < Content.Len() && End == INDEX_NONE)
+            {
+                const EQCE_LexicalKind Kind = Mask->GetKind(Index);
+                const TCHAR Char = Content[Index];
+                if (Kind != EQCE_LexicalKind::Code)
+                {
+                    PreviousChar = Kind == EQCE_LexicalKind::Comment ? PreviousChar : TEXT('"');
+                    Index++;
+                }
+                else if (FChar::IsWhitespace(Char))
+                {
+                    Index++;
+                }
+                else if (Char == TEXT('#') && IsAtLineStart(Index))
+                {
+                    Index = SkipDirective(Index);
+                }
+                else if (IsNameStartChar(Char))
+                {
+                    const int32 WordStart = Index;
+                    while (Index < Content.Len() && IsNameChar(Content[Index]))
+                    {
+                        Index++;
+                    }
+                    bIsConst |= !bInInitializerList && !bInAssignment && GetView(WordStart, Index).Equals(TEXT("const"), ESearchCase::CaseSensitive);
+                    PreviousChar = TEXT('a');
+                }
+                else if (Char == TEXT('('))
+                {
+                    // noexcept(...), macros such as PURE_VIRTUAL(...) and member initializers
+                    const int32 Close = FindClosingBracket(Index, TEXT('('), TEXT(')'));
+                    if (Close == INDEX_NONE)
+                        return;
+                    Index = Close + 1;
+                    PreviousChar = TEXT(')');
+                }
+                else if (Char == TEXT('{'))
+                {
+                    const int32 Close = FindClosingBracket(Index, TEXT('{'), TEXT('}'));
+                    if (Close == INDEX_NONE)
+                        return;
+
+                    // A member initialized with braces, as in ": Value{0}", is not the body
+                    if (bInInitializerList && (IsNameChar(PreviousChar) || PreviousChar == TEXT('>')))
+                    {
+                        Index = Close + 1;
+                        PreviousChar = TEXT('}');
+                    }
+                    else
+                    {
+                        BodyStart = Index;
+                        End = Close + 1;
+                    }
+                }
+                else if (Char == TEXT(';'))
+                {
+                    End = Index + 1;
+                }
+                else if (Char == TEXT('}'))
+                {
+                    // Not a function after all, leave the brace to the scope it closes
+                    return;
+                }
+                else
+                {
+                    if (Char == TEXT(':') && Index + 1 < Content.Len() && Content[Index + 1] == TEXT(':'))
+                    {
+                        Index++;
+                    }
+                    else if (Char == TEXT(':'))
+                    {
+                        bInInitializerList = true;
+                    }
+                    else if (Char == TEXT('='))
+                    {
+                        bInAssignment = true;
+                    }
+                    PreviousChar = Char;
+                    Index++;
+                }
+            }
+
+            if (End == INDEX_NONE)
+                return;
+
+            FQCE_FunctionSymbol& Function = Functions.AddDefaulted_GetRef();
+            Function.Name = bIsDestructorName ? TEXT("~") + FString(GetView(LastIdentifierStart, LastIdentifierEnd)) : FString(GetView(LastIdentifierStart, LastIdentifierEnd));
+            Function.ScopeName = !LastIdentifierQualifier.IsEmpty() ? LastIdentifierQualifier : GetInnermostClassName();
+            Function.NamePosition = LastIdentifierStart;
+            Function.Start = StatementStart;
+            Function.End = End;
+            Function.UFunctionStart = UFunctionStart;
+            Function.UFunctionEnd = UFunctionEnd;
+            Function.bIsDefinition = BodyStart != INDEX_NONE;
+            Function.bIsConst = bIsConst;
+
+            ReadParameters(OpenParen, CloseParen, Function.Parameters);
+
+            Position = End;
+            ResetStatement();
+        }
+
+        /**
+         * Splits the parameter list at its top level commas and normalizes each parameter.
+         * Comments are left out, and unlike QCE_ParameterMatcher::ToParameterArray nothing is logged, workers scan files too.
+         */
+        void ReadParameters(int32 OpenParen, int32 CloseParen, TArray<FString>& OutParameters) const
+        {
+            FString Parameter;
+            int32 BracketDepth = 0;
+            int32 AngleDepth = 0;
+            for (int32 Index = OpenParen + 1; Index < CloseParen; ++Index)
+            {
+                const EQCE_LexicalKind Kind = Mask->GetKind(Index);
+                if (Kind == EQCE_LexicalKind::Comment)
+                {
+                    // Keeps the words around the comment apart
+                    Parameter.AppendChar(TEXT(' '));
+                    continue;
+                }
+
+                const TCHAR Char = Content[Index];
+                if (Kind == EQCE_LexicalKind::Code)
+                {
+                    if (Char == TEXT('(') || Char == TEXT('{') || Char == TEXT('['))
+                    {
+                        BracketDepth++;
+                    }
+                    else if (Char == TEXT(')') || Char == TEXT('}') || Char == TEXT(']'))
+                    {
+                        BracketDepth = FMath::Max(BracketDepth - 1, 0);
+                    }
+                    else if (Char == TEXT('<'))
+                    {
+                        // A template argument list follows a name, a comparison in a default value has a space before it
+                        const TCHAR PreviousChar = Content[Index - 1];
+                        if (IsNameChar(PreviousChar) || PreviousChar == TEXT('>') || PreviousChar == TEXT(':'))
+                        {
+                            AngleDepth++;
+                        }
+                    }
+                    else if (Char == TEXT('>') && AngleDepth > 0)
+                    {
+                        AngleDepth--;
+                    }
+                    else if (Char == TEXT(',') && BracketDepth == 0 && AngleDepth == 0)
+                    {
+                        AddParameter(Parameter, OutParameters);
+                        Parameter.Reset();
+                        continue;
+                    }
+                }
+
+                Parameter.AppendChar(Char);
+            }
+            AddParameter(Parameter, OutParameters);
+        }
+
+        static void AddParameter(const FString& Parameter, TArray<FString>& OutParameters)
+        {
+            const FString Trimmed = Parameter.TrimStartAndEnd();
+            if (!Trimmed.IsEmpty())
+            {
+                OutParameters.Add(QCE_ParameterMatcher::NormalizeParameter(Trimmed));
+            }
+        }
+
+        void ReadOpenBrace()
+        {
+            if (PendingScope == EPendingScope::Class && !PendingClassName.IsEmpty())
+            {
+                FQCE_ClassSymbol& Class = Classes.AddDefaulted_GetRef();
+                Class.Name = PendingClassName;
+                Class.Start = StatementStart != INDEX_NONE ? StatementStart : Position;
+                Scopes.Add(FScope{ Classes.Num() - 1 });
+
+                Position++;
+                ResetStatement();
+                return;
+            }
+
+            if (PendingScope == EPendingScope::Namespace || PendingScope == EPendingScope::Extern)
+            {
+                Scopes.Add(FScope{ INDEX_NONE });
+
+                Position++;
+                ResetStatement();
+                return;
+            }
+
+            // Initializers, enumerators, unnamed types and lambdas hold no declarations worth finding
+            const int32 CloseBrace = FindClosingBracket(Position, TEXT('{'), TEXT('}'));
+            BeginToken(ETokenType::Other);
+            Position = CloseBrace != INDEX_NONE ? CloseBrace + 1 : Content.Len();
+        }
+
+        FString GetInnermostClassName() const
+        {
+            for (int32 Index = Scopes.Num() - 1; Index >= 0; --Index)
+            {
+                if (Scopes[Index].ClassIndex != INDEX_NONE)
+                    return Classes[Scopes[Index].ClassIndex].Name;
+            }
+            return FString();
+        }
+
+        const FString& Content;
+        const TSharedRef<const FQCE_LexicalMask> Mask;
+        TArray<FQCE_ClassSymbol>& Classes;
+        TArray<FQCE_FunctionSymbol>& Functions;
+
+        TArray<FScope> Scopes;
+        int32 Position = 0;
+
+        /** State of the statement being read */
+        int32 StatementStart = INDEX_NONE;
+        EPendingScope PendingScope = EPendingScope::None;
+        FString PendingClassName;
+        bool bInBaseClassList = false;
+        bool bHasAssignment = false;
+        int32 UFunctionStart = INDEX_NONE;
+        int32 UFunctionEnd = INDEX_NONE;
+
+        ETokenType LastToken = ETokenType::None;
+        int32 LastIdentifierStart = INDEX_NONE;
+        int32 LastIdentifierEnd = INDEX_NONE;
+        bool bIsDestructorName = false;
+        FString LastIdentifierQualifier;
+
+        /** The identifier before the last :: */
+        FString PendingQualifier;
+    };
+}
+
+FQCE_SymbolTable::FQCE_SymbolTable(const FString& Content)
+{
+    FSymbolScanner(Content, Classes, Functions).Scan();
+
+    for (int32 Index = 0; Index < Functions.Num(); ++Index)
+    {
+        FunctionsByName.Add(Functions[Index].Name, Index);
+    }
+}
+
+TSharedRef<const FQCE_SymbolTable> FQCE_SymbolTable::Get(const FString& Content)
+{
+    check(IsInGameThread());
+
+    if (Content.Len() < MinCachedTableContentLength)
+    {
+        return MakeShared<FQCE_SymbolTable>(Content);
+    }
+
+    for (int32 Index = CachedTables.Num() - 1; Index >= 0; --Index)
+    {
+        if (CachedTables[Index].Content.Equals(Content, ESearchCase::CaseSensitive))
+        {
+            FCachedTable Entry = MoveTemp(CachedTables[Index]);
+            CachedTables.RemoveAt(Index);
+            return CachedTables.Add_GetRef(MoveTemp(Entry)).Table;
+        }
+    }
+
+    if (CachedTables.Num() >= MaxCachedTables)
+    {
+        CachedTables.RemoveAt(0);
+    }
+
+    return CachedTables.Add_GetRef(FCachedTable{ Content, MakeShared<FQCE_SymbolTable>(Content) }).Table;
+}
+
+void FQCE_SymbolTable::Empty()
+{
+    CachedTables.Empty();
+}
+
+void FQCE_SymbolTable::FindFunctions(const FString& Name, TArray<const FQCE_FunctionSymbol*>& OutFunctions) const
+{
+    TArray<int32, TInlineAllocator<8>> Indices;
+    FunctionsByName.MultiFind(Name, Indices, true);
+
+    for (const int32 Index : Indices)
+    {
+        if (Functions[Index].Name.Equals(Name, ESearchCase::CaseSensitive))
+        {
+            OutFunctions.Add(&Functions[Index]);
+        }
+    }
+}
@@ -6,40 +6,49 @@
 #include "Settings/UQCE_EditorSettings.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 
-void QCE_IndentationManager::IndentLine(SQCE_MultiLineEditableTextBox* TextBox)
+namespace
 {
-	const UQCE_EditorSettings* Settings = GetDefault<UQCE_EditorSettings>();
-	check(Settings);
+	/** Returns the spaces and tabs a line starts with */
+	FStringView GetLeadingWhitespace(const FStringView Line)
+	{
+		int32 Length = 0;
+		while (Length < Line.Len() && (Line[Length] == TEXT(' ') || Line[Length] == TEXT('\t')))
+		{
+			++Length;
+		}
+		return Line.Left(Length);
+	}
+}
 
+void QCE_IndentationManager::IndentLine(SQCE_MultiLineEditableTextBox* TextBox)
+{
 	TSharedPtr< SMultiLineEditableText > EditableText = TextBox->GetEditableText();
 	if (!EditableText.IsValid())
 		return;
 
-	SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
-
 	FTextSelection Selection = EditableText->GetSelection();
 	FTextLocation StartLoc = Selection.GetBeginning();
 	FTextLocation EndLoc = Selection.GetEnd();
 
-	FString FullText = EditableText->GetText().ToString();
-	TArray<FString> Lines;
-	FullText.ParseIntoArrayLines(Lines, false);
-	if (!Lines.IsValidIndex(StartLoc.GetLineIndex()))
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+	const int32 NumLines = Snapshot->GetNumLines();
+	if (StartLoc.GetLineIndex() < 0 || StartLoc.GetLineIndex() >= NumLines)
 		return;
-	if (!Lines.IsValidIndex(EndLoc.GetLineIndex()))
-		EndLoc = FTextLocation(Lines.Num() - 1, 0);
+	if (EndLoc.GetLineIndex() >= NumLines)
+		EndLoc = FTextLocation(NumLines - 1, 0);
 
 	int32 FirstLine = StartLoc.GetLineIndex();
 	int32 LastLine = EndLoc.GetLineIndex();
-	FString IndentToInsert = GetSingleIndentString();
+	const FString IndentToInsert = GetSingleIndentString();
 
-	for (int32 i = FirstLine; i <= LastLine; ++i)
+	// One insert per line, so only the selected lines are touched and the undo step records just those edits
+	TArray<FQCE_TextEdit> Edits;
+	Edits.Reserve(LastLine - FirstLine + 1);
+	for (int32 i = LastLine; i >= FirstLine; --i)
 	{
-		Lines[i].InsertAt(0, IndentToInsert);
+		Edits.Emplace(Snapshot->LocationToPosition(FTextLocation(i, 0)), FString(), IndentToInsert);
 	}
-
-	FString NewText = FString::Join(Lines, TEXT("\n"));
-	TextBox->SetText(FText::FromString(NewText));
+	TextBox->ApplyEdits(MoveTemp(Edits));
 
 	int32 IndentLength = IndentToInsert.Len();
 	if (FirstLine == LastLine)
@@ -70,81 +79,82 @@ void QCE_IndentationManager::UnindentLine(SQCE_MultiLineEditableTextBox* TextBox
 	if (!EditableText.IsValid())
 		return;
 	
-	SMultiLineEditableText::FScopedEditableTextTransaction Transaction(EditableText);
 	FTextSelection Selection = EditableText->GetSelection();
 	FTextLocation StartLoc = Selection.GetBeginning();
 	FTextLocation EndLoc = Selection.GetEnd();
 
-	FString FullText = EditableText->GetText().ToString();
-	TArray<FString> Lines;
-	FullText.ParseIntoArrayLines(Lines, false);
-	if (!Lines.IsValidIndex(StartLoc.GetLineIndex()))
+	// Held on to, the lines are read from this version while the edits below update the text box
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+	const int32 NumLines = Snapshot->GetNumLines();
+	if (StartLoc.GetLineIndex() < 0 || StartLoc.GetLineIndex() >= NumLines)
 		return;
-	if (!Lines.IsValidIndex(EndLoc.GetLineIndex()))
-		EndLoc = FTextLocation(Lines.Num() - 1, 0);
-
-	TArray<int32> RemovedCounts;
-	RemovedCounts.SetNumZeroed(Lines.Num());
+	if (EndLoc.GetLineIndex() >= NumLines)
+		EndLoc = FTextLocation(NumLines - 1, 0);
 
 	int32 FirstLine = StartLoc.GetLineIndex();
 	int32 LastLine = EndLoc.GetLineIndex();
+
+	TArray<int32> RemovedCounts;
+	RemovedCounts.SetNumZeroed(LastLine - FirstLine + 1);
 	
 	for (int32 i = FirstLine; i <= LastLine; ++i)
 	{
-		FString& Line = Lines[i];
+		const FStringView Line = Snapshot->GetLine(i);
 		int32 RemoveCount = 0;
+		const int32 MaxRemove = Settings->TabSpaceCount;
 		
 		if (Settings->IndentationType == EQCEIndentationType::Tabs)
 		{
 			if (Line.StartsWith(TEXT("\t")))
 			{
-				Line.RemoveAt(0);
 				RemoveCount = 1;
 			}
 			else
 			{
-				int32 MaxRemove = Settings->TabSpaceCount;
-				while (RemoveCount < MaxRemove && Line.Len() > 0 && Line[0] == TEXT(' '))
+				while (RemoveCount < MaxRemove && RemoveCount < Line.Len() && Line[RemoveCount] == TEXT(' '))
 				{
-					Line.RemoveAt(0);
 					++RemoveCount;
 				}
 			}
 		}
 		else
 		{
-			int32 MaxRemove = Settings->TabSpaceCount;
-			while (RemoveCount < MaxRemove && Line.Len() > 0 && Line[0] == TEXT(' '))
+			while (RemoveCount < MaxRemove && RemoveCount < Line.Len() && Line[RemoveCount] == TEXT(' '))
 			{
-				Line.RemoveAt(0);
 				++RemoveCount;
 			}
 			if (RemoveCount == 0 && Line.StartsWith(TEXT("\t")))
 			{
-				Line.RemoveAt(0);
 				RemoveCount = 1;
 			}
 		}
 		
-		RemovedCounts[i] = RemoveCount;
+		RemovedCounts[i - FirstLine] = RemoveCount;
 	}
 
-	FString NewText = FString::Join(Lines, TEXT("\n"));
-	EditableText->SetText(FText::FromString(NewText));
+	// Deleting the indentation of each line on its own keeps the edits, and the undo step, to the selected lines
+	TArray<FQCE_TextEdit> Edits;
+	for (int32 i = LastLine; i >= FirstLine; --i)
+	{
+		const int32 RemoveCount = RemovedCounts[i - FirstLine];
+		if (RemoveCount > 0)
+		{
+			Edits.Emplace(Snapshot->LocationToPosition(FTextLocation(i, 0)), FString(Snapshot->GetLine(i).Left(RemoveCount)), FString());
+		}
+	}
+	TextBox->ApplyEdits(MoveTemp(Edits));
 
+	const int32 FirstRemoved = RemovedCounts[0];
+	const int32 LastRemoved = RemovedCounts.Last();
 	if (FirstLine == LastLine)
 	{
-		int32 NewCol = FMath::Max(StartLoc.GetOffset() - RemovedCounts[FirstLine], 0);
+		int32 NewCol = FMath::Max(StartLoc.GetOffset() - FirstRemoved, 0);
 		EditableText->GoTo(FTextLocation(FirstLine, NewCol));
 	}
 	else
 	{
-		int32 NewStartCol = StartLoc.GetOffset();
-		int32 NewEndCol = EndLoc.GetOffset();
-		if (RemovedCounts[FirstLine] > 0)
-			NewStartCol = FMath::Max(NewStartCol - RemovedCounts[FirstLine], 0);
-		if (RemovedCounts[LastLine] > 0)
-			NewEndCol = FMath::Max(NewEndCol - RemovedCounts[LastLine], 0);
+		int32 NewStartCol = FMath::Max(StartLoc.GetOffset() - FirstRemoved, 0);
+		int32 NewEndCol = FMath::Max(EndLoc.GetOffset() - LastRemoved, 0);
 		EditableText->SelectText(
 			FTextLocation(FirstLine, NewStartCol),
 			FTextLocation(LastLine, NewEndCol)
@@ -156,49 +166,16 @@ bool QCE_IndentationManager::GetLineIndentation(const SQCE_MultiLineEditableText
 {
 	TSharedPtr< SMultiLineEditableText > EditableText = TextBox->GetEditableText();
 	const FTextLocation CursorLocation = EditableText->GetCursorLocation();
-	const FString FullText = EditableText->GetText().ToString();
+	const TSharedRef<const FQCE_TextSnapshot>& Snapshot = TextBox->GetSnapshot();
 
-	TArray<FString> Lines;
-	FullText.ParseIntoArrayLines(Lines, false);
-
-	if (!Lines.IsValidIndex(CursorLocation.GetLineIndex()))
+	if (CursorLocation.GetLineIndex() < 0 || CursorLocation.GetLineIndex() >= Snapshot->GetNumLines())
 		return false;
 
-	const FString& CurrentLine = Lines[CursorLocation.GetLineIndex()];
-	OutIndentation = "";
-
-	for (int32 i = 0; i < CurrentLine.Len(); ++i)
-	{
-		const TCHAR& Char = CurrentLine[i];
-		if (Char == TEXT(' ') || Char == TEXT('\t'))
-		{
-			OutIndentation.AppendChar(Char);
-		}
-		else
-		{
-			break;
-		}
-	}
+	OutIndentation = FString(GetLeadingWhitespace(Snapshot->GetLine(CursorLocation.GetLineIndex())));
 
 	if (OutIndentation.IsEmpty())
 	{
-		const int32 NextLineIndex = CursorLocation.GetLineIndex() + 1;
-		if (Lines.IsValidIndex(NextLineIndex))
-		{
-			const FString& NextLine = Lines[NextLineIndex];
-			for (int32 i = 0; i < NextLine.Len(); ++i)
-			{
-				const TCHAR& Char = NextLine[i];
-				if (Char == TEXT(' ') || Char == TEXT('\t'))
-				{
-					OutIndentation.AppendChar(Char);
-				}
-				else
-				{
-					break;
-				}
-			}
-		}
+		OutIndentation = FString(GetLeadingWhitespace(Snapshot->GetLine(CursorLocation.GetLineIndex() + 1)));
 	}
 
 	return true;
@@ -272,58 +249,24 @@ FString QCE_IndentationManager::GetEnterKeyIndentation(const SQCE_MultiLineEdita
 		return TEXT("\n");
 
 	const FTextLocation CursorLocation = EditableText->GetCursorLocation();
-	const FString FullText = EditableText->GetText().ToString();
-	TArray<FString> Lines;
-	FullText.ParseIntoArrayLines(Lines, false);
+	const TSharedRef<const FQCE_TextSnapshot>& Snapshot = TextBox->GetSnapshot();
 	
-	if (!Lines.IsValidIndex(CursorLocation.GetLineIndex()))
+	if (CursorLocation.GetLineIndex() < 0 || CursorLocation.GetLineIndex() >= Snapshot->GetNumLines())
 		return TEXT("\n");
 
-	const FString& CurrentLine = Lines[CursorLocation.GetLineIndex()];
-	
-	FString CurrentIndentation;
-	for (int32 i = 0; i < CurrentLine.Len(); ++i)
-	{
-		const TCHAR& Char = CurrentLine[i];
-		if (Char == TEXT(' ') || Char == TEXT('\t'))
-		{
-			CurrentIndentation.AppendChar(Char);
-		}
-		else
-		{
-			break;
-		}
-	}
+	const FStringView CurrentLine = Snapshot->GetLine(CursorLocation.GetLineIndex());
+	const FString CurrentIndentation(GetLeadingWhitespace(CurrentLine));
 
-	FString TrimmedLine = CurrentLine.TrimEnd();
-	if (TrimmedLine.EndsWith(TEXT("{")))
+	if (CurrentLine.TrimEnd().EndsWith(TEXT("{")))
 	{
 		FString AdditionalIndent = GetSingleIndentString();
 		return TEXT("\n") + CurrentIndentation + AdditionalIndent;
 	}
 
-	const int32 NextLineIndex = CursorLocation.GetLineIndex() + 1;
-	if (Lines.IsValidIndex(NextLineIndex))
+	const FStringView NextIndentation = GetLeadingWhitespace(Snapshot->GetLine(CursorLocation.GetLineIndex() + 1));
+	if (NextIndentation.Len() > CurrentIndentation.Len())
 	{
-		const FString& NextLine = Lines[NextLineIndex];
-		FString NextIndentation;
-		for (int32 i = 0; i < NextLine.Len(); ++i)
-		{
-			const TCHAR& Char = NextLine[i];
-			if (Char == TEXT(' ') || Char == TEXT('\t'))
-			{
-				NextIndentation.AppendChar(Char);
-			}
-			else
-			{
-				break;
-			}
-		}
-
-		if (NextIndentation.Len() > CurrentIndentation.Len())
-		{
-			return TEXT("\n") + NextIndentation;
-		}
+		return TEXT("\n") + FString(NextIndentation);
 	}
 
 	return TEXT("\n") + CurrentIndentation;
@@ -336,14 +279,12 @@ void QCE_IndentationManager::MoveCursorToFirstNonWhitespace(SQCE_MultiLineEditab
 		return;
 
 	const FTextLocation CurrentCursor = EditableText->GetCursorLocation();
-	const FString FullText = EditableText->GetText().ToString();
-	TArray<FString> Lines;
-	FullText.ParseIntoArrayLines(Lines, false);
+	const TSharedRef<const FQCE_TextSnapshot>& Snapshot = TextBox->GetSnapshot();
 	
-	if (!Lines.IsValidIndex(CurrentCursor.GetLineIndex()))
+	if (CurrentCursor.GetLineIndex() < 0 || CurrentCursor.GetLineIndex() >= Snapshot->GetNumLines())
 		return;
 
-	const FString& CurrentLine = Lines[CurrentCursor.GetLineIndex()];
+	const FStringView CurrentLine = Snapshot->GetLine(CurrentCursor.GetLineIndex());
 	
 	int32 FirstNonWhitespaceIndex = 0;
 	for (int32 i = 0; i < CurrentLine.Len(); ++i)
@@ -372,7 +313,40 @@ bool QCE_IndentationManager::HandleSmartBackspace(SQCE_MultiLineEditableTextBox*
 	if (!EditableText.IsValid())
 		return false;
 
-	return false;
+	const FTextSelection Selection = EditableText->GetSelection();
+	const FTextLocation CursorLocation = EditableText->GetCursorLocation();
+	if (Selection.GetBeginning() != Selection.GetEnd() || CursorLocation.GetOffset() <= 0)
+		return false;
+
+	const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
+	const FStringView LineBeforeCursor = Snapshot->GetLine(CursorLocation.GetLineIndex()).Left(CursorLocation.GetOffset());
+	if (LineBeforeCursor.Len() != CursorLocation.GetOffset())
+		return false;
+
+	const int32 RemoveCount = GetSmartBackspaceCount(LineBeforeCursor, Settings->TabSpaceCount);
+	if (RemoveCount == 0)
+		return false;
+
+	TArray<FQCE_TextEdit> Edits;
+	Edits.Emplace(Snapshot->LocationToPosition(CursorLocation) - RemoveCount, FString(LineBeforeCursor.Right(RemoveCount)), FString());
+	TextBox->ApplyEdits(MoveTemp(Edits));
+	return true;
+}
+
+int32 QCE_IndentationManager::GetSmartBackspaceCount(const FStringView LineBeforeCursor, const int32 TabSpaceCount)
+{
+	// Only inside indentation made of spaces, a single space or a tab is deleted the regular way
+	if (LineBeforeCursor.IsEmpty() || TabSpaceCount <= 1)
+		return 0;
+	for (const TCHAR Char : LineBeforeCursor)
+	{
+		if (Char != TEXT(' '))
+			return 0;
+	}
+
+	// Back to the previous indentation stop
+	const int32 RemoveCount = (LineBeforeCursor.Len() - 1) % TabSpaceCount + 1;
+	return RemoveCount > 1 ? RemoveCount : 0;
 }
 
 FString QCE_IndentationManager::GetSingleIndentString()
@@ -13,7 +13,6 @@
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBox.h"
 #include "Editor/MainEditorContainer.h"
 #include "Editor/CustomTextBox/QCE_MultiLineEditableTextBoxWrapper.h"
-#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_CommonIOHelpers.h"
 
 #define LOCTEXT_NAMESPACE "AIContainer"
 
@@ -213,7 +212,7 @@ void QCE_AIContainer::UpdateInputControlsState()
 {
     if (InputTextBox.IsValid())
     {
-        InputTextBox->SetIsReadOnly(!bIsNodeSelected);
+        InputTextBox->SetReadOnlyAndResetUndo(!bIsNodeSelected);
         if (bIsNodeSelected)
         {
             InputTextBox->SetHintText(LOCTEXT("InputHint", "Type your message..."));
@@ -531,17 +530,17 @@ FString QCE_AIContainer::GetSelectedTextFromActiveEditor() const
     // Get the current selection
     FTextSelection Selection = EditableText->GetSelection();
    
-    FString FullText = EditableText->GetText().ToString();
+    const TSharedRef<const FQCE_TextSnapshot> Snapshot = TextBox->GetSnapshot();
     FTextLocation StartLoc = Selection.GetBeginning();
     FTextLocation EndLoc = Selection.GetEnd();
     
-    // Use the existing utility function to convert text locations to string indices efficiently
-    int32 StartIndex = QCE_CommonIOHelpers::ConvertTextLocationToPosition(FullText, StartLoc);
-    int32 EndIndex = QCE_CommonIOHelpers::ConvertTextLocationToPosition(FullText, EndLoc);
+    // The snapshot looks the lines up in its line offset index instead of walking the text
+    int32 StartIndex = Snapshot->LocationToPosition(StartLoc);
+    int32 EndIndex = Snapshot->LocationToPosition(EndLoc);
     
-    if (StartIndex != INDEX_NONE && EndIndex != INDEX_NONE && StartIndex < EndIndex && EndIndex <= FullText.Len())
+    if (StartIndex != INDEX_NONE && EndIndex != INDEX_NONE && StartIndex < EndIndex && EndIndex <= Snapshot->Len())
     {
-        return FullText.Mid(StartIndex, EndIndex - StartIndex);
+        return FString(Snapshot->GetRange(StartIndex, EndIndex - StartIndex));
     }
 
     return FString();
@@ -314,6 +314,14 @@ TSharedRef<SDockTab> UMainEditorContainer::InitQuickCodeEditor()
 								{
 									ToggleGoToLineContainer();
 								})
+								.OnVisibleLinesChanged_Lambda([this](int32 FirstLine, int32 LastLine)
+								{
+									DeclarationMarshaller->SetVisibleLineRange(FirstLine, LastLine);
+									if (DeclarationTextLayout.IsValid())
+									{
+										DeclarationTextLayout->SetVisibleLineRange(FirstLine, LastLine);
+									}
+								})
 								.CreateSlateTextLayout(FCreateSlateTextLayout::CreateLambda(
 									[this](SWidget* InOwningWidget,
 										   const FTextBlockStyle& InDefaultTextStyle) -> TSharedRef<FSlateTextLayout>
@@ -324,12 +332,8 @@ TSharedRef<SDockTab> UMainEditorContainer::InitQuickCodeEditor()
 								))
 								.OnTextChanged_Lambda([this](const FText& NewText)
 								{
-									// Check if returning to original state
-									const FText OriginalContent = bLoadIsolated ? 
-										FText::FromString(DeclarationInfo.FunctionDeclaration) : 
-										FText::FromString(DeclarationInfo.InitialFileContent);
-									
-									const bool bIsNowOriginal = OriginalContent.EqualTo(NewText);
+									// Check if returning to the text as loaded, the text box only compares texts when the length and hash match
+									const bool bIsNowOriginal = DeclarationEditorTextBoxWrapper->GetTextBox()->IsTextUnmodified();
 									
 									DeclarationEditorTextBoxWrapper->SetIsModified(!bIsNowOriginal);
 									if (DeclarationModifiedIndicator.IsValid())
@@ -383,14 +387,18 @@ TSharedRef<SDockTab> UMainEditorContainer::InitQuickCodeEditor()
 								{
 									ToggleGoToLineContainer();
 								})
+								.OnVisibleLinesChanged_Lambda([this](int32 FirstLine, int32 LastLine)
+								{
+									ImplementationMarshaller->SetVisibleLineRange(FirstLine, LastLine);
+									if (ImplementationTextLayout.IsValid())
+									{
+										ImplementationTextLayout->SetVisibleLineRange(FirstLine, LastLine);
+									}
+								})
 								.OnTextChanged_Lambda([this](const FText& NewText)
 								{
-									// Check if returning to original state
-									const FText OriginalContent = bLoadIsolated ? 
-										FText::FromString(ImplementationInfo.FunctionImplementation) : 
-										FText::FromString(ImplementationInfo.InitialFileContent);
-									
-									const bool bIsNowOriginal = OriginalContent.EqualTo(NewText);
+									// Check if returning to the text as loaded, the text box only compares texts when the length and hash match
+									const bool bIsNowOriginal = ImplementationEditorTextBoxWrapper->GetTextBox()->IsTextUnmodified();
 									
 									ImplementationEditorTextBoxWrapper->SetIsModified(!bIsNowOriginal);
 									if (ImplementationModifiedIndicator.IsValid())
@@ -408,7 +416,7 @@ TSharedRef<SDockTab> UMainEditorContainer::InitQuickCodeEditor()
 											                          GetName()
 											                          : TEXT("");
 										const FString FilePath = ImplementationInfo.CppPath;
-										const FString NewFunctionCode = NewText.ToString();
+										const FString& NewFunctionCode = NewText.ToString();
 
 										FQCEAIConversation& Conversation = QCE_AIConversationTracker::Get().
 											GetOrCreateConversation(FunctionName, ClassName, FilePath);
@@ -580,6 +588,8 @@ TSharedRef<SDockTab> UMainEditorContainer::InitQuickCodeEditor()
 
 	ImplementationEditorTextBoxWrapper->GetTextBox()->FQCE_TextLayout = ImplementationTextLayout;
 	DeclarationEditorTextBoxWrapper->GetTextBox()->FQCE_TextLayout = DeclarationTextLayout;
+	ImplementationMarshaller->SetLazyHighlightLayout(ImplementationTextLayout);
+	DeclarationMarshaller->SetLazyHighlightLayout(DeclarationTextLayout);
 	CodeEditorTab = NewTab;
 	DeclarationMarshaller->SetHighlighterEnabled(DeclarationEditorTextBoxWrapper->GetTextBox().IsValid() && DeclarationEditorTextBoxWrapper->GetTextBox()->IsNodeSelected());
 	ImplementationMarshaller->SetHighlighterEnabled(ImplementationEditorTextBoxWrapper->GetTextBox().IsValid() && ImplementationEditorTextBoxWrapper->GetTextBox()->IsNodeSelected());
@@ -826,7 +836,7 @@ void UMainEditorContainer::RefreshEditorCode(const UObject* InNewSelectedNode)
 			ImplementationMarshaller->SetHighlighterEnabled(true);
 			ImplementationEditorTextBoxWrapper->SetNodeSelected(true);
 			const FText InitialText = bLoadIsolated ? FText::FromString(ImplementationCode) : FText::FromString(ImplementationInfo.InitialFileContent);
-			ImplementationEditorTextBoxWrapper->SetText(InitialText);
+			ImplementationEditorTextBoxWrapper->GetTextBox()->LoadText(InitialText);
 			ImplementationEditorTextBoxWrapper->SetIsModified(false);
 			ImplementationEditorTextBoxWrapper->SetIsReadOnly(ShouldFileBeReadOnly(ImplementationInfo.CppPath) || ImplementationCode.IsEmpty());
 			ImplementationEditorTextBoxWrapper->GetTextBox()->SetTextBoxType(ETextBoxType::Implementation);
@@ -845,7 +855,7 @@ void UMainEditorContainer::RefreshEditorCode(const UObject* InNewSelectedNode)
 	else if (ImplementationEditorTextBoxWrapper.IsValid())
 	{
 		ImplementationMarshaller->SetHighlighterEnabled(false);
-		ImplementationEditorTextBoxWrapper->SetText(FText::FromString(""));
+		ImplementationEditorTextBoxWrapper->GetTextBox()->LoadText(FText::GetEmpty());
 		ImplementationEditorTextBoxWrapper->SetToolTip(SNew(SToolTip).Text(FText::FromString("No function selected. Select a node in Blueprint editor to begin editing.")));
 		ImplementationEditorTextBoxWrapper->SetIsReadOnly(true);
 		ImplementationEditorTextBoxWrapper->SetNodeSelected(false);
@@ -865,7 +875,7 @@ void UMainEditorContainer::RefreshEditorCode(const UObject* InNewSelectedNode)
 			DeclarationMarshaller->SetHighlighterEnabled(true);
 			DeclarationEditorTextBoxWrapper->SetNodeSelected(true);
 			const FText InitialText = bLoadIsolated ? FText::FromString(FunctionDeclaration) : FText::FromString(DeclarationInfo.InitialFileContent);
-			DeclarationEditorTextBoxWrapper->SetText(InitialText);
+			DeclarationEditorTextBoxWrapper->GetTextBox()->LoadText(InitialText);
 			DeclarationEditorTextBoxWrapper->SetIsModified(false);
 			DeclarationEditorTextBoxWrapper->SetIsReadOnly(ShouldFileBeReadOnly(DeclarationInfo.HeaderPath) || FunctionDeclaration.IsEmpty());
 			DeclarationEditorTextBoxWrapper->GetTextBox()->SetTextBoxType(ETextBoxType::Declaration);
@@ -883,7 +893,7 @@ void UMainEditorContainer::RefreshEditorCode(const UObject* InNewSelectedNode)
 	else if (DeclarationEditorTextBoxWrapper.IsValid())
 	{
 		DeclarationMarshaller->SetHighlighterEnabled(false);
-		DeclarationEditorTextBoxWrapper->SetText(FText::FromString(""));
+		DeclarationEditorTextBoxWrapper->GetTextBox()->LoadText(FText::GetEmpty());
 		DeclarationEditorTextBoxWrapper->SetToolTip(SNew(SToolTip).Text(FText::FromString("No function selected. Select a node in Blueprint editor to begin editing.")));
 		DeclarationEditorTextBoxWrapper->SetIsReadOnly(true);
 		DeclarationEditorTextBoxWrapper->SetNodeSelected(false);
@@ -1077,6 +1087,7 @@ void UMainEditorContainer::ToggleSearchContainer()
         SearchContainer->FocusFindTextBox();
     } else
     {
+        SearchContainer->EndSearch();
         SearchContainer->SetVisibility(EVisibility::Collapsed);
     }
 }
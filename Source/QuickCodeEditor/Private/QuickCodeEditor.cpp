@@ -17,6 +17,11 @@
 #include "BlueprintEditor.h"
 #include "Editor/FQCESummoner.h"
 #include "Editor/CustomTextBox/CodeCompletion/DropdownCodeCompletionEngine.h"
+#include "Editor/CustomTextBox/FindAndReplace/QCE_RegexPatternCache.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_LexicalMask.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_ProjectSymbolIndex.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SourceFileCache.h"
+#include "Editor/CustomTextBox/Utility/CppIO/Helpers/QCE_SymbolTable.h"
 #include "Framework/Docking/LayoutExtender.h"
 #include "Framework/Docking/TabManager.h"
 
@@ -33,6 +38,8 @@ void FQuickCodeEditorModule::StartupModule()
 	FQCECommands::Register();
 	CompletionEngine = MakeUnique<FDropdownCodeCompletionEngine>();
 	CompletionEngine->Initialize();
+	ProjectSymbolIndex = MakeUnique<FQCE_ProjectSymbolIndex>();
+	ProjectSymbolIndex->Initialize();
 }
 
 void FQuickCodeEditorModule::ShutdownModule()
@@ -46,6 +53,15 @@ void FQuickCodeEditorModule::ShutdownModule()
 	}
 	EditorInstanceMap.Empty();
 	CompletionEngine.Reset();
+	if (ProjectSymbolIndex)
+	{
+		ProjectSymbolIndex->Shutdown();
+		ProjectSymbolIndex.Reset();
+	}
+	FQCE_RegexPatternCache::Empty();
+	FQCE_LexicalMask::Empty();
+	FQCE_SourceFileCache::Empty();
+	FQCE_SymbolTable::Empty();
 	
 	UnregisterSettings();
 	FQCECommands::Unregister();
@@ -51,6 +51,8 @@ void UQCE_EditorSettings::SetKeybindings()
 	IndentKeybinding = FInputChord(EKeys::Tab);
 	UnindentKeybinding = FInputChord(EKeys::Tab, EModifierKey::Shift);
 	GoToLineKeybinding = FInputChord(EKeys::G, EModifierKey::Control);
+	UndoKeybinding = FInputChord(EKeys::Z, EModifierKey::Control);
+	RedoKeybinding = FInputChord(EKeys::Y, EModifierKey::Control);
 	AIInlineCompletionKeybinding = FInputChord(EKeys::SpaceBar, EModifierKey::Control);
 	AutocompletionDropdownKeybinding = FInputChord(EKeys::SpaceBar, EModifierKey::Control | EModifierKey::Shift);
 	CancelInlineAISuggestionKeybinding = FInputChord(EKeys::Escape);
@@ -89,6 +91,15 @@ bool UQCE_EditorSettings::ResetToDefaults()
 	bUseBoldFont = false;
 	TabSpaceCount = 4;
 	IndentationType = EQCEIndentationType::Tabs;
+	bLazySyntaxHighlighting = true;
+	LazyHighlightMinLines = 2000;
+	LazyHighlightMarginLines = 100;
+	LazyHighlightFrameBudgetMs = 2.0f;
+	bBackgroundTokenization = true;
+	BackgroundTokenizationMinLines = 1000;
+	WordHighlightDelaySeconds = 0.15f;
+	MaxWordHighlightsPerFrame = 200;
+	UndoHistoryMemoryLimitMB = 32;
 
 	// Reset Keybindings
 	SetKeybindings();
@@ -0,0 +1,31 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_HighlighterBenchmark.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQCE_HighlighterBenchmarkTest, "QCE.Benchmark.Highlighter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FQCE_HighlighterBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TArray<FQCE_HighlighterBenchmark::FResult> Results;
+	const bool bSaved = FQCE_HighlighterBenchmark::RunAndSave(FQCE_HighlighterBenchmark::GetDefaultLineCounts(), FQCE_HighlighterBenchmark::DefaultNumKeystrokes, Results);
+	TestTrue(TEXT("Results saved as CSV and JSON"), bSaved);
+
+	if (TestTrue(TEXT("Every document measured"), Results.Num() >= FQCE_HighlighterBenchmark::GetDefaultLineCounts().Num() * 2))
+	{
+		for (const FQCE_HighlighterBenchmark::FResult& Result : Results)
+		{
+			const FString Name = FString::Printf(TEXT("%s %d lines (%s)"), *Result.DocumentKind, Result.NumLines, *Result.ScanMode);
+			TestTrue(Name + TEXT(" tokens"), Result.NumTokens > 0);
+			TestTrue(Name + TEXT(" tokenize time"), Result.TokenizeMs > 0.0);
+			TestTrue(Name + TEXT(" highlight time"), Result.HighlightMs > 0.0);
+		}
+	}
+
+	return true;
+}
+
+#endif
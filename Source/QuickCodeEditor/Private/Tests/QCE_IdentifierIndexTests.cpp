@@ -0,0 +1,45 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_IdentifierIndex.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQCE_IdentifierIndexCaseTest, "QuickCodeEditor.SyntaxHighlight.IdentifierIndex.CaseSensitive",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FQCE_IdentifierIndexCaseTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FCppSyntaxTokenizer> Tokenizer = FCppSyntaxTokenizer::Create();
+	TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines;
+	Tokenizer->Process(TokenizedLines, TEXT("int32 Foo = 0;\nint32 foo = Foo;\nfoo = FOO;"));
+
+	FQCE_IdentifierIndex Index;
+	Index.Rebuild(*Tokenizer);
+
+	TestEqual(TEXT("Foo occurrences"), Index.CountOccurrences(TEXT("Foo")), 2);
+	TestEqual(TEXT("foo occurrences"), Index.CountOccurrences(TEXT("foo")), 2);
+	TestEqual(TEXT("FOO occurrences"), Index.CountOccurrences(TEXT("FOO")), 1);
+	TestEqual(TEXT("fOO occurrences"), Index.CountOccurrences(TEXT("fOO")), 0);
+
+	TArray<FQCE_IdentifierIndex::FOccurrence> Occurrences;
+	Index.FindOccurrences(TEXT("foo"), 0, Index.GetNumLines() - 1, Occurrences);
+	if (TestEqual(TEXT("foo found occurrences"), Occurrences.Num(), 2))
+	{
+		TestEqual(TEXT("First foo line"), Occurrences[0].LineIndex, 1);
+		TestEqual(TEXT("First foo offset"), Occurrences[0].BeginOffset, 6);
+		TestEqual(TEXT("Second foo line"), Occurrences[1].LineIndex, 2);
+		TestEqual(TEXT("Second foo offset"), Occurrences[1].BeginOffset, 0);
+	}
+
+	// Re-indexing after an edit keeps the words apart as well
+	Tokenizer->Process(TokenizedLines, TEXT("int32 Foo = 0;\nint32 Foo = Foo;\nfoo = FOO;"));
+	Index.ApplyDirtyLines(*Tokenizer);
+	TestEqual(TEXT("Foo occurrences after edit"), Index.CountOccurrences(TEXT("Foo")), 3);
+	TestEqual(TEXT("foo occurrences after edit"), Index.CountOccurrences(TEXT("foo")), 1);
+
+	return true;
+}
+
+#endif
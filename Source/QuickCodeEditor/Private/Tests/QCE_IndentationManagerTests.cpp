@@ -0,0 +1,39 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Utility/Indentation/QCE_IndentationManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQCE_SmartBackspaceIndentStopTest, "QuickCodeEditor.Indentation.SmartBackspace.IndentStop",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FQCE_SmartBackspaceIndentStopTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Full indent level"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("    "), 4), 4);
+	TestEqual(TEXT("Second indent level"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("        "), 4), 4);
+	TestEqual(TEXT("Between indent stops"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("      "), 4), 2);
+	TestEqual(TEXT("Three spaces"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("   "), 4), 3);
+	TestEqual(TEXT("Two space indent"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("    "), 2), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQCE_SmartBackspaceRegularTest, "QuickCodeEditor.Indentation.SmartBackspace.Regular",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FQCE_SmartBackspaceRegularTest::RunTest(const FString& Parameters)
+{
+	// Every case falls back to the regular single character Backspace
+	TestEqual(TEXT("Start of line"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT(""), 4), 0);
+	TestEqual(TEXT("After code"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("    int32 Value"), 4), 0);
+	TestEqual(TEXT("Spaces after code"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("Value    "), 4), 0);
+	TestEqual(TEXT("Tab indentation"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("\t"), 4), 0);
+	TestEqual(TEXT("Spaces after a tab"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("\t    "), 4), 0);
+	TestEqual(TEXT("One space past an indent stop"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("     "), 4), 0);
+	TestEqual(TEXT("Single space indent"), QCE_IndentationManager::GetSmartBackspaceCount(TEXT("    "), 1), 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,82 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#include "Editor/CustomTextBox/Document/QCE_UndoHistory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQCE_UndoHistoryTypingTest, "QuickCodeEditor.Document.UndoHistory.MergeTyping",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FQCE_UndoHistoryTypingTest::RunTest(const FString& Parameters)
+{
+	FQCE_UndoHistory History;
+
+	// "abc" typed one character at a time is one step
+	History.PushTyping(FQCE_TextEdit(0, FString(), TEXT("a")));
+	History.PushTyping(FQCE_TextEdit(1, FString(), TEXT("b")));
+	History.PushTyping(FQCE_TextEdit(2, FString(), TEXT("c")));
+	const TArray<FQCE_TextEdit>* Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Typed step"), Step) && TestEqual(TEXT("Typed step edits"), Step->Num(), 1))
+	{
+		TestEqual(TEXT("Typed step position"), (*Step)[0].Position, 0);
+		TestEqual(TEXT("Typed step inserted"), (*Step)[0].Inserted, FString(TEXT("abc")));
+	}
+
+	// A line break starts a new step, and so does the typing after it
+	History.PushTyping(FQCE_TextEdit(3, FString(), TEXT("\n")));
+	History.PushTyping(FQCE_TextEdit(4, FString(), TEXT("d")));
+	History.Undo();
+	History.Undo();
+	Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Step before the line break"), Step))
+	{
+		TestEqual(TEXT("Step before the line break inserted"), (*Step)[0].Inserted, FString(TEXT("abc")));
+	}
+
+	// Nothing merges into a step that was undone and redone
+	History.Redo();
+	History.Redo();
+	History.PushTyping(FQCE_TextEdit(5, FString(), TEXT("e")));
+	Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Step after redo"), Step))
+	{
+		TestEqual(TEXT("Step after redo inserted"), (*Step)[0].Inserted, FString(TEXT("e")));
+	}
+
+	// Backspacing "de" of "abc\nde" joins into one removal
+	History.Reset();
+	History.PushTyping(FQCE_TextEdit(5, TEXT("e"), FString()));
+	History.PushTyping(FQCE_TextEdit(4, TEXT("d"), FString()));
+	Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Backspace step"), Step))
+	{
+		TestEqual(TEXT("Backspace step position"), (*Step)[0].Position, 4);
+		TestEqual(TEXT("Backspace step removed"), (*Step)[0].Removed, FString(TEXT("de")));
+	}
+
+	// Typing somewhere else starts a new step
+	History.PushTyping(FQCE_TextEdit(0, FString(), TEXT("x")));
+	History.PushTyping(FQCE_TextEdit(3, FString(), TEXT("y")));
+	History.Undo();
+	Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Step before the jump"), Step))
+	{
+		TestEqual(TEXT("Step before the jump inserted"), (*Step)[0].Inserted, FString(TEXT("x")));
+	}
+
+	// A pasted text is a step of its own
+	History.Reset();
+	History.PushTyping(FQCE_TextEdit(0, FString(), TEXT("pasted")));
+	History.PushTyping(FQCE_TextEdit(6, FString(), TEXT("z")));
+	History.Undo();
+	Step = History.PeekUndo();
+	if (TestNotNull(TEXT("Pasted step"), Step))
+	{
+		TestEqual(TEXT("Pasted step inserted"), (*Step)[0].Inserted, FString(TEXT("pasted")));
+	}
+
+	return true;
+}
+
+#endif
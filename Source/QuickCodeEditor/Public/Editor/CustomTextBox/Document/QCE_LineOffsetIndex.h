@@ -0,0 +1,47 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Text/TextLayout.h"
+
+/**
+ * Range of every line of a document in its flat text, for converting between FTextLocation and absolute positions.
+ * Positions match the text returned by the text box's GetText, whatever line terminator it uses.
+ * An edit only rescans the lines around the changed characters and shifts the ones after them,
+ * and conversions are a binary search over the line starts instead of a walk over the text.
+ */
+class QUICKCODEEDITOR_API FQCE_LineOffsetIndex
+{
+public:
+	/** Indexes every line of Text */
+	void Rebuild(const FString& Text);
+
+	/**
+	 * Updates the index after the characters [ChangeBegin, OldChangeEnd) of the indexed text were replaced,
+	 * giving NewText where they now span [ChangeBegin, NewChangeEnd).
+	 */
+	void ApplyEdit(const FString& NewText, int32 ChangeBegin, int32 OldChangeEnd, int32 NewChangeEnd);
+
+	int32 GetNumLines() const { return LineRanges.Num(); }
+
+	int32 GetTextLength() const { return TextLength; }
+
+	/** Returns the range of a line in the text, without its line terminator */
+	const FTextRange& GetLineRange(int32 LineIndex) const { return LineRanges[LineIndex]; }
+
+	/** Converts a location to a position in the text, INDEX_NONE if the location is past the end of its line or of the text */
+	int32 LocationToPosition(const FTextLocation& Location) const;
+
+	/**
+	 * Converts a position in the text to a location. Positions inside a line terminator map to the end of the line,
+	 * positions outside the text map to (0, 0).
+	 */
+	FTextLocation PositionToLocation(int32 Position) const;
+
+private:
+	/** Line ranges in line order, so their begin indices are sorted */
+	TArray<FTextRange> LineRanges;
+
+	int32 TextLength = 0;
+};
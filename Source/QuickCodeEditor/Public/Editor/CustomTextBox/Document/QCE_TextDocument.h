@@ -0,0 +1,109 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Editor/CustomTextBox/Document/QCE_LineOffsetIndex.h"
+
+/** Replacement of a range of a text: the Removed text at Position was replaced with the Inserted text */
+struct FQCE_TextEdit
+{
+	int32 Position = 0;
+
+	FString Removed;
+
+	FString Inserted;
+
+	FQCE_TextEdit() = default;
+
+	FQCE_TextEdit(const int32 InPosition, FString InRemoved, FString InInserted)
+		: Position(InPosition)
+		, Removed(MoveTemp(InRemoved))
+		, Inserted(MoveTemp(InInserted))
+	{
+	}
+};
+
+/**
+ * The text of a document at one version, with its line ranges. Never changes once created,
+ * so it can be held on to while the document moves on.
+ * Slate already builds the flat text of every edit for OnTextChanged, the snapshot shares that text instead of copying it.
+ */
+class QUICKCODEEDITOR_API FQCE_TextSnapshot
+{
+public:
+	FQCE_TextSnapshot(uint32 InVersion, const FText& InText, FQCE_LineOffsetIndex&& InLineOffsets, uint64 InContentHash);
+
+	uint32 GetVersion() const { return Version; }
+
+	/**
+	 * Hash of the text, see FQCE_TextDocument::HashString. Snapshots with different hashes have different texts,
+	 * equal hashes still need an exact compare to be sure.
+	 */
+	uint64 GetContentHash() const { return ContentHash; }
+
+	/** The whole text, as GetText on the text box would return it */
+	const FString& GetString() const { return Text.ToString(); }
+
+	int32 Len() const { return GetString().Len(); }
+
+	int32 GetNumLines() const { return LineOffsets.GetNumLines(); }
+
+	const FQCE_LineOffsetIndex& GetLineOffsets() const { return LineOffsets; }
+
+	/** Returns the text of a line without its line terminator, empty if the line does not exist */
+	FStringView GetLine(int32 LineIndex) const;
+
+	/** Returns the text of a range, clamped to the text */
+	FStringView GetRange(int32 Position, int32 Count) const;
+
+	/** See FQCE_LineOffsetIndex::LocationToPosition */
+	int32 LocationToPosition(const FTextLocation& Location) const { return LineOffsets.LocationToPosition(Location); }
+
+	/** See FQCE_LineOffsetIndex::PositionToLocation */
+	FTextLocation PositionToLocation(int32 Position) const { return LineOffsets.PositionToLocation(Position); }
+
+	/** Returns true if the text is exactly Other */
+	bool Equals(const FString& Other) const { return GetString().Equals(Other, ESearchCase::CaseSensitive); }
+
+private:
+	uint32 Version;
+
+	FText Text;
+
+	FQCE_LineOffsetIndex LineOffsets;
+
+	uint64 ContentHash;
+};
+
+/**
+ * Mirror of the text of an editable text box, updated from its OnTextChanged.
+ * Plugin code reads the current snapshot instead of calling GetText, which builds a new string out of the layout on every call.
+ */
+class QUICKCODEEDITOR_API FQCE_TextDocument
+{
+public:
+	FQCE_TextDocument();
+
+	/**
+	 * Takes the text after an edit and makes it the current snapshot.
+	 * The line ranges are only rescanned, and the content hash only updated, around the characters that differ from the previous snapshot.
+	 * @param OutEdit If set, receives the range that differs as a single edit of the previous text
+	 */
+	void SetText(const FText& NewText, FQCE_TextEdit* OutEdit = nullptr);
+
+	/**
+	 * Rolling hash of a whole text: the sum of a hash of every character paired with the one before it.
+	 * An edit only changes the pairs it touches, so SetText can update the hash without rehashing the rest of the text.
+	 */
+	static uint64 HashString(FStringView String);
+
+	/** Changes whenever the text changes */
+	uint32 GetVersion() const { return Snapshot->GetVersion(); }
+
+	/** The current text. Holding on to the snapshot keeps that version alive. */
+	const TSharedRef<const FQCE_TextSnapshot>& GetSnapshot() const { return Snapshot; }
+
+private:
+	TSharedRef<const FQCE_TextSnapshot> Snapshot;
+};
@@ -0,0 +1,71 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Editor/CustomTextBox/Document/QCE_TextDocument.h"
+
+/**
+ * Undo and redo steps of a text box, kept as the ranges each step replaced rather than copies of the whole text.
+ * A step is a list of non-overlapping edits sorted back to front, each one's position being in the text before the step.
+ * Once the steps take more memory than UQCE_EditorSettings::UndoHistoryMemoryLimitMB, the oldest ones are dropped.
+ */
+class QUICKCODEEDITOR_API FQCE_UndoHistory
+{
+public:
+	/** Records a step that was just applied and drops the steps that could be redone */
+	void Push(TArray<FQCE_TextEdit>&& Edits);
+
+	/**
+	 * Records a typed edit. A single character typed, backspaced or deleted right where the previous typed step
+	 * left off joins that step, so undo reverts a run of typing at once. Line breaks and jumps start a new step.
+	 */
+	void PushTyping(FQCE_TextEdit&& Edit);
+
+	/** The step Undo would revert, nullptr if there is none */
+	const TArray<FQCE_TextEdit>* PeekUndo() const;
+
+	/** The step Redo would apply again, nullptr if there is none */
+	const TArray<FQCE_TextEdit>* PeekRedo() const;
+
+	/** Marks the step returned by PeekUndo as reverted */
+	void Undo();
+
+	/** Marks the step returned by PeekRedo as applied again */
+	void Redo();
+
+	/** Forgets every step, e.g. when a different file is loaded */
+	void Reset();
+
+	/** Memory held by the text of the steps */
+	SIZE_T GetAllocatedSize() const { return AllocatedSize; }
+
+private:
+	struct FStep
+	{
+		TArray<FQCE_TextEdit> Edits;
+		SIZE_T AllocatedSize = 0;
+	};
+
+	/** Adds a step past the applied ones and drops the steps that could be redone */
+	FStep& AddStep(TArray<FQCE_TextEdit>&& Edits);
+
+	/** Joins Edit to the typing step on top of the history, false if it does not continue it */
+	bool TryMergeTyping(const FQCE_TextEdit& Edit);
+
+	/** Recounts the memory of a step after its edits changed */
+	void UpdateAllocatedSize(FStep& Step);
+
+	/** Drops the oldest steps until the history fits in the memory limit. The newest step is always kept. */
+	void TrimToMemoryLimit();
+
+	/** Oldest first. The first NumApplied steps can be undone, the others redone. */
+	TArray<FStep> Steps;
+
+	int32 NumApplied = 0;
+
+	SIZE_T AllocatedSize = 0;
+
+	/** Whether the newest applied step was typed and can still take more typing */
+	bool bLastStepIsTyping = false;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Editor/CustomTextBox/FindAndReplace/QCE_SearchSession.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SCheckBox.h"
@@ -27,6 +28,11 @@ public:
     void SetFindText(const FString& TextToFind) const;
     void FocusFindTextBox() const;
 
+    /** Drops the search matches and their highlights, e.g. when the panel gets hidden */
+    void EndSearch();
+
+    virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 private:
     UMainEditorContainer* ParentEditor = nullptr;
     
@@ -37,17 +43,45 @@ private:
     TSharedPtr<SButton> ReplaceAllButton;
     TSharedPtr<SCheckBox> MatchCaseCheckBox;
     TSharedPtr<SCheckBox> WholeWordCheckBox;
+    TSharedPtr<SCheckBox> RegexCheckBox;
 
-    FReply OnFindClicked() const;
+    FReply OnFindClicked();
     FReply OnReplaceClicked() const;
     FReply OnReplaceAllClicked() const;
     void OnMatchCaseChanged(ECheckBoxState NewState);
     void OnWholeWordChanged(ECheckBoxState NewState);
+    void OnRegexChanged(ECheckBoxState NewState);
     FReply OnCloseClicked();
     FReply OnFindTextKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent);
+    void OnFindTextChanged(const FText& NewText);
+
+    /**
+     * Brings the search session up to date with the query, the options and the active text box, and highlights the matches.
+     * Optionally selects the match at or right after the cursor, so the selection follows the query as it is typed.
+     */
+    void UpdateSearch(bool bSelectNearestMatch);
+
+    /** Highlights the matches of the search session, optionally selecting the one at or right after the cursor */
+    void ShowSearchResults(bool bSelectNearestMatch);
+
+    /** Selects a match of the search session in the searched text box and scrolls to it */
+    void SelectMatch(int32 MatchIndex);
+
+    /** Returns the "N of M" text shown next to the find box */
+    FText GetMatchCountText() const;
+
+    /** Matches of the current query in the searched text box */
+    FQCE_SearchSession SearchSession;
+
+    /** Text box the search session was filled from */
+    TWeakPtr<SQCE_MultiLineEditableTextBox> SearchedTextBox;
 
     bool bMatchCase = true;
     bool bWholeWord = true;
+    bool bRegex = false;
+
+    /** The query changed while typing and its worker search has not finished yet, select a match once it does */
+    bool bSelectMatchWhenSearchFinishes = false;
 
     void ReplaceOccurrence(const FText& FindTerm, const FText& ReplaceTerm) const;
     
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Framework/Text/TextLayout.h"
 
 class SQCE_MultiLineEditableTextBox;
 
@@ -11,20 +12,23 @@ class SQCE_MultiLineEditableTextBox;
  * 
  * This utility class handles search operations with support for case sensitivity and whole word matching,
  * enabling precise text manipulation within the QuickCodeEditor's text editing interface.
+ * Finding and stepping through matches goes through FQCE_SearchSession.
  */
 class QUICKCODEEDITOR_API QCE_FindAndReplaceManager
 {
 public:
-    /** Finds the next occurrence of the specified search term in the text box. */
-    static bool FindOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, bool bMatchCase = true, bool bWholeWord = true, int32* OutNextOccurrenceLine = nullptr);
-
-    /**  Replaces the next occurrence of the search term with the replacement text. */
-    static bool ReplaceOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase = true, bool bWholeWord = true);
+    /**
+     * Replaces the next occurrence of the search term with the replacement text.
+     * With bRegex, $0 to $9 in the replacement insert the capture groups of the match.
+     */
+    static bool ReplaceOccurrence(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase = true, bool bWholeWord = true, bool bRegex = false);
 
     /**
-     * Replaces all occurrences of the search term with the replacement text
+     * Replaces all occurrences of the search term with the replacement text.
+     * The replacements are applied as a single undo transaction.
+     * With bRegex, $0 to $9 in the replacement insert the capture groups of each match.
      */
-    static void ReplaceOccurrences(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord);
+    static void ReplaceOccurrences(SQCE_MultiLineEditableTextBox* TextBox, const FText& FindTerm, const FText& ReplaceTerm, bool bMatchCase, bool bWholeWord, bool bRegex = false);
 
 private:
     /**
@@ -33,7 +37,16 @@ private:
     static bool IsWholeWordMatch(const FString& TextString, int32 FindPos, int32 FindLength);
 
     /**
-     * Converts an absolute character position to line and column coordinates
+     * Finds the first match starting at or after StartPos, wrapping around to the start of the text.
+     * For a regex, OutReplacement receives ReplaceString with the capture groups of the match expanded.
      */
-    static void ConvertAbsolutePositionToLocation(const FString& TextString, int32 AbsolutePos, int32& OutLineIndex, int32& OutColumnOffset);
+    static bool FindNextMatch(const FString& TextString, const FString& FindString, int32 StartPos, bool bMatchCase, bool bWholeWord, bool bRegex,
+        const FString& ReplaceString, int32& OutPos, int32& OutLength, FString& OutReplacement);
+
+    /** Collects the start of every non-overlapping occurrence of FindString, in text order */
+    static void FindAllOccurrences(const FString& TextString, const FString& FindString, bool bMatchCase, bool bWholeWord, TArray<int32>& OutPositions);
+
+    /** Collects every non-empty match of a regex in text order, with its length and its replacement text */
+    static void FindAllRegexMatches(const FString& TextString, const FString& Pattern, bool bMatchCase, bool bWholeWord, const FString& ReplaceString,
+        TArray<int32>& OutPositions, TArray<int32>& OutLengths, TArray<FString>& OutReplacements);
 };
\ No newline at end of file
@@ -0,0 +1,28 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+
+/**
+ * Keeps the most recently used find patterns compiled, so a regex is compiled once per query change
+ * instead of on every Find or Replace.
+ *
+ * Must be used from the game thread. The compiled patterns themselves can be shared with worker threads.
+ */
+class QUICKCODEEDITOR_API FQCE_RegexPatternCache
+{
+public:
+    /** Returns the compiled pattern, compiling it if it is not cached. An invalid pattern compiles to one that never matches. */
+    static TSharedRef<const FRegexPattern, ESPMode::ThreadSafe> Get(const FString& Pattern, bool bMatchCase);
+
+    /** Drops every compiled pattern. Called on module shutdown, before the regex backend goes away. */
+    static void Empty();
+
+    /**
+     * Expands the capture group references of a regex replacement for the current match of Matcher.
+     * $0 to $9 insert the matching capture group and $$ inserts a single $.
+     */
+    static FString ExpandReplacement(const FString& Replacement, FRegexMatcher& Matcher);
+};
@@ -0,0 +1,119 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Text/TextLayout.h"
+#include "Editor/CustomTextBox/Document/QCE_TextDocument.h"
+
+#include <atomic>
+
+class FRegexPattern;
+
+/**
+ * Keeps the matches of a find query over a snapshot of a text box's text.
+ *
+ * The text is only searched again when the text box has a new snapshot. When a literal query grows
+ * (e.g. while the user types it) with the same options, the previous matches are narrowed down
+ * instead of searching the whole text again.
+ *
+ * Regex queries are compiled once per query change. On large texts they are matched on a worker thread,
+ * and a scan that is still running is cancelled when the query or the text changes.
+ */
+class QUICKCODEEDITOR_API FQCE_SearchSession
+{
+public:
+    ~FQCE_SearchSession();
+
+    /** Drops the text and the matches, e.g. when the searched text box changes */
+    void Reset();
+
+    /** Returns true if the session searches the text of the given version */
+    bool HasText(uint32 InTextVersion) const { return Snapshot.IsValid() && Snapshot->GetVersion() == InTextVersion; }
+
+    /** Replaces the searched text. The current query is searched again. */
+    void SetText(const TSharedRef<const FQCE_TextSnapshot>& InSnapshot);
+
+    /**
+     * Sets the query and its options. Narrows the previous matches when a literal query extends the previous one,
+     * otherwise searches the whole text.
+     */
+    void SetQuery(const FString& InQuery, bool bInMatchCase, bool bInWholeWord, bool bInRegex);
+
+    const FString& GetQuery() const { return Query; }
+
+    /** Returns true while a regex scan runs on a worker thread. The matches are empty until it finishes. */
+    bool IsSearching() const { return PendingScan.IsValid(); }
+
+    /** Picks up the result of the worker scan. Returns true when new matches arrived. */
+    bool UpdatePendingSearch();
+
+    /** Start positions of the matches in the text, in order and without overlaps */
+    const TArray<int32>& GetMatches() const { return Matches; }
+
+    int32 GetNumMatches() const { return Matches.Num(); }
+
+    /** Returns the length of a match, which varies between matches of a regex query */
+    int32 GetMatchLength(int32 MatchIndex) const { return MatchLengths[MatchIndex]; }
+
+    /** Returns the index of the first match starting at or after Position, wrapping around to the first match. INDEX_NONE if there are no matches. */
+    int32 FindMatchAtOrAfter(int32 Position) const;
+
+    /** The match the user navigated to, INDEX_NONE if there is none */
+    int32 GetCurrentMatch() const { return CurrentMatch; }
+    void SetCurrentMatch(int32 MatchIndex) { CurrentMatch = Matches.IsValidIndex(MatchIndex) ? MatchIndex : INDEX_NONE; }
+
+    /** Converts a position in the text into a line and offset */
+    FTextLocation GetLocation(int32 Position) const;
+
+    /** Converts a line and offset into a position in the text */
+    int32 GetPosition(const FTextLocation& Location) const;
+
+    /** Returns the length of a line, without its line break */
+    int32 GetLineLength(int32 LineIndex) const;
+
+    /**
+     * Adds the start position of every occurrence of Query in Text to OutPositions, overlapping ones included.
+     * Uses Boyer-Moore-Horspool, case-insensitive searches compare lowercased characters.
+     */
+    static void FindAll(const FString& Text, const FString& Query, bool bMatchCase, TArray<int32>& OutPositions);
+
+private:
+    /** Regex scan running on a worker thread */
+    struct FRegexScan;
+
+    /** Searches the whole text for the query, on a worker thread for a regex over a large text */
+    void SearchText();
+
+    /** Drops the running worker scan, if any. Its result will never be used. */
+    void CancelPendingScan();
+
+    /** Rebuilds Matches from Candidates, applying the whole word option and dropping overlaps */
+    void UpdateMatches();
+
+    /** Returns true if the match of the given range is not part of a longer word */
+    bool IsWholeWordAt(int32 Position, int32 Length) const;
+
+    /** Adds every non-empty match of Pattern in Text, stopping early once bCancelled is set */
+    static void FindAllRegex(const FString& Text, const FRegexPattern& Pattern, const std::atomic<bool>* bCancelled, TArray<int32>& OutPositions, TArray<int32>& OutLengths);
+
+    /** Returns the searched text, empty until SetText is called */
+    const FString& GetText() const;
+
+    TSharedPtr<const FQCE_TextSnapshot> Snapshot;
+
+    FString Query;
+    bool bMatchCase = true;
+    bool bWholeWord = true;
+    bool bRegex = false;
+
+    /** Every match of Query in the text regardless of the whole word option, so a longer literal query can be narrowed from them */
+    TArray<int32> Candidates;
+    TArray<int32> CandidateLengths;
+
+    TArray<int32> Matches;
+    TArray<int32> MatchLengths;
+    int32 CurrentMatch = INDEX_NONE;
+
+    TSharedPtr<FRegexScan, ESPMode::ThreadSafe> PendingScan;
+};
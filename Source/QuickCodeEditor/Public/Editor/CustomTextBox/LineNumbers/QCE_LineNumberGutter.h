@@ -0,0 +1,48 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class SQCE_MultiLineEditableTextBox;
+
+/**
+ * Line number column painted next to a text box.
+ * Only the numbers of the lines on screen are drawn, at the positions of the text layout's line views,
+ * so neither painting nor an edit costs more for a longer text.
+ */
+class QUICKCODEEDITOR_API SQCE_LineNumberGutter : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SQCE_LineNumberGutter)
+		: _ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+		, _MinDesiredWidth(24.0f)
+	{}
+		/** The text box whose lines are numbered */
+		SLATE_ARGUMENT(TSharedPtr<SQCE_MultiLineEditableTextBox>, TextBox)
+
+		/** Color of the line numbers */
+		SLATE_ARGUMENT(FLinearColor, ColorAndOpacity)
+
+		/** The gutter is never narrower than this, it grows with the number of digits of the last line number */
+		SLATE_ARGUMENT(float, MinDesiredWidth)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	/** The font of the text box, see UQCE_EditorSettings */
+	static FSlateFontInfo GetFont();
+
+	TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox;
+
+	FLinearColor ColorAndOpacity;
+
+	float MinDesiredWidth = 24.0f;
+};
@@ -6,10 +6,13 @@
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Text/SMultiLineEditableText.h"
 #include "Editor/CustomTextBox/InlineAISuggestion/Utils/InlineAISuggestionTypes.h"
+#include "Editor/CustomTextBox/Document/QCE_TextDocument.h"
+#include "Editor/CustomTextBox/Document/QCE_UndoHistory.h"
 
 class QCE_IndentationManager;
 struct FUserInputContext;
 class FDropdownCodeCompletionEngine;
+class FUICommandList;
 
 /** Defines the type of code being edited in this text box */
 UENUM()
@@ -254,6 +257,24 @@ public:
 	
 	/** Set to false when we initially open a node. */
 	void SetIsModified(bool bNewIsModified) { bIsModified = bNewIsModified; }
+
+	/** Makes the current text the unmodified one, e.g. right after it was loaded from disk. */
+	void MarkTextUnmodified() { UnmodifiedSnapshot = GetSnapshot(); }
+
+	/**
+	 * Returns true if the text is the one MarkTextUnmodified was last called with, e.g. after undoing every edit.
+	 * Checks the text version, then the length and content hash, and only compares the texts when all of those agree.
+	 */
+	bool IsTextUnmodified() const;
+
+	/**
+	 * Sets a text loaded from disk and makes it the unmodified text. The undo history starts over,
+	 * unless the text is the current one, e.g. when it is reloaded after saving.
+	 */
+	void LoadText(const FText& InText);
+
+	/** Sets whether the text can be edited. The undo history starts over whenever this changes. */
+	void SetReadOnlyAndResetUndo(const TAttribute<bool>& InIsReadOnly);
     
     /** 
      * Gets the word at the current cursor position
@@ -307,6 +328,9 @@ public:
 	 */
 	void SelectWordOccurrences(const FString& TargetWord);
 
+	/** Returns how many times the highlighted word occurs in the text, or INDEX_NONE while it is still being counted */
+	int32 GetHighlightedWordCount() const;
+
 	/**
 	 * Selects a specific occurrence of a word and moves the cursor to it
 	 * @param Word The word to highlight and select
@@ -314,6 +338,40 @@ public:
 	 * @param Length The length of the word
 	 */
 	void SelectSpecificOccurrence(const FString& Word, int32 AbsolutePosition, int32 Length);
+
+	/** Returns a number that changes whenever the text changes, programmatically or by the user */
+	uint32 GetTextVersion() const { return Document.GetVersion(); }
+
+	/**
+	 * Returns the current text with its line ranges. Prefer it over GetText, which builds a new string on every call.
+	 * Mirrors the text as of the last OnTextChanged, so it lags behind edits made inside a pending text transaction.
+	 */
+	const TSharedRef<const FQCE_TextSnapshot>& GetSnapshot() const { return Document.GetSnapshot(); }
+
+	/**
+	 * Converts a location to a position in the text returned by GetText, INDEX_NONE if the location is not in the text.
+	 * Looks the line up in the document's line offset index instead of walking the text.
+	 */
+	int32 LocationToPosition(const FTextLocation& Location) const { return GetSnapshot()->LocationToPosition(Location); }
+
+	/** Converts a position in the text returned by GetText to a location, see LocationToPosition */
+	FTextLocation PositionToLocation(int32 Position) const { return GetSnapshot()->PositionToLocation(Position); }
+
+	/** Geometry of the text inside the box's border and padding, the space the text layout's line views are placed in */
+	const FGeometry& GetTextGeometry() const { return EditableText->GetCachedGeometry(); }
+
+	/**
+	 * Replaces ranges of the text as a single undo step, which records only those ranges.
+	 * The edits must not overlap and must be sorted back to front. Their positions and removed texts are those of the current text.
+	 * The cursor ends up after the front-most edit.
+	 */
+	void ApplyEdits(TArray<FQCE_TextEdit>&& Edits);
+
+	/** Reverts the last step of the undo history. Returns false if there is nothing to undo or the text cannot be edited. */
+	bool Undo();
+
+	/** Applies the last undone step again. Returns false if there is nothing to redo or the text cannot be edited. */
+	bool Redo();
 	
 	/** Tracks the last cursor position for maintaining state during focus changes */
 	FTextLocation LastCursorLocation;
@@ -345,6 +403,64 @@ private:
      * @param CursorLocation The text location to check for word selection
      */
     void SelectCursorWordOccurrences(const FTextLocation& CursorLocation);
+
+	/** Highlights the word under the cursor once the cursor stopped moving for the configured delay */
+	EActiveTimerReturnType HandleWordHighlightTimer(double InCurrentTime, float InDeltaTime);
+
+	/** Highlights the occurrences of the word under the cursor, unless they are highlighted already */
+	void HighlightCursorWord();
+
+	/** Updates the document and records the change in the undo history before forwarding it to the OnTextChanged event */
+	void HandleTextChanged(const FText& NewText);
+
+	/**
+	 * Applies the edits of an undo step in one text transaction, or reverts them.
+	 * Returns true if the text changed, it does not when the text box is read-only.
+	 */
+	bool ReplaceRanges(const TArray<FQCE_TextEdit>& Edits, bool bRevert);
+
+	/** Builds the right-click menu, whose Undo and Redo go through the undo history rather than the editable text's own */
+	TSharedPtr<SWidget> BuildContextMenu();
+
+	/** Copies the selected text to the clipboard and deletes it */
+	void CutSelectedText();
+
+	/** Copies the selected text to the clipboard */
+	void CopySelectedText();
+
+	/** Replaces the selection with the clipboard text */
+	void PasteText();
+
+	/** Deletes the selected text */
+	void DeleteSelectedText();
+
+	bool HasSelectedText() const;
+
+	/** Adds the entries of the owner, see FArguments::ContextMenuExtender */
+	FMenuExtensionDelegate ContextMenuExtender;
+
+	/** Binds the generic edit commands of the context menu */
+	TSharedPtr<FUICommandList> ContextMenuCommands;
+
+	FOnTextChanged OnTextChangedCallback;
+
+	/** Mirror of the text, see GetSnapshot */
+	FQCE_TextDocument Document;
+
+	/** The text as of the last MarkTextUnmodified */
+	TSharedPtr<const FQCE_TextSnapshot> UnmodifiedSnapshot;
+
+	/**
+	 * Steps Undo and Redo go through. The editable text still records its own undo states, which Slate caps at a fixed
+	 * number of levels, but the undo shortcuts and the context menu never replay them.
+	 */
+	FQCE_UndoHistory UndoHistory;
+
+	/** Set while ReplaceRanges edits the text, the step is recorded as its edits rather than as the change OnTextChanged reports */
+	bool bReplacingRanges = false;
+
+	/** Pending delayed highlight of the word under the cursor */
+	TSharedPtr<FActiveTimerHandle> WordHighlightTimerHandle;
 	
     /** Caches the last word that was highlighted to avoid unnecessary updates */
     FString LastHighlightedWord;
@@ -9,8 +9,12 @@
 #include "Widgets/Layout/SScrollBox.h"
 
 class SQCE_MultiLineEditableTextBox;
+class SQCE_LineNumberGutter;
 class UMainEditorContainer;
 
+/** Called with the 0-based, inclusive range of lines on screen whenever it changes */
+DECLARE_DELEGATE_TwoParams(FOnVisibleLinesChanged, int32 /*FirstLine*/, int32 /*LastLine*/)
+
 /**
  * QCE_MultiLineEditableTextBoxWrapper
  * 
@@ -88,6 +92,9 @@ public:
         /** Called when go to line functionality is requested (typically Ctrl+G) */
         SLATE_EVENT(FOnGoToLineRequested, OnGoToLineRequested)
         
+        /** Called when the range of lines on screen changes, after scrolling or resizing */
+        SLATE_EVENT(FOnVisibleLinesChanged, OnVisibleLinesChanged)
+        
         /** The initial text that will appear in the text box */
         SLATE_ATTRIBUTE(FText, Text)
         
@@ -101,6 +108,9 @@ public:
      */
     void Construct(const FArguments& InArgs);
 
+    /** Reports the visible line range when scrolling or resizing changed it */
+    virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 #pragma region Widget Access
 public:
     /**
@@ -146,7 +156,7 @@ public:
      * Sets whether the text box should be read-only
      * @param bInIsReadOnly true to make read-only, false to allow editing
      */
-    void SetIsReadOnly(bool bInIsReadOnly) { TextBox->SetIsReadOnly(bInIsReadOnly); }
+    void SetIsReadOnly(bool bInIsReadOnly) { TextBox->SetReadOnlyAndResetUndo(bInIsReadOnly); }
 #pragma endregion
 
 #pragma region File Path Management
@@ -240,7 +250,7 @@ private:
     TSharedPtr<SQCE_MultiLineEditableTextBox> TextBox;
 
     /** The line numbers display widget, shown on the left side when enabled */
-    TSharedPtr<STextBlock> LineNumbers;
+    TSharedPtr<SQCE_LineNumberGutter> LineNumbers;
 
     /** The scroll box that wraps the entire content and provides scrolling functionality */
     TSharedPtr<SScrollBox> WrapperScrollBox;
@@ -250,9 +260,6 @@ private:
     /** The file path associated with this text box's content */
     FString FilePath;
 
-    /** The current number of lines in the text content */
-    int32 LineCount = 0;
-
     /** Whether the line number column is enabled and should be displayed */
     bool bEnableLineNumberColumn = true;
 
@@ -261,12 +268,20 @@ private:
 
     /** Reference to the main editor container that owns this text box wrapper */
     UMainEditorContainer* MainEditorContainer = nullptr;
+
+    /** Called when the range of lines on screen changes */
+    FOnVisibleLinesChanged OnVisibleLinesChanged;
+
+    /** Last reported range of lines on screen (0-based, inclusive, -1 = not reported yet) */
+    int32 LastVisibleFirstLine = -1;
+    int32 LastVisibleLastLine = -1;
 #pragma endregion
 
 #pragma region Internal Methods
     /**
      * Updates the line numbers display based on the current text content
-     * This method is called automatically when the text changes and line numbers are enabled
+     * This method is called automatically when the text changes and line numbers are enabled.
+     * The gutter paints the visible numbers itself, this only makes it fit the new last line number.
      */
     void UpdateLineNumbers();
 #pragma endregion
@@ -3,86 +3,55 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Framework/Text/SyntaxHighlighterTextLayoutMarshaller.h"
 #include "Framework/Text/SyntaxTokenizer.h"
 #include "Framework/Text/TextLayout.h"
 #include "Styling/SlateTypes.h"
 
+class FCppSyntaxTokenizer;
+class FQCE_IdentifierIndex;
+class FQCE_SyntaxStyleTable;
+class FQCE_TextLayout;
+
 /**
  * Syntax highlighting for Unreal C++ text
  */
 class QUICKCODEEDITOR_API FCPPSyntaxHighlighterMarshaller : public FSyntaxHighlighterTextLayoutMarshaller
 {
-public:
-    /**
-     * Container for all syntax highlighting styles used by the C++ marshaller.
-     */
-    struct FSyntaxTextStyle
-    {
-        /**
-         * Default constructor for uninitialized style
-         */
-        FSyntaxTextStyle(bool newIsSet) : bIsSet(newIsSet)
-        {
-            
-        }
-        
-        FSyntaxTextStyle(
-            const FTextBlockStyle& InNormalTextStyle,
-            const FTextBlockStyle& InOperatorTextStyle,
-            const FTextBlockStyle& InKeywordTextStyle,
-            const FTextBlockStyle& InStringTextStyle,
-            const FTextBlockStyle& InNumberTextStyle,
-            const FTextBlockStyle& InCommentTextStyle,
-            const FTextBlockStyle& InPreProcessorKeywordTextStyle,
-            const FTextBlockStyle& InUnrealTypedefTextStyle,
-            const FTextBlockStyle& InFunctionTextStyle,
-            const FTextBlockStyle& InClassTextStyle
-        ) :
-            NormalTextStyle(InNormalTextStyle),
-            OperatorTextStyle(InOperatorTextStyle),
-            KeywordTextStyle(InKeywordTextStyle),
-            StringTextStyle(InStringTextStyle),
-            NumberTextStyle(InNumberTextStyle),
-            CommentTextStyle(InCommentTextStyle),
-            PreProcessorKeywordTextStyle(InPreProcessorKeywordTextStyle),
-            UnrealTypedefTextStyle(InUnrealTypedefTextStyle),
-            FunctionTextStyle(InFunctionTextStyle),
-            ClassTextStyle(InClassTextStyle), bIsSet(false)
-        {
-        }
-
-        FTextBlockStyle NormalTextStyle;
-        
-        FTextBlockStyle OperatorTextStyle;
-        
-        FTextBlockStyle KeywordTextStyle;
-        
-        FTextBlockStyle StringTextStyle;
-        
-        FTextBlockStyle NumberTextStyle;
-        
-        FTextBlockStyle CommentTextStyle;
-        
-        FTextBlockStyle PreProcessorKeywordTextStyle;
-        
-        FTextBlockStyle UnrealTypedefTextStyle;
-        
-        FTextBlockStyle FunctionTextStyle;
-        
-        FTextBlockStyle ClassTextStyle;
-
-        bool bIsSet;
-    };
-    
 public:
     /**
      * Creates a new instance of the CPP syntax highlighter marshaller
      */
     static TSharedRef<FCPPSyntaxHighlighterMarshaller> Create();
 
+    virtual ~FCPPSyntaxHighlighterMarshaller() override;
+
     void SetHighlighterEnabled(const bool& bShouldEnable) { bShouldApplyHighlights = bShouldEnable; }
 
+    /**
+     * Allows large documents laid out into this layout to be highlighted lazily.
+     * Only the lines around the visible range are styled right away, the others get a plain run
+     * and are re-styled in place over the following frames.
+     * The layout also gets the identifier index, so it can look word occurrences up instead of scanning its lines.
+     */
+    void SetLazyHighlightLayout(const TSharedPtr<FQCE_TextLayout>& InTextLayout);
+
+    /** Identifier occurrences of the text last laid out, kept in step with the tokenizer */
+    TSharedRef<const FQCE_IdentifierIndex> GetIdentifierIndex() const { return IdentifierIndex; }
+
+    /**
+     * Updates the range of lines currently on screen (0-based, inclusive).
+     * Plain lines that come within the highlight margin of it are styled immediately.
+     */
+    void SetVisibleLineRange(int32 FirstLine, int32 LastLine);
+
+    /**
+     * Lays out the text, tokenizing large edits on a worker thread.
+     * Changed lines stay plain until the worker result is applied on the game thread, unless the text changed again in between.
+     */
+    virtual void SetText(const FString& SourceString, FTextLayout& TargetTextLayout) override;
+
 protected:
     /**
      * Parses the source string into tokens and applies them to the text layout
@@ -96,16 +65,90 @@ private:
     FCPPSyntaxHighlighterMarshaller(TSharedPtr<ISyntaxTokenizer> InTokenizer);
 
     /**
-     * Retrieves the current syntax text style configuration
+     * Re-flows the last highlighted layout so its runs pick up the new shared style table
      */
-    FSyntaxTextStyle GetSyntaxTextStyle();
+    void HandleStyleTableChanged();
+
+    /** Creates one styled run per token of a line, using the kinds and line-relative tokens from the tokenizer's last pass */
+    static void CreateHighlightedRuns(const FCppSyntaxTokenizer& CppTokenizer, int32 LineIndex, const TSharedRef<FString>& ModelString, const TSharedRef<const FQCE_SyntaxStyleTable>& StyleTable, TArray<TSharedRef<IRun>>& OutRuns);
+
+    /** Line text and runs last added to the layout, so a line the tokenizer did not re-lex can be added again as it is */
+    struct FCachedLineRuns
+    {
+        TSharedPtr<FString> ModelString;
+        TArray<TSharedRef<IRun>> Runs;
+
+        /** The runs are styled per token, rather than a single plain run waiting for lazy highlighting */
+        bool bHighlighted = false;
+    };
+
+    /** Moves the cached lines along the tokenizer's last dirty range and empties the re-lexed ones */
+    void UpdateCachedLineRuns(const FCppSyntaxTokenizer& CppTokenizer);
 
     /**
-     * Determines if a token represents a comment based on proper context detection
+     * Returns true if a cached line still has the tokenizer's text and its runs still cover the line's tokens.
+     * The editable text edits line texts and runs in place, so a line it touched is never reused.
      */
-    bool IsCommentToken(const FString& SourceString, const ISyntaxTokenizer::FToken& Token) const;
+    static bool CanReuseCachedLine(const FCppSyntaxTokenizer& CppTokenizer, int32 LineIndex, const FCachedLineRuns& CachedLine);
+
+    /** Styles the plain lines of the given range. Stops lazy highlighting if the layout no longer matches the tokenizer. */
+    void HighlightPendingLines(int32 FirstLine, int32 LastLine);
+
+    /** Re-styles a single plain line in place. Returns false if the layout no longer matches the tokenizer. */
+    bool HighlightPendingLine(const FCppSyntaxTokenizer& CppTokenizer, FQCE_TextLayout& TextLayout, int32 LineIndex);
+
+    /** Styles plain lines until the frame budget is spent. Returns false once no plain line is left. */
+    bool TickLazyHighlighting(float DeltaTime);
+
+    /** Forgets all plain lines and stops the lazy highlighting ticker */
+    void ClearPendingLines();
+
+    /** Styles the plain lines around the visible range right away and lets the ticker take care of the rest */
+    void SchedulePendingLines();
+
+    /** Lexes a snapshot of the text on a worker thread */
+    void StartBackgroundTokenization(const FString& SourceString);
+
+    /** Drops the running background tokenization, if any. Its result will never be applied. */
+    void CancelBackgroundTokenization();
+
+    /** Applies the background tokenization result once it is ready. Returns false once there is nothing left to wait for. */
+    bool TickBackgroundTokenization(float DeltaTime);
+
+    /** Layout the text was last highlighted into */
+    TWeakPtr<FTextLayout> HighlightedTextLayout;
+
+    FDelegateHandle StyleTableChangedHandle;
+
+    /** Layout that large documents may be highlighted lazily into */
+    TWeakPtr<FQCE_TextLayout> LazyHighlightLayout;
+
+    /** Lines of the lazy highlight layout that still have a plain run */
+    TBitArray<> PendingLines;
+    int32 NumPendingLines = 0;
+
+    /** Next line the ticker looks at, wrapping around the document */
+    int32 NextPendingLine = 0;
+
+    /** Lines currently on screen (0-based, inclusive) */
+    int32 VisibleFirstLine = 0;
+    int32 VisibleLastLine = 0;
+
+    FTSTicker::FDelegateHandle LazyHighlightTickerHandle;
+
+    /** Lexing of a text snapshot running on a worker thread */
+    struct FBackgroundTokenization;
+    TSharedPtr<FBackgroundTokenization, ESPMode::ThreadSafe> BackgroundTokenization;
+    FTSTicker::FDelegateHandle BackgroundTokenizationTickerHandle;
+
+    /** One entry per tokenizer line, see FCachedLineRuns */
+    TArray<FCachedLineRuns> CachedLineRuns;
+
+    /** Identifier occurrences, updated from the lines the tokenizer re-lexes */
+    TSharedRef<FQCE_IdentifierIndex> IdentifierIndex;
+
+    /** Incremented every time the text is set, so results computed for an older text can be told apart */
+    uint32 DocumentVersion = 0;
 
-    FSyntaxTextStyle CurrentSyntaxStyle;
-    bool bRefreshStyle = false;
     bool bShouldApplyHighlights = false;
 };
\ No newline at end of file
@@ -3,8 +3,41 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Containers/BitArray.h"
 #include "Containers/UnrealString.h"
 #include "Framework/Text/SyntaxTokenizer.h"
+#include "Misc/EnumClassFlags.h"
+
+/**
+ * Tables an identifier was found in. A word can be in several of them (e.g. int32 is both a keyword and an Unreal typedef).
+ */
+enum class ECppIdentifierKind : uint8
+{
+	None = 0,
+	Keyword = 1 << 0,
+	PreProcessorKeyword = 1 << 1,
+	UnrealTypedef = 1 << 2,
+};
+ENUM_CLASS_FLAGS(ECppIdentifierKind)
+
+/**
+ * Highlighting category of a token, recorded by the tokenizer next to the engine's Syntax/Literal token type.
+ */
+enum class ECppTokenKind : uint8
+{
+	Normal,
+	Operator,
+	Keyword,
+	String,
+	Number,
+	Comment,
+	PreProcessorKeyword,
+	UnrealTypedef,
+	Function,
+	Class,
+
+	Count
+};
 
 /**
  * Tokenize text between syntax and literals for C++ syntax.
@@ -12,28 +45,164 @@
 class FCppSyntaxTokenizer : public ISyntaxTokenizer
 {
 public:
+	/**
+	 * Lines that were re-lexed by the last call to Process.
+	 * Lines before FirstLine keep their index, lines after the dirty block are shifted by NumNewLines - NumOldLines.
+	 */
+	struct FDirtyLineRange
+	{
+		/** Index of the first re-lexed line (same in the previous and the new line numbering) */
+		int32 FirstLine = 0;
+
+		/** Number of re-lexed lines in the new line numbering */
+		int32 NumNewLines = 0;
+
+		/** Number of lines they replaced in the previous line numbering */
+		int32 NumOldLines = 0;
+	};
+
+	/** Lexer state carried from the end of one line to the start of the next */
+	struct FLexerState
+	{
+		bool bInMultilineComment = false;
+	};
+
+	/**
+	 * Lexer state and tokens of a single line.
+	 * Token ranges are relative to the start of the line so the entry stays valid when the line moves.
+	 */
+	struct FCachedLine
+	{
+		FString Text;
+		TArray<FToken> Tokens;
+		TArray<ECppTokenKind> TokenKinds;
+		bool bStartsInMultilineComment = false;
+		bool bEndsInMultilineComment = false;
+
+		/** The line was not lexed yet and only holds a single plain token */
+		bool bIsPlaceholder = false;
+	};
+
 	static TSharedRef<FCppSyntaxTokenizer> Create();
 
 	virtual void Process(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input) override;
 
+	/**
+	 * Classifies an identifier against the keyword, preprocessor keyword and Unreal typedef tables.
+	 * Case sensitive, does not allocate and costs a single hash probe in the common case.
+	 */
+	static ECppIdentifierKind ClassifyIdentifier(const TCHAR* Text, int32 Len);
+
 	FORCEINLINE bool IsUnrealTypeDef(const FString& InToken) const
 	{
-		return UnrealTypedefs.Contains(InToken);
+		return EnumHasAnyFlags(ClassifyIdentifier(*InToken, InToken.Len()), ECppIdentifierKind::UnrealTypedef);
 	}
 
 	FORCEINLINE bool IsKeyword(const FString& InToken) const
 	{
-		return Keywords.Contains(InToken);
+		return EnumHasAnyFlags(ClassifyIdentifier(*InToken, InToken.Len()), ECppIdentifierKind::Keyword | ECppIdentifierKind::PreProcessorKeyword);
 	}
 
 	FORCEINLINE bool IsOperator(const FString& InToken) const
 	{
-		return Operators.Contains(InToken);
+		return !InToken.IsEmpty() && MatchOperator(*InToken, InToken.Len()) == InToken.Len();
+	}
+
+	/** Returns the length of the longest operator at the start of String, or 0 if there is none */
+	int32 MatchOperator(const TCHAR* String, int32 MaxLength) const;
+
+	/**
+	 * Same result as MatchOperator, but tries every operator in turn, the way operators were matched before the dispatch table.
+	 * Only used by the highlighter benchmark, to measure what the table saves.
+	 */
+	int32 MatchOperatorLinear(const TCHAR* String, int32 MaxLength) const;
+
+	/**
+	 * Returns the kind of each token of a line from the last call to Process.
+	 * The array is parallel to the Tokens of the matching FTokenizedLine.
+	 */
+	FORCEINLINE const TArray<ECppTokenKind>& GetLineTokenKinds(const int32 LineIndex) const
+	{
+		return CachedLines[LineIndex].TokenKinds;
+	}
+
+	/** Returns the number of lines produced by the last call to Process */
+	FORCEINLINE int32 GetNumLines() const
+	{
+		return CachedLines.Num();
 	}
+
+	/** Returns the tokens of a line from the last call to Process, with ranges relative to the start of the line */
+	FORCEINLINE const TArray<FToken>& GetLineTokens(const int32 LineIndex) const
+	{
+		return CachedLines[LineIndex].Tokens;
+	}
+
+	/** Returns the text of a line from the last call to Process */
+	FORCEINLINE const FString& GetLineText(const int32 LineIndex) const
+	{
+		return CachedLines[LineIndex].Text;
+	}
+
+	/** Returns true if the line was not lexed yet and only holds a single plain token */
+	FORCEINLINE bool IsLinePlaceholder(const int32 LineIndex) const
+	{
+		return CachedLines[LineIndex].bIsPlaceholder;
+	}
+
+	/** Returns the lines that were re-lexed by the last call to Process */
+	FORCEINLINE const FDirtyLineRange& GetLastDirtyLineRange() const
+	{
+		return LastDirtyLineRange;
+	}
+
+	/** Drops all cached lines so the next call to Process re-lexes the whole document */
+	void InvalidateLineCache();
+
+	/** Returns how many lines of Input differ from the last pass, i.e. how many lines Process would have to re-lex */
+	int32 CountChangedLines(const FString& Input, const TArray<FTextRange>& LineRanges) const;
+
+	/**
+	 * Same as Process, but the changed lines get a plain placeholder token instead of being lexed.
+	 * The real tokens are expected to come from LexDocument and ApplyLexedDocument later on.
+	 */
+	void ProcessDeferred(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input, const TArray<FTextRange>& LineRanges);
+
+	/**
+	 * Lexes a whole document without reading or writing the line cache.
+	 * Only reads tables that are immutable after construction, so it is safe to call from a worker thread.
+	 */
+	void LexDocument(const FString& Input, TArray<FCachedLine>& OutLines) const;
+
+	/**
+	 * Replaces the line cache with a document lexed by LexDocument.
+	 * OutChangedLines flags the lines whose tokens differ from what the previous pass produced.
+	 */
+	void ApplyLexedDocument(TArray<FCachedLine>&& LexedLines, TBitArray<>& OutChangedLines);
+
 private:
 	FCppSyntaxTokenizer();
 
-	void TokenizeLineRanges(const FString& Input, const TArray<FTextRange>& LineRanges, TArray<FTokenizedLine>& OutTokenizedLines);
+	/** Re-lexes the lines that changed since the last pass. Deferred passes put placeholders on the changed lines instead. */
+	void TokenizeLineRanges(const FString& Input, const TArray<FTextRange>& LineRanges, TArray<FTokenizedLine>& OutTokenizedLines, bool bDeferChangedLines);
+
+	/** Counts the lines at the top and bottom of Input that have the same text as in the last pass */
+	void FindUnchangedLines(const FString& Input, const TArray<FTextRange>& LineRanges, int32& OutNumPrefixLines, int32& OutNumSuffixLines) const;
+
+	/** Tokenizes a single line starting from the given lexer state, and updates that state */
+	void TokenizeLine(const FString& Input, const FTextRange& LineRange, FLexerState& LexerState, FTokenizedLine& TokenizedLine, TArray<ECppTokenKind>& TokenKinds) const;
+
+	/** Marks plain identifiers followed by :: as class names and identifiers followed by ( as function names */
+	static void ResolveIdentifierKinds(const FString& Input, const FTokenizedLine& TokenizedLine, TArray<ECppTokenKind>& TokenKinds);
+
+	/** Lexes a line of Input into a cache entry, starting in the given multiline comment state */
+	void LexLineIntoCache(const FString& Input, const FTextRange& LineRange, bool bStartsInMultilineComment, FCachedLine& OutCachedLine) const;
+
+	/** Fills a cache entry with a single plain token covering the line */
+	static void MakePlaceholderLine(const FString& Input, const FTextRange& LineRange, bool bStartsInMultilineComment, FCachedLine& OutCachedLine);
+
+	/** Returns true if the cached line has the same text as the given range of Input */
+	static bool IsSameLineText(const FCachedLine& CachedLine, const FString& Input, const FTextRange& LineRange);
 
 	static FORCEINLINE bool IsAlpha(TCHAR Char)
 	{
@@ -55,15 +224,15 @@ private:
 		return IsAlphaOrDigit(Char) || Char == TEXT('_');
 	}
 
-	/** Collection of C++ operators and symbols */
-	TSet<FString> Operators;
+	/** Operator dispatch covers ASCII, which is where every C++ operator starts */
+	static constexpr int32 OperatorDispatchTableSize = 128;
 
-	/** Collection of C++ keywords and reserved words */
-	TSet<FString> Keywords;
+	/** Operators bucketed by their first character, longest first, so matching probes only the candidates that can match */
+	TArray<FString> OperatorsByFirstChar[OperatorDispatchTableSize];
 
-	/** Collection of Unreal Engine type definitions */
-	TSet<FString> UnrealTypedefs;
+	/** Per-line lexer state and tokens from the previous Process call */
+	TArray<FCachedLine> CachedLines;
 
-	/** State tracking for multiline comments across tokenization */
-	bool bInMultilineComment = false;
+	/** Lines that were re-lexed by the last Process call */
+	FDirtyLineRange LastDirtyLineRange;
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Measures tokenizer and syntax highlighter throughput on synthetic Unreal-style headers and sources.
+ *
+ * Registered as the QCE.Benchmark.Highlighter automation test in the performance filter. It does not need a renderer, so it can run headless:
+ *   UnrealEditor-Cmd <Project>.uproject -nullrhi -unattended -ExecCmds="Automation RunTests QCE.Benchmark; Quit"
+ * The QCE.BenchmarkHighlighter console command runs it with other line counts or keystroke counts:
+ *   QCE.BenchmarkHighlighter [Lines=1000,10000,100000] [Keystrokes=200]
+ *
+ * Results are logged and written as CSV and JSON to Saved/QuickCodeEditor/Benchmarks, tagged with the plugin version.
+ */
+class QUICKCODEEDITOR_API FQCE_HighlighterBenchmark
+{
+public:
+	/** Measurements for one synthetic document in one scan mode */
+	struct FResult
+	{
+		/** "Header" or "Source" */
+		FString DocumentKind;
+
+		/** "Vector" or "Scalar", see FQCE_TextScan */
+		FString ScanMode;
+
+		int32 NumLines = 0;
+		int32 NumChars = 0;
+		int32 NumTokens = 0;
+
+		/** Full tokenization of the document with an empty line cache */
+		double TokenizeMs = 0.0;
+		double TokenizeMBPerSecond = 0.0;
+		double TokensPerSecond = 0.0;
+
+		/** Allocations made by every thread, read from the FMalloc call counters of the memory stats. -1 in builds without STATS. */
+		int64 TokenizeAllocations = 0;
+
+		/** Operator matching at every punctuation character, with the dispatch table and with the former scan of every operator */
+		double OperatorTableMs = 0.0;
+		double OperatorLinearMs = 0.0;
+
+		/** Full tokenization and run creation into a text layout */
+		double HighlightMs = 0.0;
+		double HighlightMBPerSecond = 0.0;
+		int64 HighlightAllocations = 0;
+
+		/** Re-highlight latency after typing or deleting a single character, -1 when not measured */
+		double KeystrokeP50Ms = -1.0;
+		double KeystrokeP99Ms = -1.0;
+	};
+
+	/**
+	 * Generates an Unreal-style header or source file of NumLines lines.
+	 * The text is deterministic and heavy on doc comments, long string literals and UFUNCTION/UPROPERTY specifiers.
+	 */
+	static FString GenerateDocument(int32 NumLines, bool bHeader);
+
+	/**
+	 * Benchmarks a header and a source for every line count.
+	 * Keystroke latency is measured with NumKeystrokes edits per document, 0 skips it.
+	 */
+	static TArray<FResult> Run(const TArray<int32>& LineCounts, int32 NumKeystrokes);
+
+	/** Line counts measured unless others are given */
+	static TArray<int32> GetDefaultLineCounts() { return { 1000, 10000, 100000 }; }
+
+	/** Keystrokes measured per document unless another count is given */
+	static constexpr int32 DefaultNumKeystrokes = 200;
+
+	/** Runs the benchmark, then logs and saves its results. Returns false if the results could not be saved. */
+	static bool RunAndSave(const TArray<int32>& LineCounts, int32 NumKeystrokes, TArray<FResult>& OutResults);
+
+	/** Writes the results as CSV and JSON next to each other. Returns false if either file could not be saved. */
+	static bool SaveResults(const TArray<FResult>& Results, FString& OutCsvPath, FString& OutJsonPath);
+
+	/** Logs one line per result */
+	static void LogResults(const TArray<FResult>& Results);
+};
@@ -0,0 +1,75 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCppSyntaxTokenizer;
+
+/**
+ * Identifier occurrences of a document, kept in step with the tokenizer's line cache.
+ * Occurrences are stored per line, so an edit only re-indexes the lines the tokenizer re-lexed and shifts the others,
+ * and looking up a word is a single hash probe followed by integer compares over the requested lines.
+ * Only identifier tokens are indexed; comments, strings, numbers and lines the tokenizer has not lexed yet hold none.
+ */
+class QUICKCODEEDITOR_API FQCE_IdentifierIndex
+{
+public:
+	/** Identifier occurrence, with offsets relative to the start of its line */
+	struct FOccurrence
+	{
+		int32 LineIndex = 0;
+		int32 BeginOffset = 0;
+		int32 EndOffset = 0;
+	};
+
+	/**
+	 * Re-indexes the lines re-lexed by the tokenizer's last pass and shifts the lines after them.
+	 * Rebuilds the whole index if it does not line up with the tokenizer anymore.
+	 */
+	void ApplyDirtyLines(const FCppSyntaxTokenizer& Tokenizer);
+
+	/** Re-indexes a single line whose tokens changed without the line count changing */
+	void UpdateLine(const FCppSyntaxTokenizer& Tokenizer, int32 LineIndex);
+
+	/** Re-indexes every line of the tokenizer's last pass */
+	void Rebuild(const FCppSyntaxTokenizer& Tokenizer);
+
+	/** Returns the number of indexed lines, which matches the tokenizer's while the index is in sync */
+	int32 GetNumLines() const { return Lines.Num(); }
+
+	/** Adds the occurrences of Word on the lines [FirstLine, LastLine] to OutOccurrences */
+	void FindOccurrences(const FString& Word, int32 FirstLine, int32 LastLine, TArray<FOccurrence>& OutOccurrences) const;
+
+	/** Returns how many times Word occurs in the whole document */
+	int32 CountOccurrences(const FString& Word) const;
+
+private:
+	/** Identifier on a line, with the word interned to an id */
+	struct FLineIdentifier
+	{
+		int32 WordId = INDEX_NONE;
+		int32 BeginOffset = 0;
+		int32 EndOffset = 0;
+	};
+
+	/** C++ identifiers are case-sensitive, unlike the default FString keys */
+	struct FWordIdKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+	{
+		static FORCEINLINE const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+		static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/** Replaces the identifiers of a line with the ones of the tokenizer's cached line */
+	void IndexLine(const FCppSyntaxTokenizer& Tokenizer, int32 LineIndex);
+
+	/** Identifiers of each line, in line order */
+	TArray<TArray<FLineIdentifier>> Lines;
+
+	/** Interned words, ids are only reclaimed when the index is rebuilt */
+	TMap<FString, int32, FDefaultSetAllocator, FWordIdKeyFuncs> WordIds;
+
+	/** Number of occurrences of each word id across the document */
+	TArray<int32> WordCounts;
+};
@@ -0,0 +1,40 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/FCppSyntaxTokenizer.h"
+#include "Styling/SlateTypes.h"
+
+/**
+ * Immutable set of text styles, one per ECppTokenKind, built from the editor settings.
+ * Syntax highlighted runs reference a style by token kind instead of each owning a copy of the whole style set.
+ */
+class FQCE_SyntaxStyleTable
+{
+public:
+	/**
+	 * Builds a new table from the current editor settings.
+	 * @return Shared reference to the created table
+	 */
+	static TSharedRef<const FQCE_SyntaxStyleTable> CreateFromSettings();
+
+	/**
+	 * Returns the table currently used for syntax highlighting, shared by every highlighter.
+	 * The table is replaced (never modified) when the syntax settings change.
+	 */
+	static const TSharedRef<const FQCE_SyntaxStyleTable>& GetCurrent();
+
+	/** Called after GetCurrent starts returning a new table, so layouts can re-flow with the new styles */
+	static FSimpleMulticastDelegate& OnCurrentTableChanged();
+
+	FORCEINLINE const FTextBlockStyle& GetStyle(const ECppTokenKind TokenKind) const
+	{
+		return Styles[static_cast<int32>(TokenKind)];
+	}
+
+private:
+	FQCE_SyntaxStyleTable() = default;
+
+	FTextBlockStyle Styles[static_cast<int32>(ECppTokenKind::Count)];
+};
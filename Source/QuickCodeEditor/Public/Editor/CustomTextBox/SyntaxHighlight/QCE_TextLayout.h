@@ -1,9 +1,13 @@
 ﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
 
 #pragma once
+#include "Containers/Ticker.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_IdentifierIndex.h"
 #include "Framework/Text/SlateTextLayout.h"
 #include "Settings/UQCE_EditorSettings.h"
 
+class FQCE_WordBackgroundHighlighter;
+
 /**
  * Custom text layout class that extends FSlateTextLayout to provide word highlighting functionality.
  * This class manages the rendering and highlighting of text in the code editor.
@@ -19,21 +23,55 @@ public:
 		return Layout;
 	}
 
+	virtual ~FQCE_TextLayout() override;
+
 	/** Handles the painting of text and word highlights.*/
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	
 	/** 
 	 * Add word background highlighting for a specific word.
 	 * Uses the WordHighlightColor from editor settings.
+	 * Only the lines around the visible range are highlighted, occurrences are looked up in the identifier index when there is one.
+	 * The visible occurrences are highlighted right away, the others over the following frames.
 	 */
 	void HighlightWord(const FString& Word);
 
+	/** Returns how many times the highlighted word occurs in the whole text, or INDEX_NONE while it is still being counted */
+	int32 GetHighlightedWordCount() const { return HighlightedWordCount; }
+
 	/**  Highlights a specific occurrence of a word at the given position.*/
 	void HighlightSpecificOccurrence(const FString& Word, int32 LineIndex, int32 StartOffset, int32 EndOffset);
 
 	/** Clears all active word highlights. */
 	void ClearHighlights();
 
+	/** Highlights the current word again, e.g. after the index picked up new occurrences */
+	void RefreshWordHighlights();
+
+	/**
+	 * Highlights the matches of a find query with the SearchHighlightColor, replacing the previous ones.
+	 * Matches must be sorted by line. Like word highlights, only the lines around the visible range get highlights.
+	 */
+	void SetSearchMatches(TArray<FQCE_IdentifierIndex::FOccurrence>&& InSearchMatches);
+
+	/** Removes the highlights of the find query matches */
+	void ClearSearchMatches();
+
+	/** Sets the index used to look word occurrences up. It has to be kept in step with the lines of this layout. */
+	void SetIdentifierIndex(const TSharedPtr<const FQCE_IdentifierIndex>& InIdentifierIndex) { IdentifierIndex = InIdentifierIndex; }
+
+	/**
+	 * Updates the range of lines currently on screen (0-based, inclusive).
+	 * The current word gets highlighted on the newly visible lines.
+	 */
+	void SetVisibleLineRange(int32 FirstLine, int32 LastLine);
+
+	/**
+	 * Swaps the runs of a line without touching the other lines, so a line can be re-styled in place.
+	 * The runs must reference the line's current text. Returns false if the line does not exist.
+	 */
+	bool ReplaceLineRuns(int32 LineIndex, const TArray<TSharedRef<IRun>>& Runs);
+
 protected:
 	/** Protected constructor to ensure instances are created through the Create function. */
 	FQCE_TextLayout(SWidget* InOwner, FTextBlockStyle InDefaultTextStyle)
@@ -42,6 +80,86 @@ protected:
 	}
 
 private:
+	/** Finds the occurrences of the highlighted word around the visible range and starts highlighting them, the visible ones first */
+	void ApplyWordHighlights();
+
+	/** Removes the word highlights, including the ones that were not added yet */
+	void RemoveWordHighlights();
+
+	/** Adds up to MaxHighlights of the occurrences that are waiting to be highlighted */
+	void AddPendingWordHighlights(int32 MaxHighlights);
+
+	/** Adds the occurrences of Word on the lines [FirstLine, LastLine] to OutOccurrences, from the index when it is in sync */
+	void FindWordOccurrences(const FString& Word, int32 FirstLine, int32 LastLine, TArray<FQCE_IdentifierIndex::FOccurrence>& OutOccurrences) const;
+
+	/** Adds every whole-word occurrence of Word on the lines [FirstLine, LastLine] to OutOccurrences by searching their text */
+	void ScanWordOccurrences(const FString& Word, int32 FirstLine, int32 LastLine, TArray<FQCE_IdentifierIndex::FOccurrence>& OutOccurrences) const;
+
+	/** Counts the highlighted word in the whole text, on a worker thread unless the index has the count */
+	void UpdateHighlightedWordCount();
+
+	/** Drops the running word count, if any. Its result will never be used. */
+	void CancelWordCount();
+
+	/** Returns true if the identifier index describes the current lines */
+	bool IsIdentifierIndexInSync() const;
+
+	/** Keeps the word highlight ticker running while there are highlights to add or a count to wait for */
+	void StartWordHighlightTicker();
+
+	/** Adds the next batch of highlights and picks up the word count. Returns false once there is nothing left to do. */
+	bool TickWordHighlights(float DeltaTime);
+
+	/** Returns the lines word highlights are created for: the visible ones plus a margin, or all of them if the view is unknown */
+	void GetWordHighlightLineRange(int32& OutFirstLine, int32& OutLastLine) const;
+
+	/** Returns the highlighter shared by all word highlights, updated to the current highlight color */
+	TSharedRef<FQCE_WordBackgroundHighlighter> GetWordHighlighter();
+
+	/** Highlights the search matches on the lines around the visible range */
+	void ApplySearchHighlights();
+
+	/** Removes the highlights of the search matches, the matches themselves are kept */
+	void RemoveSearchHighlights();
+
+	/** Returns the highlighter shared by all search match highlights, updated to the current highlight color */
+	TSharedRef<FQCE_WordBackgroundHighlighter> GetSearchHighlighter();
+
 	/** Store active word highlights */
 	TArray<FTextLineHighlight> WordHighlights;
+
+	TSharedPtr<FQCE_WordBackgroundHighlighter> WordHighlighter;
+
+	TSharedPtr<const FQCE_IdentifierIndex> IdentifierIndex;
+
+	/** Word currently highlighted with HighlightWord, and the lines it was highlighted on */
+	FString HighlightedWord;
+	int32 HighlightedFirstLine = 0;
+	int32 HighlightedLastLine = INDEX_NONE;
+
+	/** Lines currently on screen (0-based, inclusive), unknown while VisibleLastLine < VisibleFirstLine */
+	int32 VisibleFirstLine = 0;
+	int32 VisibleLastLine = INDEX_NONE;
+
+	/** Occurrences of the highlighted word that do not have a highlight yet, visible ones first */
+	TArray<FQCE_IdentifierIndex::FOccurrence> PendingWordOccurrences;
+	int32 NextPendingWordOccurrence = 0;
+
+	FTSTicker::FDelegateHandle WordHighlightTickerHandle;
+
+	/** Occurrences of the highlighted word in the whole text, INDEX_NONE while they are being counted */
+	int32 HighlightedWordCount = 0;
+
+	/** Matches of the find query sorted by line, and the highlights of the ones around the visible range */
+	TArray<FQCE_IdentifierIndex::FOccurrence> SearchMatches;
+	TArray<FTextLineHighlight> SearchHighlights;
+	TSharedPtr<FQCE_WordBackgroundHighlighter> SearchHighlighter;
+
+	/** Lines the search matches were highlighted on */
+	int32 SearchHighlightedFirstLine = 0;
+	int32 SearchHighlightedLastLine = INDEX_NONE;
+
+	/** Word count running on a worker thread */
+	struct FWordCount;
+	TSharedPtr<FWordCount, ESPMode::ThreadSafe> WordCount;
 };
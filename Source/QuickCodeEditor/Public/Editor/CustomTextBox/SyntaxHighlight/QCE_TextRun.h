@@ -1,45 +1,106 @@
 // Copyright TechnicallyArtist 2025 All Rights Reserved.
 
 #pragma once
-#include "Framework/Text/SlateTextRun.h"
+#include "Framework/Text/ISlateRun.h"
+#include "Editor/CustomTextBox/SyntaxHighlight/QCE_SyntaxStyleTable.h"
 #include "Settings/UQCE_EditorSettings.h"
 
 /**
- * Custom text run class that extends FSlateTextRun to provide custom tab character rendering.
- * 
+ * Text run of the QuickCodeEditor's syntax highlighting, with custom tab character rendering.
+ *
  * This class is used by the QuickCodeEditor's syntax highlighting system to handle text measurement
  * and rendering for individual text runs within a syntax-highlighted text block. It specifically
  * addresses tab character handling and provides custom measurement logic for accurate text layout.
+ *
+ * Implements ISlateRun directly rather than deriving from FSlateTextRun, which keeps its own copy of a FTextBlockStyle.
+ * A run only holds the shared syntax style table and the token kind of its style, so a document's runs share
+ * one copy of each style.
  */
-class FQCE_TextRun : public FSlateTextRun
+class FQCE_TextRun : public ISlateRun, public TSharedFromThis<FQCE_TextRun>
 {
 public:
-    /** Factory method to create a new FQCE_TextRun instance. */
-    static TSharedRef<FQCE_TextRun> Create(const FRunInfo& InRunInfo, const TSharedRef<const FString>& InText, const FTextBlockStyle& InStyle, const FTextRange& InRange)
+    /**
+     * Factory method to create a new FQCE_TextRun instance.
+     * The run takes its style from the shared syntax style table entry of the given token kind.
+     */
+    static TSharedRef<FQCE_TextRun> Create(const FRunInfo& InRunInfo, const TSharedRef<const FString>& InText, const TSharedRef<const FQCE_SyntaxStyleTable>& InStyleTable, ECppTokenKind InTokenKind, const FTextRange& InRange)
     {
-        return MakeShareable(new FQCE_TextRun(InRunInfo, InText, InStyle, InRange));
+        return MakeShareable(new FQCE_TextRun(InRunInfo, InText, InStyleTable, InTokenKind, InRange));
     }
 
+    virtual ~FQCE_TextRun() {}
+
+    //~ Begin IRun interface
+    virtual FTextRange GetTextRange() const override { return Range; }
+    virtual void SetTextRange(const FTextRange& Value) override { Range = Value; }
+
+    virtual int16 GetBaseLine(float Scale) const override;
+    virtual int16 GetMaxHeight(float Scale) const override;
+
     /**
      * Measures the size of a portion of this text run.
-     * 
+     *
      * This override provides custom measurement logic, particularly for handling tab characters
      * and ensuring proper spacing in the code editor's text layout.
      */
     virtual FVector2D Measure(int32 StartIndex, int32 EndIndex, float Scale, const FRunTextContext& TextContext) const override;
 
+    virtual int8 GetKerning(int32 CurrentIndex, float Scale, const FRunTextContext& TextContext) const override;
+
+    virtual TSharedRef<ILayoutBlock> CreateBlock(int32 StartIndex, int32 EndIndex, FVector2D Size, const FLayoutBlockTextContext& TextContext, const TSharedPtr<IRunRenderer>& Renderer) override;
+
+    virtual int32 GetTextIndexAt(const TSharedRef<ILayoutBlock>& Block, const FVector2D& Location, float Scale, ETextHitPoint* const OutHitPoint = nullptr) const override;
+    virtual FVector2D GetLocationAt(const TSharedRef<ILayoutBlock>& Block, int32 Offset, float Scale) const override;
+
+    /** Picks up the current syntax style table if it was replaced since this run was created or last laid out. */
+    virtual void BeginLayout() override;
+    virtual void EndLayout() override {}
+
+    virtual void Move(const TSharedRef<FString>& NewText, const FTextRange& NewRange) override;
+    virtual TSharedRef<IRun> Clone() const override;
+
+    virtual void AppendTextTo(FString& AppendToText) const override;
+    virtual void AppendTextTo(FString& AppendToText, const FTextRange& PartialRange) const override;
+
+    virtual const FRunInfo& GetRunInfo() const override { return RunInfo; }
+    virtual ERunAttributes GetRunAttributes() const override { return ERunAttributes::SupportsText; }
+    //~ End IRun interface
+
+    //~ Begin ISlateRun interface
+    virtual int32 OnPaint(const FPaintArgs& PaintArgs, const FTextArgs& TextArgs, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    virtual const TArray<TSharedRef<SWidget>>& GetChildren() override;
+    virtual void ArrangeChildren(const TSharedRef<ILayoutBlock>& Block, const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const override {}
+    //~ End ISlateRun interface
+
 protected:
     /**
      * Protected constructor for FQCE_TextRun.
      * Use the static Create method to instantiate this class.
      */
-    FQCE_TextRun(const FRunInfo& InRunInfo, const TSharedRef<const FString>& InText, const FTextBlockStyle& InStyle, const FTextRange& InRange)
-        : FSlateTextRun(InRunInfo, InText, InStyle, InRange)
-        , TextBlockStyle(InStyle)
+    FQCE_TextRun(const FRunInfo& InRunInfo, const TSharedRef<const FString>& InText, const TSharedRef<const FQCE_SyntaxStyleTable>& InStyleTable, ECppTokenKind InTokenKind, const FTextRange& InRange)
+        : RunInfo(InRunInfo)
+        , Text(InText)
+        , Range(InRange)
+        , StyleTable(InStyleTable)
+        , TokenKind(InTokenKind)
     {
     }
 
 private:
-    /** Reference to the text block style used for measuring and rendering this text run */
-    const FTextBlockStyle& TextBlockStyle;
-}; 
\ No newline at end of file
+    /** The style of this run, owned by the style table */
+    const FTextBlockStyle& GetStyle() const { return StyleTable->GetStyle(TokenKind); }
+
+    FRunInfo RunInfo;
+
+    /** Text of the whole line, shared by every run of the line */
+    TSharedRef<const FString> Text;
+
+    /** Part of Text covered by this run */
+    FTextRange Range;
+
+    /** Style table this run's style is taken from */
+    TSharedRef<const FQCE_SyntaxStyleTable> StyleTable;
+
+    /** Entry of the style table used for this run */
+    ECppTokenKind TokenKind;
+};
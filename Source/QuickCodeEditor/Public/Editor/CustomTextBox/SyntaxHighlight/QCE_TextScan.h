@@ -0,0 +1,44 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Scanning kernels used by the C++ tokenizer to find where string, comment, identifier and number runs end.
+ * Every function scans the absolute range [Start, End) of Text.
+ *
+ * With 2-byte TCHAR on x86 they test 8 code units per step with SSE2, or 16 with AVX2 when the build targets it.
+ * Other platforms use the scalar loops, which give the same results.
+ */
+class QUICKCODEEDITOR_API FQCE_TextScan
+{
+public:
+	/**
+	 * Finds the end of a string or character literal whose opening quote is right before Start.
+	 * Backslashes escape the character that follows them.
+	 * @return Index just past the closing quote, or End if the literal is not closed on this range
+	 */
+	static int32 FindQuotedEnd(const TCHAR* Text, int32 Start, int32 End, TCHAR Quote);
+
+	/**
+	 * Finds the closing delimiter of a block comment.
+	 * @return Index just past the closing delimiter, or INDEX_NONE if the comment goes on past End
+	 */
+	static int32 FindBlockCommentEnd(const TCHAR* Text, int32 Start, int32 End);
+
+	/** @return Index of the first character that is not a letter, a digit or an underscore, or End */
+	static int32 SkipIdentifierChars(const TCHAR* Text, int32 Start, int32 End);
+
+	/** @return Index of the first character that is not an ASCII letter, or End */
+	static int32 SkipAlphaChars(const TCHAR* Text, int32 Start, int32 End);
+
+	/** @return Index of the first character that cannot continue a numeric literal (digits, '.', '+', '-' and the f/u/l/x/e suffix letters), or End */
+	static int32 SkipNumberChars(const TCHAR* Text, int32 Start, int32 End);
+
+	/** Returns true if the vector kernels are compiled in and enabled */
+	static bool IsVectorized();
+
+	/** Makes every kernel take its scalar path, so both paths can be compared on the same input */
+	static void SetForceScalar(bool bInForceScalar);
+};
@@ -6,6 +6,9 @@
 #include "QCE_IOTypes.h"
 #include "UObject/Class.h"
 
+class FQCE_SourceFile;
+struct FQCE_FunctionSymbol;
+
 
 /**
  * Handles reading and parsing of C++ function declarations and implementations.
@@ -32,20 +35,23 @@ private:
 	/** Locates function declaration position within file content. */
 	bool FindDeclarationPositionInFile(const FString& FileContent, const UFunction* Function, int32& OutFunctionPosition);
 
-	/** Finds function implementation using parsed declaration info. */
-	bool ParseImplementation(const UFunction* Function, FFunctionImplementationInfo& OutImplementationInfo, FString& OutCppPath);
+	/** Finds function implementation in the source file content using parsed declaration info. */
+	bool ParseImplementation(const UFunction* Function, const FString& FileContent, FFunctionImplementationInfo& OutImplementationInfo);
+
+	/** Looks for the implementation in the other files FQCE_ProjectSymbolIndex knows a definition of the function in. */
+	bool ParseImplementationFromProjectIndex(const UFunction* Function, const FString& SkippedPath, FFunctionImplementationInfo& OutImplementationInfo);
 
 	/** Parses declaration into structured info. */
 	bool ParseDeclaration(const UFunction* Function, const FString& FileContent, FFunctionDeclarationInfo& OutDeclarationInfo);
 
-	/** Reads C++ file content for given function. */
-	bool ReadCppFileContent(const UFunction* Function, FString& FileContent, FString& OutFilePath, QCE_CppFileType FileType);
+	/** Gets the C++ file of given function, from FQCE_SourceFileCache unless it changed on disk. */
+	TSharedPtr<const FQCE_SourceFile> ReadCppFile(const UFunction* Function, QCE_CppFileType FileType);
 
 	/** Filters positions to those matching UFunction parameters. */
 	bool FilterPositionsByParamNum(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const UFunction* Function, TArray<int32>& OutParameterMatches);
 
-	/** Filters positions to those matching UFunction parameter types. */
-	bool FilterPositionsByMatchingNodeParams(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const UFunction* Function, TArray<int32>& OutTypeMatches);
+	/** Filters function symbols to those whose recorded parameter types match the UFunction's. */
+	bool FilterSymbolsByMatchingNodeParams(const TArray<const FQCE_FunctionSymbol*>& Symbols, const UFunction* Function, TArray<const FQCE_FunctionSymbol*>& OutTypeMatches);
 
 	/** Instance-specific loaded declaration info for caching */
 	FFunctionDeclarationInfo LoadedDeclarationInfo;
@@ -47,6 +47,9 @@ namespace EQCEExportedDeclaration
 	};
 }
 
+class FQCE_LexicalMask;
+struct FQCE_FunctionSymbol;
+
 class QCE_CommonIOHelpers
 {
 public:
@@ -69,31 +72,21 @@ public:
 	static bool FilterCommentedPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, TArray<int32>& OutNonCommentMatches);
 
 	/**
-	 * Filters positions to only include those that have UFUNCTION macros
-	 * @param FileContent The content to check
-	 * @param PossibleMatchPositions Input positions to filter
-	 * @param OutUFunctionMatches Output positions that have UFUNCTION macros
-	 * @return True if any UFUNCTION positions were found
-	 */
-	static bool FilterNativeFunctionPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, TArray<int32>& OutUFunctionMatches);
-
-	/**
-	 * Filters positions to only include those that have class scope (ClassName::FunctionName)
+	 * Checks if a position in the file content is within a comment, see FQCE_LexicalMask
+	 * Gets the mask of the whole content first, so this is for one-off queries
 	 * @param FileContent The content to check
-	 * @param PossibleMatchPositions Input positions to filter
-	 * @param ClassName The class name to look for in scope
-	 * @param OutScopedMatches Output positions that have correct scope
-	 * @return True if any scoped positions were found
+	 * @param Position The position to check
+	 * @return True if the position is within a comment
 	 */
-	static bool FilterScopedFunctionPositions(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const FString& ClassName, TArray<int32>& OutScopedMatches);
+	static bool IsPositionInComment(const FString& FileContent, int32 Position);
 
 	/**
-	 * Checks if a position in the file content is within a comment
-	 * @param FileContent The content to check
+	 * Checks if a position is within a comment, for callers that check many positions against one mask
+	 * @param Mask The mask of the content to check
 	 * @param Position The position to check
 	 * @return True if the position is within a comment
 	 */
-	static bool IsPositionInComment(const FString& FileContent, int32 Position);
+	static bool IsPositionInComment(const FQCE_LexicalMask& Mask, int32 Position);
 
 	/**
 	 * Checks if a function has a UFUNCTION macro above it with boundary detection
@@ -116,7 +109,7 @@ public:
 	static bool ValidateFunctionFlags(const UFunction* Function);
 
 	/**
-	 * Reads file content from a file path
+	 * Reads file content from a file path, through FQCE_SourceFileCache
 	 * @param FilePath Path to the file to read
 	 * @param OutContent Output content of the file
 	 * @return True if file was read successfully
@@ -147,6 +140,9 @@ public:
 	 */
 	static bool DoesParameterSignatureMatch(const FString& FileContent, int32 Position, const UFunction* Function);
 
+	/** DoesParameterSignatureMatch with Mask being the FQCE_LexicalMask of FileContent */
+	static bool DoesParameterSignatureMatch(const FString& FileContent, const FQCE_LexicalMask& Mask, int32 Position, const UFunction* Function);
+
 	/**
 	 * Filters positions to only include those that match the function's parameter signature
 	 * @param FileContent The content to check
@@ -178,7 +174,8 @@ public:
 	static FString ExtractClassNameFromDeclarationFile(const FString& DeclarationFileContent);
 
 	/**
-	 * Finds implementation position in file using declaration info
+	 * Finds implementation position in file using declaration info.
+	 * Candidates are the definitions of the function in the file's FQCE_SymbolTable, narrowed down by class scope and signature.
 	 * @param FileContent The content to search in
 	 * @param DeclarationInfo Declaration info containing function details
 	 * @param ClassName The class name to look for in scope
@@ -196,22 +193,20 @@ public:
 
 	/**
 	 * Validates that implementation signature matches declaration
-	 * @param FileContent The content to check
-	 * @param FunctionNamePos Position of the function name
+	 * @param Symbol The implementation, whose parameters and constness the symbol table already recorded
 	 * @param DeclarationInfo Declaration info to compare against
 	 * @return True if implementation signature matches declaration
 	 */
-	static bool DoesImplementationSignatureMatchDeclaration(const FString& FileContent, int32 FunctionNamePos, const FFunctionDeclarationInfo& DeclarationInfo);
+	static bool DoesImplementationSignatureMatchDeclaration(const FQCE_FunctionSymbol& Symbol, const FFunctionDeclarationInfo& DeclarationInfo);
 
 	/**
-	 * Filters positions to those matching declaration signature
-	 * @param FileContent The content to check
-	 * @param PossibleMatchPositions Input positions to filter
+	 * Filters function symbols to those matching declaration signature
+	 * @param Symbols Input symbols to filter
 	 * @param DeclarationInfo Declaration info to match against
-	 * @param OutSignatureMatches Output positions that match the signature
+	 * @param OutSignatureMatches Output symbols that match the signature
 	 * @return True if any signature matches were found
 	 */
-	static bool FilterPositionsBySignatureMatch(const FString& FileContent, const TArray<int32>& PossibleMatchPositions, const FFunctionDeclarationInfo& DeclarationInfo, TArray<int32>& OutSignatureMatches);
+	static bool FilterSymbolsBySignatureMatch(const TArray<const FQCE_FunctionSymbol*>& Symbols, const FFunctionDeclarationInfo& DeclarationInfo, TArray<const FQCE_FunctionSymbol*>& OutSignatureMatches);
 
 	/**
 	 * Extracts the return type of a function from header content at the given cursor location
@@ -237,7 +232,8 @@ public:
 	static bool IsWordCharacter(TCHAR Char);
 
 	/**
-	 * Converts FTextLocation to linear position in file content
+	 * Converts FTextLocation to linear position in file content.
+	 * Walks the content, for the text of an editor use SQCE_MultiLineEditableTextBox::LocationToPosition instead.
 	 * @param FileContent The content to search in
 	 * @param TextLocation The text location to convert
 	 * @return The linear position in the file content, or INDEX_NONE if invalid
@@ -245,7 +241,8 @@ public:
 	static int32 ConvertTextLocationToPosition(const FString& FileContent, const FTextLocation& TextLocation);
 
 	/**
-	 * Converts linear position to FTextLocation in file content
+	 * Converts linear position to FTextLocation in file content.
+	 * Walks the content, for the text of an editor use SQCE_MultiLineEditableTextBox::PositionToLocation instead.
 	 * @param FileContent The content to search in
 	 * @param Position The linear position to convert
 	 * @return The FTextLocation representing the position
@@ -0,0 +1,56 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What a character of C++ source is part of */
+enum class EQCE_LexicalKind : uint8
+{
+    Code,
+    /** A line or block comment, including its delimiters */
+    Comment,
+    /** A string literal, including its quotes */
+    String,
+    /** A character literal, including its quotes */
+    Char,
+};
+
+/**
+ * Classification of every character of a C++ source text as code, comment, string or character literal.
+ * Built in a single pass over the text, so asking about any position afterwards costs an array lookup
+ * instead of lexing the text up to that position again.
+ *
+ * Must be used from the game thread.
+ */
+class QUICKCODEEDITOR_API FQCE_LexicalMask
+{
+public:
+    explicit FQCE_LexicalMask(FStringView Content);
+
+    /**
+     * Returns the mask of Content, building it if it is not cached.
+     * The cache compares the whole text, so a text that changed gets a new mask.
+     */
+    static TSharedRef<const FQCE_LexicalMask> Get(const FString& Content);
+
+    /** Drops every cached mask along with its text */
+    static void Empty();
+
+    /** Returns the kind of the character at Position, Code outside the text */
+    EQCE_LexicalKind GetKind(int32 Position) const
+    {
+        return Kinds.IsValidIndex(Position) ? Kinds[Position] : EQCE_LexicalKind::Code;
+    }
+
+    bool IsCode(int32 Position) const { return GetKind(Position) == EQCE_LexicalKind::Code; }
+
+    bool IsComment(int32 Position) const { return GetKind(Position) == EQCE_LexicalKind::Comment; }
+
+    bool IsStringOrComment(int32 Position) const { return !IsCode(Position); }
+
+    int32 Len() const { return Kinds.Num(); }
+
+private:
+    TArray<EQCE_LexicalKind> Kinds;
+};
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 
+class FQCE_LexicalMask;
+
 /**
  * Utility class for matching and comparing C++ function parameters.
  */
@@ -88,10 +90,14 @@ public:
      */
     static bool GetParameterStringAtPosition(const FString& FileContent, int32 MatchPos, FString& ParameterString);
 
+    /** GetParameterStringAtPosition with the FQCE_LexicalMask of FileContent already at hand, for callers that extract at many positions */
+    static bool GetParameterStringAtPosition(const FString& FileContent, const FQCE_LexicalMask& Mask, int32 MatchPos, FString& ParameterString);
+
     /** 
      * Finds matching brackets while respecting C++ syntax.
      * Handles nested brackets, string literals, character literals, and comments.
      * Used for both parameter extraction and general code parsing.
+     * Strings and comments come from the FQCE_LexicalMask of Content, so Content should be the whole file.
      * 
      * Example:
      * @code
@@ -102,6 +108,9 @@ public:
      */
     static bool FindMatchingBracket(const FString& Content, int32 OpenBracketPos, TCHAR OpenBracket, TCHAR CloseBracket, int32& OutCloseBracketPos, bool bIncludeSingleQuotes = false);
 
+    /** FindMatchingBracket with Mask being the FQCE_LexicalMask of Content */
+    static bool FindMatchingBracket(const FString& Content, const FQCE_LexicalMask& Mask, int32 OpenBracketPos, TCHAR OpenBracket, TCHAR CloseBracket, int32& OutCloseBracketPos, bool bIncludeSingleQuotes = false);
+
     /** 
      * Normalizes a parameter declaration for comparison.
      * Standardizes whitespace, removes parameter names and optionally default values
@@ -129,9 +138,15 @@ public:
      */
     static bool FindCharacterRespectingContext(const FString& Content, const FString& SearchChar, int32 StartPos, ESearchDir::Type Direction, int32& OutPosition);
 
+    /** FindCharacterRespectingContext with Mask being the FQCE_LexicalMask of Content */
+    static bool FindCharacterRespectingContext(const FString& Content, const FQCE_LexicalMask& Mask, const FString& SearchChar, int32 StartPos, ESearchDir::Type Direction, int32& OutPosition);
+
     /** 
      * Determines if a position in code is within a string literal or comment.
      * Handles both single-line and multi-line comments, and string/character literals.
+     * The quotes and comment delimiters count as part of the literal or comment.
+     * Gets the FQCE_LexicalMask of Content, which compares the whole text against the cache,
+     * so this is for one-off queries. Callers that check many positions should get the mask once and use the overload below.
      * 
      * Example:
      * @code
@@ -141,6 +156,9 @@ public:
      * @endcode
      */
     static bool IsPositionInStringOrComment(const FString& Content, int32 Position);
+
+    /** Determines if a position is within a string literal or comment of the text Mask was built from */
+    static bool IsPositionInStringOrComment(const FQCE_LexicalMask& Mask, int32 Position);
 #pragma endregion
 private:
     /** 
@@ -0,0 +1,133 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+
+struct FFileChangeData;
+
+/** A function definition found by the project symbol index */
+struct FQCE_IndexedFunction
+{
+    FString Name;
+
+    /** See FQCE_FunctionSymbol::ScopeName */
+    FString ScopeName;
+
+    friend FArchive& operator<<(FArchive& Ar, FQCE_IndexedFunction& Function)
+    {
+        return Ar << Function.Name << Function.ScopeName;
+    }
+};
+
+/** The function definitions of a source file, along with the size and time of the file they were read from */
+struct FQCE_IndexedFile
+{
+    /** Normalized full path, as FQCE_SourceFile::GetPath */
+    FString Path;
+
+    /** INDEX_NONE once the file is gone */
+    int64 FileSize = INDEX_NONE;
+
+    FDateTime ModificationTime;
+
+    TArray<FQCE_IndexedFunction> Functions;
+
+    friend FArchive& operator<<(FArchive& Ar, FQCE_IndexedFile& File)
+    {
+        return Ar << File.Path << File.FileSize << File.ModificationTime << File.Functions;
+    }
+};
+
+/**
+ * Index of the function definitions in the sources of the project's modules and plugins,
+ * so a function implemented in another .cpp than the one FSourceCodeNavigation::FindClassSourcePath returns can still be found.
+ *
+ * Files are scanned on worker threads. The index is saved to Saved/QuickCodeEditor and loaded again on the next start,
+ * after which only the files whose size or modification time changed are scanned. While the editor runs,
+ * the source directories are watched and files are scanned again as they are saved.
+ *
+ * Lookups only name the files that define a function, callers still find the definition in the file itself,
+ * so an entry that is out of date costs a wasted lookup at worst.
+ *
+ * Must be used from the game thread.
+ */
+class QUICKCODEEDITOR_API FQCE_ProjectSymbolIndex
+{
+public:
+    ~FQCE_ProjectSymbolIndex();
+
+    /** Loads the saved index, starts scanning the files that changed since and watching the source directories */
+    void Initialize();
+
+    /** Stops watching and scanning, and saves the index if it changed */
+    void Shutdown();
+
+    /** Whether files are being scanned, their definitions are missing from lookups until they are done */
+    bool IsScanning() const { return ScanJob.IsValid(); }
+
+    /**
+     * Adds the files with a definition of FunctionName scoped to ClassName to OutPaths.
+     * ClassName may come without its prefix, it matches the end of the scope as in QCE_CommonIOHelpers::FindImplementationPositionInContent.
+     */
+    void FindDefinitionFiles(const FString& FunctionName, const FString& ClassName, TArray<FString>& OutPaths) const;
+
+    /** Saved/QuickCodeEditor/SymbolIndex.bin */
+    static FString GetIndexFilePath();
+
+private:
+    struct FScanJob;
+
+    /**
+     * Scans Paths on worker threads. Files in Directories are scanned too if they are not indexed
+     * or changed since, and indexed files that are no longer there are removed.
+     */
+    void StartScan(TArray<FString> Directories, TArray<FString> Paths);
+
+    /** Runs on a worker thread */
+    static void RunScan(FScanJob& Job);
+
+    /** Reads a file and keeps its function definitions. Runs on a worker thread. */
+    static void ScanFile(const FString& Path, FQCE_IndexedFile& OutFile);
+
+    /** Picks up the result of the scan once it is finished, then starts scanning the files that changed meanwhile */
+    bool TickScan(float DeltaTime);
+
+    void AddFile(FQCE_IndexedFile&& File);
+
+    void RemoveFile(const FString& Path);
+
+    void OnDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+    bool LoadIndex();
+
+    void SaveIndex();
+
+    /** By normalized full path */
+    TMap<FString, FQCE_IndexedFile> Files;
+
+    /** Paths of the files defining a function, by function name. FString keys hash case-insensitively, lookups compare the names again. */
+    TMap<FString, TArray<FString>> FilesByFunctionName;
+
+    /** Source directories of the project and its plugins */
+    TArray<FString> SourceDirectories;
+
+    /** Directory watcher callbacks, by directory */
+    TMap<FString, FDelegateHandle> WatcherHandles;
+
+    /** Files reported changed while a scan was running */
+    TSet<FString> PendingPaths;
+
+    TSharedPtr<FScanJob, ESPMode::ThreadSafe> ScanJob;
+
+    TFuture<void> ScanFuture;
+
+    FTSTicker::FDelegateHandle ScanTickerHandle;
+
+    /** Whether the index changed since it was loaded or saved */
+    bool bIsDirty = false;
+
+    bool bIsInitialized = false;
+};
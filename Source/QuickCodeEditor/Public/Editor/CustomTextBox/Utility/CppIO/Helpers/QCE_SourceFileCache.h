@@ -0,0 +1,58 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A source file as it was on disk when it was loaded.
+ * Never changes once loaded, a file that changed on disk is loaded again into a new FQCE_SourceFile.
+ * Lexical masks of the content are cached by FQCE_LexicalMask itself.
+ */
+class QUICKCODEEDITOR_API FQCE_SourceFile
+{
+public:
+    FQCE_SourceFile(FString InPath, FString InContent, int64 InFileSize, const FDateTime& InModificationTime);
+
+    const FString& GetPath() const { return Path; }
+
+    const FString& GetContent() const { return Content; }
+
+    /** FCrc::StrCrc32 of the content, as stored in the ContentChecksum of the declaration and implementation infos */
+    uint32 GetChecksum() const { return Checksum; }
+
+    int64 GetFileSize() const { return FileSize; }
+
+    const FDateTime& GetModificationTime() const { return ModificationTime; }
+
+private:
+    FString Path;
+
+    FString Content;
+
+    uint32 Checksum;
+
+    int64 FileSize;
+
+    FDateTime ModificationTime;
+};
+
+/**
+ * Keeps the most recently read source files in memory, so looking up functions of the same class again
+ * does not read and checksum its header and source files again.
+ * A cached file is only used while the size and modification time on disk still match the ones it was loaded with.
+ *
+ * Must be used from the game thread.
+ */
+class QUICKCODEEDITOR_API FQCE_SourceFileCache
+{
+public:
+    /** Returns the file, reading it if it is not cached or changed on disk. Null if the file cannot be read. */
+    static TSharedPtr<const FQCE_SourceFile> Get(const FString& FilePath);
+
+    /** Drops the cached file, for files the plugin writes itself. A rewrite within the timestamp resolution would keep the same modification time. */
+    static void Invalidate(const FString& FilePath);
+
+    /** Drops every cached file */
+    static void Empty();
+};
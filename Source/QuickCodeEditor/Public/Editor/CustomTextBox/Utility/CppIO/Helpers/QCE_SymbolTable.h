@@ -0,0 +1,91 @@
+﻿// Copyright TechnicallyArtist 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A named class, struct or union with a body */
+struct FQCE_ClassSymbol
+{
+    FString Name;
+
+    /** Start of the statement declaring the class, including its UCLASS or template header */
+    int32 Start = INDEX_NONE;
+
+    /** One past the closing brace, INDEX_NONE if the body is not closed */
+    int32 End = INDEX_NONE;
+};
+
+/** A function declaration or definition outside of any function body */
+struct FQCE_FunctionSymbol
+{
+    /** The name, with a leading ~ for destructors */
+    FString Name;
+
+    /** The class before the :: of a qualified name, otherwise the class the function is declared in. Empty at namespace scope. */
+    FString ScopeName;
+
+    /** Position of the name, where the position based helpers of QCE_CommonIOHelpers expect the function */
+    int32 NamePosition = INDEX_NONE;
+
+    /** Start of the statement, including the UFUNCTION macro and template header */
+    int32 Start = INDEX_NONE;
+
+    /** One past the semicolon of a declaration or the closing brace of a definition */
+    int32 End = INDEX_NONE;
+
+    /** Range of the UFUNCTION(...) macro in front of the function, INDEX_NONE if there is none */
+    int32 UFunctionStart = INDEX_NONE;
+    int32 UFunctionEnd = INDEX_NONE;
+
+    /**
+     * Parameters normalized with QCE_ParameterMatcher::NormalizeParameter, without comments or default values.
+     * QCE_ParameterMatcher::DoParameterTypesMatch compares them as they are, normalizing them again changes nothing.
+     */
+    TArray<FString> Parameters;
+
+    /** Whether the function has a body */
+    bool bIsDefinition = false;
+
+    bool bIsConst = false;
+
+    bool HasUFunction() const { return UFunctionStart != INDEX_NONE; }
+};
+
+/**
+ * The classes and functions of a C++ header or source file, found in a single scan.
+ * Function bodies are skipped whole, so calls are never mistaken for declarations.
+ * Looking a function up by name is a hash lookup instead of a search through the text.
+ *
+ * Get must be used from the game thread, a table can be constructed on any thread.
+ */
+class QUICKCODEEDITOR_API FQCE_SymbolTable
+{
+public:
+    explicit FQCE_SymbolTable(const FString& Content);
+
+    /**
+     * Returns the symbol table of Content, scanning it if it is not cached.
+     * The cache compares the whole text, so a text that changed gets a new table.
+     */
+    static TSharedRef<const FQCE_SymbolTable> Get(const FString& Content);
+
+    /** Drops every cached table along with its text */
+    static void Empty();
+
+    const TArray<FQCE_ClassSymbol>& GetClasses() const { return Classes; }
+
+    /** Every function in file order */
+    const TArray<FQCE_FunctionSymbol>& GetFunctions() const { return Functions; }
+
+    /** Adds the functions called Name to OutFunctions, in file order. The pointers live as long as the table. */
+    void FindFunctions(const FString& Name, TArray<const FQCE_FunctionSymbol*>& OutFunctions) const;
+
+private:
+    TArray<FQCE_ClassSymbol> Classes;
+
+    TArray<FQCE_FunctionSymbol> Functions;
+
+    /** Indices into Functions. FString keys hash case-insensitively, lookups compare the names again. */
+    TMultiMap<FString, int32> FunctionsByName;
+};
@@ -31,6 +31,9 @@ public:
 	// Handle smart backspace for indentation
 	static bool HandleSmartBackspace(SQCE_MultiLineEditableTextBox* TextBox);
 
+	// Number of characters smart backspace deletes before the cursor, 0 when Backspace deletes one character the regular way
+	static int32 GetSmartBackspaceCount(FStringView LineBeforeCursor, int32 TabSpaceCount);
+
 private:
 	// Helper function to get single indent string based on settings (tab or N spaces)
 	static FString GetSingleIndentString();
@@ -8,6 +8,7 @@
 #include "WorkflowOrientedApp/WorkflowTabManager.h"
 
 class FDropdownCodeCompletionEngine;
+class FQCE_ProjectSymbolIndex;
 class UMainEditorContainer;
 class FToolBarBuilder;
 class FBlueprintEditor;
@@ -92,6 +93,9 @@ private:
 	TSharedPtr<FUICommandList> CommandList;
 	
 	TUniquePtr<FDropdownCodeCompletionEngine> CompletionEngine;
+
+	/** Where the functions of the project's sources are defined, kept up to date in the background */
+	TUniquePtr<FQCE_ProjectSymbolIndex> ProjectSymbolIndex;
 	TSharedPtr<FTabManager> TabManager;
 
 public:
@@ -100,6 +104,8 @@ public:
 
 	FDropdownCodeCompletionEngine* GetCodeCompletionEngine() const { return CompletionEngine.Get(); };
 
+	FQCE_ProjectSymbolIndex* GetProjectSymbolIndex() const { return ProjectSymbolIndex.Get(); }
+
 #pragma region Settings Management Methods
 	/** 
 	 * Registers the plugin's settings with Unreal's settings system.
@@ -175,6 +175,52 @@ public:
 			ToolTip = "Choose whether to use tabs or spaces for indentation"))
 	EQCEIndentationType IndentationType = EQCEIndentationType::Tabs;
 
+	/** Performance Settings */
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Lazy Syntax Highlighting",
+			ToolTip = "On large files, only highlight the lines around the visible area right away and highlight the rest progressively over the following frames"))
+	bool bLazySyntaxHighlighting = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Lazy Highlighting Min Lines", ClampMin = "100", ClampMax = "100000", EditCondition = "bLazySyntaxHighlighting",
+			ToolTip = "Files with fewer lines than this are always highlighted in full"))
+	int32 LazyHighlightMinLines = 2000;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Lazy Highlighting Margin Lines", ClampMin = "0", ClampMax = "5000", EditCondition = "bLazySyntaxHighlighting",
+			ToolTip = "Number of lines above and below the visible area that are highlighted right away"))
+	int32 LazyHighlightMarginLines = 100;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Lazy Highlighting Frame Budget (ms)", ClampMin = "0.1", ClampMax = "16.0", EditCondition = "bLazySyntaxHighlighting",
+			ToolTip = "Time spent per frame highlighting the lines that are still plain"))
+	float LazyHighlightFrameBudgetMs = 2.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Background Tokenization",
+			ToolTip = "Tokenize large edits such as pastes or file loads on a worker thread so the editor stays responsive"))
+	bool bBackgroundTokenization = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Background Tokenization Min Lines", ClampMin = "50", ClampMax = "100000", EditCondition = "bBackgroundTokenization",
+			ToolTip = "Number of changed lines from which an edit is tokenized on a worker thread"))
+	int32 BackgroundTokenizationMinLines = 1000;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Word Highlight Delay (s)", ClampMin = "0.0", ClampMax = "1.0",
+			ToolTip = "Time the cursor has to rest on a word before its occurrences are highlighted, so holding an arrow key does not highlight every word it passes"))
+	float WordHighlightDelaySeconds = 0.15f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Max Word Highlights Per Frame", ClampMin = "16", ClampMax = "10000",
+			ToolTip = "Number of word occurrence highlights added per frame, the visible ones first"))
+	int32 MaxWordHighlightsPerFrame = 200;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Settings|Performance",
+		meta = (DisplayName = "Undo History Memory Limit (MB)", ClampMin = "1", ClampMax = "1024",
+			ToolTip = "Memory each code editor may use for its undo history, the oldest steps are dropped past it"))
+	int32 UndoHistoryMemoryLimitMB = 32;
+
 	/** Keyboard Shortcuts */
 	UPROPERTY(Config, EditAnywhere, Category = "Keyboard Shortcuts",
 		meta = (DisplayName = "Find/Search"))
@@ -200,6 +246,14 @@ public:
 		meta = (DisplayName = "Go to Line"))
 	FInputChord GoToLineKeybinding;
 
+	UPROPERTY(Config, EditAnywhere, Category = "Keyboard Shortcuts",
+		meta = (DisplayName = "Undo"))
+	FInputChord UndoKeybinding;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Keyboard Shortcuts",
+		meta = (DisplayName = "Redo"))
+	FInputChord RedoKeybinding;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Keyboard Shortcuts|AI",
 		meta = (DisplayName = "AI Inline Completion Keybinding"))
 	FInputChord AIInlineCompletionKeybinding;
@@ -282,6 +336,10 @@ public:
 		meta = (DisplayName = "Word Highlight"))
 	FLinearColor WordHighlightColor =FLinearColor(0.14f, 0.3f, 0.83f, 0.3f);; // Semi-transparent yellow
 
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Colors|Highlight",
+		meta = (DisplayName = "Search Match Highlight"))
+	FLinearColor SearchHighlightColor = FLinearColor(0.85f, 0.55f, 0.1f, 0.35f); // Semi-transparent orange
+
 	/** Tab Colors */
 	UPROPERTY(Config, EditAnywhere, Category = "Editor Colors|Tabs",
 		meta = (DisplayName = "Active Tab Background"))
@@ -48,7 +48,9 @@ public class QuickCodeEditor : ModuleRules
 				"Json",
 				"JsonUtilities",
 				"Settings", "EditorStyle",
-				"Projects"
+				"Projects",
+				"DirectoryWatcher",
+				"ApplicationCore"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);